@@ -0,0 +1,50 @@
+#include "archive.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "dominance.h"
+
+NonDominatedArchive::NonDominatedArchive(std::size_t n_var, std::size_t n_obj)
+    : n_var_(n_var), n_obj_(n_obj), decisions_(0, n_var), objectives_(0, n_obj) {}
+
+bool NonDominatedArchive::insert(Span<const double> x, Span<const double> f) {
+    if (x.size() != n_var_ || f.size() != n_obj_) {
+        throw std::invalid_argument("Archive candidate has the wrong number of variables or objectives");
+    }
+
+    for (std::size_t i = 0; i < size();) {
+        const auto member = objectives_.row(i);
+        const int relation = dominance_relation(member.data(), f.data(), n_obj_);
+        if (relation == 1 || std::equal(member.begin(), member.end(), f.begin())) {
+            return false;
+        }
+        if (relation == -1) {
+            remove(i);
+            continue;
+        }
+        ++i;
+    }
+
+    const std::size_t row = size();
+    if ((row + 1) * n_obj_ > objectives_.capacity()) {
+        const std::size_t rows = std::max<std::size_t>(16, 2 * row);
+        decisions_.reserve(rows * n_var_);
+        objectives_.reserve(rows * n_obj_);
+    }
+    decisions_.resize(row + 1, n_var_);
+    objectives_.resize(row + 1, n_obj_);
+    std::copy(x.begin(), x.end(), decisions_.row(row).begin());
+    std::copy(f.begin(), f.end(), objectives_.row(row).begin());
+    return true;
+}
+
+void NonDominatedArchive::remove(std::size_t i) {
+    const std::size_t last = size() - 1;
+    if (i != last) {
+        decisions_.copy_row_from(decisions_, last, i);
+        objectives_.copy_row_from(objectives_, last, i);
+    }
+    decisions_.resize(last, n_var_);
+    objectives_.resize(last, n_obj_);
+}
@@ -0,0 +1,31 @@
+#ifndef EDDIE_ARCHIVE_H
+#define EDDIE_ARCHIVE_H
+
+#include <cstddef>
+
+#include "population.h"
+
+// Unbounded archive of mutually non-dominated solutions. A candidate is rejected if any
+// member dominates it or has identical objectives; otherwise the members it dominates are
+// removed and the candidate is appended.
+class NonDominatedArchive {
+public:
+    NonDominatedArchive(std::size_t n_var, std::size_t n_obj);
+
+    bool insert(Span<const double> x, Span<const double> f);
+
+    std::size_t size() const { return decisions_.rows(); }
+    bool empty() const { return size() == 0; }
+    const PopulationMatrix &decisions() const { return decisions_; }
+    const ObjectiveMatrix &objectives() const { return objectives_; }
+
+private:
+    void remove(std::size_t i);
+
+    std::size_t n_var_;
+    std::size_t n_obj_;
+    PopulationMatrix decisions_;
+    ObjectiveMatrix objectives_;
+};
+
+#endif // EDDIE_ARCHIVE_H
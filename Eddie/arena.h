@@ -0,0 +1,137 @@
+#ifndef EDDIE_ARENA_H
+#define EDDIE_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator for scratch memory that lives for one generation. Allocations are carved out
+// of 64-byte aligned blocks by advancing an offset and are all released at once by `reset()`,
+// typically at the end of a generation; nothing is freed individually and no destructors run.
+//
+// When a generation outgrows the first block, further blocks are chained (each at least as
+// large as everything before it). `reset()` then replaces the chain by a single block of its
+// total size, so after the first generations every generation is served from one block and
+// neither malloc nor free are called any more.
+//
+// Header-only and free of other Eddie dependencies so the compiled pymoo modules can share it
+// (pymoo/functions/compiled/workspace.pyx).
+class Arena {
+public:
+    static constexpr std::size_t alignment = 64;
+    static constexpr std::size_t min_block_size = std::size_t{1} << 16;
+
+    // Position of the bump pointer; see `rewind`.
+    struct Marker {
+        std::size_t block = 0;
+        std::size_t offset = 0;
+    };
+
+    Arena() = default;
+    explicit Arena(std::size_t capacity) {
+        if (capacity > 0) {
+            add_block(capacity);
+        }
+    }
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+    Arena(Arena &&) noexcept = default;
+    Arena &operator=(Arena &&) noexcept = default;
+    ~Arena() = default;
+
+    // Uninitialized storage for n objects of T, valid until the next `reset` (or a `rewind` to
+    // a marker taken before this call).
+    template <typename T>
+    T *allocate(std::size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value, "Arena memory is released without destructors");
+        static_assert(alignof(T) <= alignment, "Arena blocks are only 64-byte aligned");
+        return static_cast<T *>(allocate_bytes(n * sizeof(T)));
+    }
+
+    // Storage for n objects of T, all set to `value`.
+    template <typename T>
+    T *allocate(std::size_t n, const T &value) {
+        T *data = allocate<T>(n);
+        std::fill(data, data + n, value);
+        return data;
+    }
+
+    // Nested scratch: everything allocated after `mark()` is released by `rewind(marker)`.
+    Marker mark() const { return Marker{current_, offset_}; }
+    void rewind(Marker marker) {
+        current_ = marker.block;
+        offset_ = marker.offset;
+    }
+
+    // Releases all allocations and merges the blocks into one of their total size.
+    void reset() {
+        if (blocks_.size() > 1) {
+            const std::size_t total = capacity();
+            blocks_.clear();
+            add_block(total);
+        }
+        current_ = 0;
+        offset_ = 0;
+    }
+
+    // Bytes handed out since the last reset, including the unused tails of filled blocks.
+    std::size_t bytes_used() const {
+        std::size_t used = offset_;
+        for (std::size_t b = 0; b < current_ && b < blocks_.size(); ++b) {
+            used += blocks_[b].size;
+        }
+        return used;
+    }
+
+    std::size_t capacity() const {
+        std::size_t total = 0;
+        for (const auto &block : blocks_) {
+            total += block.size;
+        }
+        return total;
+    }
+
+    std::size_t n_blocks() const { return blocks_.size(); }
+
+private:
+    struct AlignedDeleter {
+        void operator()(unsigned char *ptr) const { ::operator delete(ptr, std::align_val_t(alignment)); }
+    };
+
+    struct Block {
+        std::unique_ptr<unsigned char[], AlignedDeleter> data;
+        std::size_t size;
+    };
+
+    void add_block(std::size_t size) {
+        size = (size + alignment - 1) / alignment * alignment;
+        auto *data = static_cast<unsigned char *>(::operator new(size, std::align_val_t(alignment)));
+        blocks_.push_back(Block{std::unique_ptr<unsigned char[], AlignedDeleter>(data), size});
+    }
+
+    void *allocate_bytes(std::size_t bytes) {
+        // every allocation starts on a fresh 64-byte boundary
+        bytes = (std::max<std::size_t>(bytes, 1) + alignment - 1) / alignment * alignment;
+        for (; current_ < blocks_.size(); ++current_, offset_ = 0) {
+            if (blocks_[current_].size - offset_ >= bytes) {
+                void *data = blocks_[current_].data.get() + offset_;
+                offset_ += bytes;
+                return data;
+            }
+        }
+        add_block(std::max({bytes, min_block_size, capacity()}));
+        current_ = blocks_.size() - 1;
+        offset_ = bytes;
+        return blocks_.back().data.get();
+    }
+
+    std::vector<Block> blocks_{};
+    std::size_t current_ = 0;  // block the next allocation is tried in
+    std::size_t offset_ = 0;   // first free byte of that block
+};
+
+#endif // EDDIE_ARENA_H
@@ -0,0 +1,529 @@
+// Micro-benchmarks for the Eddie kernels. Modeled after Google Benchmark: every case runs in
+// growing batches until it has used at least `--min_time` seconds, and the results are written
+// as Google-Benchmark-compatible JSON (`--out=`) so runs from different commits can be diffed
+// with the usual tooling (e.g. compare.py).
+//
+//   ./nsga_bench [--filter=substr] [--min_time=0.2] [--out=results.json]
+//                [--populations=100,1000,...] [--dims=2,10,...]
+//                [--max_elements=N] [--max_quadratic=N]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cpu_features.h"
+#include "crowding.h"
+#include "decomposition.h"
+#include "evaluator.h"
+#include "hypervolume.h"
+#include "initpop.h"
+#include "nsga2.h"
+#include "perpendicular_distance.h"
+#include "population.h"
+#include "problem.h"
+#include "ranking.h"
+#include "sorting.h"
+#include "surrogate.h"
+#include "survival.h"
+
+#ifndef EDDIE_GIT_REVISION
+#define EDDIE_GIT_REVISION ""
+#endif
+
+namespace {
+
+struct Options {
+    std::string filter{};
+    std::string out{};
+    double min_time = 0.2;
+    std::vector<std::size_t> populations{100, 1000, 10000, 100000};
+    std::vector<std::size_t> dims{2, 10, 100, 1000};
+    // skip cases whose decision matrix exceeds this many doubles
+    std::size_t max_elements = 20000000;
+    // largest population for kernels that are quadratic in the population size
+    std::size_t max_quadratic = 20000;
+};
+
+struct Result {
+    std::string name{};
+    std::size_t iterations = 0;
+    double real_ns = 0.0;
+    double cpu_ns = 0.0;
+    double items_per_second = 0.0;
+};
+
+template <typename T>
+void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+class Runner {
+public:
+    explicit Runner(const Options &options) : options_(options) {}
+
+    bool selected(const std::string &name) const {
+        return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+    }
+
+    // `body(n)` must run the measured operation n times; `items` is the work per operation.
+    void run(const std::string &name, double items, const std::function<void(std::size_t)> &body) {
+        if (!selected(name)) {
+            return;
+        }
+
+        std::size_t iterations = 1;
+        while (true) {
+            const std::clock_t cpu_start = std::clock();
+            const auto start = std::chrono::steady_clock::now();
+            body(iterations);
+            const double real = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            const double cpu = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+            if (real >= options_.min_time || iterations >= 1000000000U) {
+                Result result;
+                result.name = name;
+                result.iterations = iterations;
+                result.real_ns = real * 1e9 / static_cast<double>(iterations);
+                result.cpu_ns = cpu * 1e9 / static_cast<double>(iterations);
+                result.items_per_second = items * static_cast<double>(iterations) / real;
+                report(result);
+                return;
+            }
+
+            // same growth rule as Google Benchmark: aim 40% past min_time, at most 10x per round
+            const double multiplier = real > 0.0 ? std::min(10.0, options_.min_time * 1.4 / real) : 10.0;
+            iterations = std::max(iterations + 1, static_cast<std::size_t>(static_cast<double>(iterations) * multiplier));
+        }
+    }
+
+    const std::vector<Result> &results() const { return results_; }
+
+private:
+    void report(const Result &result) {
+        std::printf("%-48s %14.0f ns %14.0f ns %12zu %14.4g items/s\n", result.name.c_str(), result.real_ns,
+                    result.cpu_ns, result.iterations, result.items_per_second);
+        std::fflush(stdout);
+        results_.push_back(result);
+    }
+
+    const Options &options_;
+    std::vector<Result> results_{};
+};
+
+std::vector<std::size_t> parse_list(const std::string &text) {
+    std::vector<std::size_t> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            values.push_back(static_cast<std::size_t>(std::stoull(item)));
+        }
+    }
+    return values;
+}
+
+Options parse_options(int argc, char **argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto value_of = [&arg](const std::string &key) { return arg.substr(key.size()); };
+
+        if (arg.rfind("--filter=", 0) == 0) {
+            options.filter = value_of("--filter=");
+        } else if (arg.rfind("--out=", 0) == 0) {
+            options.out = value_of("--out=");
+        } else if (arg.rfind("--min_time=", 0) == 0) {
+            options.min_time = std::stod(value_of("--min_time="));
+        } else if (arg.rfind("--populations=", 0) == 0) {
+            options.populations = parse_list(value_of("--populations="));
+        } else if (arg.rfind("--dims=", 0) == 0) {
+            options.dims = parse_list(value_of("--dims="));
+        } else if (arg.rfind("--max_elements=", 0) == 0) {
+            options.max_elements = static_cast<std::size_t>(std::stoull(value_of("--max_elements=")));
+        } else if (arg.rfind("--max_quadratic=", 0) == 0) {
+            options.max_quadratic = static_cast<std::size_t>(std::stoull(value_of("--max_quadratic=")));
+        } else {
+            throw std::invalid_argument("Unknown argument: " + arg);
+        }
+    }
+    return options;
+}
+
+OptimizationParameters make_parameters(std::size_t population_size, std::size_t dimension) {
+    OptimizationParameters params{};
+    params.population_size = population_size;
+    params.offspring_population_size = population_size;
+    params.variable_lower_bounds.assign(dimension, 0.0);
+    params.variable_upper_bounds.assign(dimension, 1.0);
+    return params;
+}
+
+ObjectiveMatrix random_objectives(std::size_t n, std::size_t n_obj, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    ObjectiveMatrix objectives(n, n_obj);
+    for (std::size_t i = 0; i < objectives.size(); ++i) {
+        objectives.data()[i] = unit(rng);
+    }
+    return objectives;
+}
+
+std::string case_name(const std::string &base, std::size_t population_size) {
+    return base + "/" + std::to_string(population_size);
+}
+
+std::string case_name(const std::string &base, std::size_t population_size, std::size_t dimension) {
+    return case_name(base, population_size) + "/" + std::to_string(dimension);
+}
+
+void register_population_kernels(Runner &runner, const Options &options) {
+    for (const std::size_t n : options.populations) {
+        for (const std::size_t d : options.dims) {
+            if (n * d > options.max_elements) {
+                continue;
+            }
+            const auto params = make_parameters(n, d);
+            const double items = static_cast<double>(n);
+
+            runner.run(case_name("BM_LatinHypercube", n, d), items, [&params](std::size_t iterations) {
+                std::mt19937 rng(params.random_seed);
+                for (std::size_t it = 0; it < iterations; ++it) {
+                    const auto population = latin_hypercube_population(params, rng);
+                    do_not_optimize(population.data());
+                }
+            });
+
+            runner.run(case_name("BM_LatinHypercubeCounter", n, d), items, [&params](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; ++it) {
+                    const auto population = latin_hypercube_population_parallel(params);
+                    do_not_optimize(population.data());
+                }
+            });
+
+            if (!runner.selected("BM_EvaluateZDT4")) {
+                continue;
+            }
+            const auto population = latin_hypercube_population(params);
+            ObjectiveMatrix objectives(n, 2);
+            runner.run(case_name("BM_EvaluateZDT4", n, d), items, [&](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; ++it) {
+                    evaluate_zdt4_population(population, objectives);
+                    do_not_optimize(objectives.data());
+                }
+            });
+            runner.run(case_name("BM_EvaluateZDT4Fast", n, d), items, [&](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; ++it) {
+                    evaluate_zdt4_batch(population, objectives, CosineMode::fast);
+                    do_not_optimize(objectives.data());
+                }
+            });
+        }
+    }
+}
+
+void register_ranking_kernels(Runner &runner, const Options &options) {
+    for (const std::size_t n : options.populations) {
+        if (n > options.max_quadratic) {
+            continue;
+        }
+        const auto objectives = random_objectives(n, 2, 7U);
+        const double items = static_cast<double>(n);
+
+        FrontSet fronts;
+        SortWorkspace workspace;
+        fronts.reserve(n);
+        workspace.reserve(n);
+        runner.run(case_name("BM_NonDominatedSort", n), items, [&](std::size_t iterations) {
+            for (std::size_t it = 0; it < iterations; ++it) {
+                non_dominated_sort(objectives, fronts, workspace);
+                do_not_optimize(fronts.members.data());
+            }
+        });
+
+        FastSortWorkspace fast_workspace;
+        runner.run(case_name("BM_FastNonDominatedSort", n), items, [&](std::size_t iterations) {
+            for (std::size_t it = 0; it < iterations; ++it) {
+                fast_non_dominated_sort(objectives.data(), n, 2, fronts, fast_workspace);
+                do_not_optimize(fronts.members.data());
+            }
+        });
+
+        // three objectives take the sweep as well, five the general kernels
+        for (const std::size_t m : {std::size_t{3}, std::size_t{5}}) {
+            const auto many = random_objectives(n, m, 7U);
+            runner.run(case_name("BM_FastNonDominatedSortM", n, m), items, [&](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; ++it) {
+                    fast_non_dominated_sort(many.data(), n, m, fronts, fast_workspace);
+                    do_not_optimize(fronts.members.data());
+                }
+            });
+        }
+
+        std::vector<std::size_t> all(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            all[i] = i;
+        }
+        std::vector<double> distance(n);
+        std::vector<std::size_t> scratch;
+        scratch.reserve(n);
+        runner.run(case_name("BM_CrowdingDistance", n), items, [&](std::size_t iterations) {
+            for (std::size_t it = 0; it < iterations; ++it) {
+                crowding_distance(objectives, Span<const std::size_t>(all.data(), n),
+                                  Span<double>(distance.data(), n), scratch);
+                do_not_optimize(distance.data());
+            }
+        });
+
+        // NSGA-II survival: halve the merged population by rank and diversity
+        const std::size_t n_survive = n / 2;
+        SurvivalWorkspace survival;
+        survival.reserve(n, 2);
+        std::vector<std::size_t> survivors(n_survive);
+        std::vector<std::size_t> rank(n_survive);
+        std::vector<double> crowding(n_survive);
+        for (const Diversity diversity : {Diversity::crowding_distance, Diversity::pruning_crowding_distance}) {
+            const char *name = diversity == Diversity::crowding_distance ? "BM_SurviveCD" : "BM_SurvivePCD";
+            runner.run(case_name(name, n), items, [&](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; ++it) {
+                    survive(objectives.data(), n, 2, n_survive, diversity, nullptr, survival, survivors.data(),
+                            rank.data(), crowding.data());
+                    do_not_optimize(survivors.data());
+                }
+            });
+        }
+    }
+}
+
+// MOEA/D-style decomposition and NSGA-III niching distances of a population against 91 weight
+// vectors (three objectives, twelve partitions), every point against every weight.
+void register_decomposition_kernels(Runner &runner, const Options &options) {
+    constexpr std::size_t n_weights = 91;
+    const auto weights = random_objectives(n_weights, 3, 11U);
+    const double utopian[3] = {-1e-6, -1e-6, -1e-6};
+
+    for (const std::size_t n : options.populations) {
+        if (n * n_weights > options.max_elements) {
+            continue;
+        }
+        const auto objectives = random_objectives(n, 3, 7U);
+        const double items = static_cast<double>(n * n_weights);
+        std::vector<double> values(n * n_weights);
+
+        for (const Scalarization kind : {Scalarization::pbi, Scalarization::tchebycheff, Scalarization::asf}) {
+            const char *name = kind == Scalarization::pbi ? "BM_DecomposePBI"
+                               : kind == Scalarization::tchebycheff ? "BM_DecomposeTchebycheff"
+                                                                   : "BM_DecomposeASF";
+            const DecompositionKernel kernel(kind, weights.data(), n_weights, 3);
+            runner.run(case_name(name, n), items, [&](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; ++it) {
+                    kernel.cross(objectives.data(), n, utopian, values.data());
+                    do_not_optimize(values.data());
+                }
+            });
+        }
+
+        runner.run(case_name("BM_PerpendicularDistance", n), items, [&](std::size_t iterations) {
+            for (std::size_t it = 0; it < iterations; ++it) {
+                perpendicular_distance(objectives.data(), n, weights.data(), n_weights, 3, values.data());
+                do_not_optimize(values.data());
+            }
+        });
+    }
+}
+
+// Hypervolume of, and exclusive contributions to, a mutually non-dominated front on the plane
+// f_1 + f_2 + f_3 = 1 (the SMS-EMOA survival workload).
+void register_hypervolume_kernels(Runner &runner, const Options &options) {
+    // the contributions slice every point against the whole front
+    constexpr std::size_t max_contribution_points = 1000;
+    const double ref[3] = {1.1, 1.1, 1.1};
+
+    for (const std::size_t n : options.populations) {
+        auto front = random_objectives(n, 3, 7U);
+        for (std::size_t i = 0; i < n; ++i) {
+            double *f = front.data() + i * 3;
+            const double sum = f[0] + f[1] + f[2];
+            for (std::size_t k = 0; k < 3; ++k) {
+                f[k] /= sum;
+            }
+        }
+        const double items = static_cast<double>(n);
+
+        runner.run(case_name("BM_Hypervolume3D", n), items, [&](std::size_t iterations) {
+            for (std::size_t it = 0; it < iterations; ++it) {
+                double value = hypervolume(front.data(), n, 3, ref);
+                do_not_optimize(&value);
+            }
+        });
+
+        if (n > max_contribution_points) {
+            continue;
+        }
+        std::vector<double> contributions(n);
+        runner.run(case_name("BM_HypervolumeContributions3D", n), items, [&](std::size_t iterations) {
+            for (std::size_t it = 0; it < iterations; ++it) {
+                hypervolume_contributions(front.data(), n, 3, ref, contributions.data());
+                do_not_optimize(contributions.data());
+            }
+        });
+    }
+}
+
+// Training the Kriging surrogate of pre-screening one point at a time up to its default capacity
+// (the rank-1 Cholesky growth) and predicting n candidates from it on one thread.
+void register_surrogate_kernels(Runner &runner, const Options &options) {
+    const OptimizationParameters defaults{};
+    const std::size_t n_train = defaults.surrogate_points;
+    for (const std::size_t d : options.dims) {
+        if (n_train * d > options.max_elements) {
+            continue;
+        }
+        const std::vector<double> lower(d, 0.0);
+        const std::vector<double> upper(d, 1.0);
+        const ObjectiveMatrix x = random_objectives(n_train, d, 11U);
+        const ObjectiveMatrix f = random_objectives(n_train, 2, 13U);
+
+        runner.run(case_name("BM_SurrogateTrain", n_train, d), static_cast<double>(n_train),
+                   [&](std::size_t iterations) {
+                       for (std::size_t it = 0; it < iterations; ++it) {
+                           KrigingSurrogate model(lower, upper, 2, n_train);
+                           for (std::size_t i = 0; i < n_train; ++i) {
+                               model.add(x.row(i), f.row(i));
+                           }
+                           model.fit();
+                           do_not_optimize(model.size());
+                       }
+                   });
+
+        KrigingSurrogate model(lower, upper, 2, n_train);
+        for (std::size_t i = 0; i < n_train; ++i) {
+            model.add(x.row(i), f.row(i));
+        }
+        model.fit();
+        for (const std::size_t n : options.populations) {
+            if (n > options.max_quadratic || n * d > options.max_elements) {
+                continue;
+            }
+            const ObjectiveMatrix candidates = random_objectives(n, d, 17U);
+            std::vector<double> mean(n * 2);
+            std::vector<double> sd(n * 2);
+            runner.run(case_name("BM_SurrogatePredict", n, d), static_cast<double>(n), [&](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; ++it) {
+                    model.predict(candidates.data(), n, mean.data(), sd.data());
+                    do_not_optimize(mean.data());
+                }
+            });
+        }
+    }
+}
+
+void register_generation_step(Runner &runner, const Options &options) {
+    for (const std::size_t n : options.populations) {
+        for (const std::size_t d : options.dims) {
+            const std::string name = case_name("BM_NSGA2Step", n, d);
+            if (n > options.max_quadratic || 2 * n * d > options.max_elements || d < 2 || !runner.selected(name)) {
+                continue;
+            }
+
+            const auto params = make_parameters(n, d);
+            const ZDT4Problem problem(d);
+            SerialEvaluator evaluator;
+            NSGA2 algorithm(params, problem, evaluator);
+            algorithm.initialize();
+
+            runner.run(name, static_cast<double>(n), [&algorithm](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; ++it) {
+                    algorithm.step();
+                }
+                do_not_optimize(algorithm.objectives().data());
+            });
+        }
+    }
+}
+
+void write_json(const std::string &path, const Options &options, const std::vector<Result> &results) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Unable to open benchmark output file: " + path);
+    }
+
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"executable\": \"nsga_bench\",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#if defined(__VERSION__)
+    out << "    \"compiler\": \"" << __VERSION__ << "\",\n";
+#endif
+#if defined(__OPTIMIZE__)
+    out << "    \"library_build_type\": \"release\",\n";
+#else
+    out << "    \"library_build_type\": \"debug\",\n";
+#endif
+    out << "    \"git_revision\": \"" << EDDIE_GIT_REVISION << "\",\n";
+    out << "    \"simd_level\": \"" << simd_level_name(active_simd_level()) << "\",\n";
+    out << "    \"min_time\": " << options.min_time << "\n  },\n";
+
+    out << "  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto &r = results[i];
+        out << "    {\n";
+        out << "      \"name\": \"" << r.name << "\",\n";
+        out << "      \"run_name\": \"" << r.name << "\",\n";
+        out << "      \"run_type\": \"iteration\",\n";
+        out << "      \"iterations\": " << r.iterations << ",\n";
+        out << "      \"real_time\": " << r.real_ns << ",\n";
+        out << "      \"cpu_time\": " << r.cpu_ns << ",\n";
+        out << "      \"time_unit\": \"ns\",\n";
+        out << "      \"items_per_second\": " << r.items_per_second << "\n";
+        out << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    try {
+        const Options options = parse_options(argc, argv);
+
+        std::printf("%-48s %17s %17s %12s\n", "Benchmark", "Time", "CPU", "Iterations");
+        Runner runner(options);
+        register_population_kernels(runner, options);
+        register_ranking_kernels(runner, options);
+        register_decomposition_kernels(runner, options);
+        register_hypervolume_kernels(runner, options);
+        register_surrogate_kernels(runner, options);
+        register_generation_step(runner, options);
+
+        if (!options.out.empty()) {
+            write_json(options.out, options, runner.results());
+            std::cout << "Results written to " << options.out << '\n';
+        }
+    } catch (const std::exception &ex) {
+        std::cerr << "Benchmark failed: " << ex.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
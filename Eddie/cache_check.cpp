@@ -0,0 +1,275 @@
+// Checks of the evaluation cache (`make check`): the claim/pending/abandon protocol of
+// EvaluationCache, concurrent CachedProblem batches with repeated rows, and reloading the
+// cache file after a truncated write or for another problem setup. Exits non-zero on failure.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "evaluation_cache.h"
+#include "parameter.h"
+#include "population.h"
+
+namespace {
+
+std::size_t n_checks = 0;
+std::size_t n_failed = 0;
+
+void check(bool condition, const char *what, int line) {
+    ++n_checks;
+    if (!condition) {
+        ++n_failed;
+        std::cerr << "cache_check.cpp:" << line << ": check failed: " << what << '\n';
+    }
+}
+
+#define CHECK(condition) check((condition), #condition, __LINE__)
+
+// f = (sum of x, first x) and g = (x[1] - x[2]), counting every row it evaluates. The first
+// `failures` calls of evaluate_rows throw, as a crashed solver run would.
+class CountingProblem : public Problem {
+public:
+    explicit CountingProblem(std::size_t failures = 0) : failures_(failures) {}
+
+    std::size_t n_var() const override { return 3; }
+    std::size_t n_obj() const override { return 2; }
+    std::size_t n_constr() const override { return 1; }
+
+    void evaluate_individual(Span<const double> x, Span<double> f, Span<double> g) const override {
+        f[0] = x[0] + x[1] + x[2];
+        f[1] = x[0];
+        g[0] = x[1] - x[2];
+        rows.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void evaluate_rows(const PopulationMatrix &x, std::size_t begin, std::size_t end, ObjectiveMatrix &f,
+                       ConstraintMatrix &g) const override {
+        if (failures_.load() > 0 && failures_.fetch_sub(1) > 0) {
+            throw std::runtime_error("solver failed");
+        }
+        // widens the window in which other threads find the claimed rows pending
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        Problem::evaluate_rows(x, begin, end, f, g);
+    }
+
+    mutable std::atomic<std::size_t> rows{0};
+
+private:
+    mutable std::atomic<std::size_t> failures_;
+};
+
+OptimizationParameters parameters(const std::string &cache_path = {}) {
+    OptimizationParameters params;
+    params.population_size = 16;
+    params.offspring_population_size = 16;
+    params.max_generations = 4;
+    params.variable_lower_bounds = {0.0, 0.0, 0.0};
+    params.variable_upper_bounds = {1.0, 1.0, 1.0};
+    params.cache_path = cache_path;
+    return params;
+}
+
+// `n_distinct` different rows, each repeated `n_repeats` times in an interleaved order
+PopulationMatrix repeated_rows(std::size_t n_distinct, std::size_t n_repeats) {
+    PopulationMatrix x(n_distinct * n_repeats, 3);
+    for (std::size_t i = 0; i < x.rows(); ++i) {
+        const double k = static_cast<double>(i % n_distinct) + 1.0;
+        x(i, 0) = k / 64.0;
+        x(i, 1) = k / 128.0;
+        x(i, 2) = 1.0 - k / 256.0;
+    }
+    return x;
+}
+
+bool matches(const PopulationMatrix &x, const ObjectiveMatrix &f, const ConstraintMatrix &g) {
+    for (std::size_t i = 0; i < x.rows(); ++i) {
+        if (f(i, 0) != x(i, 0) + x(i, 1) + x(i, 2) || f(i, 1) != x(i, 0) || g(i, 0) != x(i, 1) - x(i, 2)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t file_size(const std::string &path) {
+    struct stat info {};
+    return ::stat(path.c_str(), &info) == 0 ? static_cast<std::size_t>(info.st_size) : 0;
+}
+
+void check_protocol() {
+    EvaluationCache cache({0.0, 0.0}, {1.0, 1.0}, 1, 0, 8);
+    const double x[] = {0.25, 0.5};
+    std::int64_t key[2];
+    const std::uint64_t hash = cache.quantize(Span<const double>(x, 2), key);
+
+    std::size_t slot = 0;
+    std::size_t other = 0;
+    CHECK(cache.acquire(key, hash, slot) == EvaluationCache::Lookup::claimed);
+    CHECK(cache.acquire(key, hash, other) == EvaluationCache::Lookup::pending);
+    CHECK(other == slot);
+
+    // a waiter is released by an abandoned claim without a value, and the key can be claimed again
+    bool waited = true;
+    std::thread waiter([&] { waited = cache.wait(slot); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    cache.abandon(slot);
+    waiter.join();
+    CHECK(!waited);
+    CHECK(cache.acquire(key, hash, other) == EvaluationCache::Lookup::claimed);
+    CHECK(other == slot);
+    CHECK(cache.acquire(key, hash, other) == EvaluationCache::Lookup::pending);
+
+    // a waiter is released by the published value
+    std::thread reader([&] { waited = cache.wait(slot); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    const double value = 4.0;
+    cache.publish(slot, Span<const double>(&value, 1), Span<const double>());
+    reader.join();
+    CHECK(waited);
+
+    double read = 0.0;
+    CHECK(cache.acquire(key, hash, other) == EvaluationCache::Lookup::hit);
+    cache.read(other, Span<double>(&read, 1), Span<double>());
+    CHECK(read == 4.0);
+    CHECK(cache.size() == 1);
+
+    // 8 entries get 16 slots, of which 12 may be used; later keys are not cached
+    std::size_t n_claimed = 0;
+    EvaluationCache::Lookup lookup = EvaluationCache::Lookup::claimed;
+    for (std::size_t i = 1; i <= 16 && lookup != EvaluationCache::Lookup::full; ++i) {
+        const double y[] = {0.5 / static_cast<double>(i), 0.75};
+        const std::uint64_t h = cache.quantize(Span<const double>(y, 2), key);
+        lookup = cache.acquire(key, h, slot);
+        n_claimed += lookup == EvaluationCache::Lookup::claimed;
+    }
+    CHECK(lookup == EvaluationCache::Lookup::full);
+    CHECK(n_claimed == 11);
+}
+
+void check_concurrent_batches() {
+    const CountingProblem problem;
+    const OptimizationParameters params = parameters();
+    const CachedProblem cached(problem, params);
+
+    // every thread evaluates the same 8 rows, each 4 times within its own batch
+    const std::size_t n_threads = 4;
+    const PopulationMatrix x = repeated_rows(8, 4);
+    std::vector<ObjectiveMatrix> f(n_threads, ObjectiveMatrix(x.rows(), 2));
+    std::vector<ConstraintMatrix> g(n_threads, ConstraintMatrix(x.rows(), 1));
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < n_threads; ++t) {
+        threads.emplace_back([&, t] { cached.evaluate_rows(x, 0, x.rows(), f[t], g[t]); });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (std::size_t t = 0; t < n_threads; ++t) {
+        CHECK(matches(x, f[t], g[t]));
+    }
+    CHECK(problem.rows == 8);
+    CHECK(cached.evaluations() == 8);
+    CHECK(cached.hits() == n_threads * x.rows() - 8);
+    CHECK(cached.cache().size() == 8);
+}
+
+void check_failed_batch() {
+    const CountingProblem problem(1);
+    const OptimizationParameters params = parameters();
+    const CachedProblem cached(problem, params);
+
+    // the throwing batch abandons its claims, so the repeated rows are evaluated on the next try
+    const PopulationMatrix x = repeated_rows(4, 2);
+    ObjectiveMatrix f(x.rows(), 2);
+    ConstraintMatrix g(x.rows(), 1);
+    bool thrown = false;
+    try {
+        cached.evaluate_rows(x, 0, x.rows(), f, g);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    CHECK(problem.rows == 0);
+
+    cached.evaluate_rows(x, 0, x.rows(), f, g);
+    CHECK(matches(x, f, g));
+    CHECK(problem.rows == 4);
+    CHECK(cached.hits() == 4);
+}
+
+void check_reload(const std::string &path) {
+    const CountingProblem problem;
+    const PopulationMatrix x = repeated_rows(10, 1);
+    ObjectiveMatrix f(x.rows(), 2);
+    ConstraintMatrix g(x.rows(), 1);
+    {
+        const CachedProblem cached(problem, parameters(path));
+        cached.evaluate_rows(x, 0, x.rows(), f, g);
+        CHECK(cached.cache().loaded() == 0);
+    }
+
+    // an interrupted append leaves half a record behind; the complete ones are kept
+    const std::size_t record = 3 * sizeof(std::int64_t) + 3 * sizeof(double);
+    CHECK(::truncate(path.c_str(), static_cast<off_t>(file_size(path) - record / 2)) == 0);
+    {
+        const CachedProblem cached(problem, parameters(path));
+        CHECK(cached.cache().loaded() == 9);
+        cached.evaluate_rows(x, 0, x.rows(), f, g);
+        CHECK(matches(x, f, g));
+        CHECK(cached.hits() == 9);
+        CHECK(cached.evaluations() == 1);
+    }
+    {
+        // the torn record was dropped before appending, so the file holds all ten again
+        const CachedProblem cached(problem, parameters(path));
+        CHECK(cached.cache().loaded() == 10);
+    }
+    CHECK(problem.rows == 11);
+
+    // a file written for other bounds or another resolution is refused rather than misread
+    const auto rejected = [&](const OptimizationParameters &params) {
+        try {
+            const CachedProblem cached(problem, params);
+        } catch (const std::runtime_error &) {
+            return true;
+        }
+        return false;
+    };
+    OptimizationParameters other_bounds = parameters(path);
+    other_bounds.variable_upper_bounds[1] = 2.0;
+    CHECK(rejected(other_bounds));
+    OptimizationParameters other_resolution = parameters(path);
+    other_resolution.cache_resolution = 1e-6;
+    CHECK(rejected(other_resolution));
+    CHECK(file_size(path) == sizeof(EvaluationCacheHeader) + 6 * sizeof(double) + 10 * record);
+}
+
+} // namespace
+
+int main() {
+    const char *tmpdir = std::getenv("TMPDIR");
+    const std::string path = std::string(tmpdir != nullptr ? tmpdir : "/tmp") + "/eddie_cache_check_" +
+                             std::to_string(::getpid()) + ".bin";
+    try {
+        check_protocol();
+        check_concurrent_batches();
+        check_failed_batch();
+        check_reload(path);
+    } catch (const std::exception &error) {
+        std::cerr << "cache_check: unexpected exception: " << error.what() << '\n';
+        ++n_failed;
+    }
+    std::remove(path.c_str());
+
+    std::cout << "cache_check: " << n_checks - n_failed << " of " << n_checks << " checks passed\n";
+    return n_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
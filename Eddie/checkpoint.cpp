@@ -0,0 +1,286 @@
+#include "checkpoint.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "telemetry.h"
+
+namespace {
+
+constexpr char checkpoint_magic[8] = {'E', 'D', 'D', 'I', 'E', 'C', 'K', '\0'};
+constexpr std::uint64_t block_alignment = 64;
+
+std::uint64_t align_up(std::uint64_t offset) {
+    return (offset + block_alignment - 1) / block_alignment * block_alignment;
+}
+
+// Owns a file descriptor opened for writing and appends with short-write handling.
+class OutputFile {
+public:
+    explicit OutputFile(const std::string &path) : path_(path) {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            fail("open");
+        }
+    }
+
+    ~OutputFile() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    OutputFile(const OutputFile &) = delete;
+    OutputFile &operator=(const OutputFile &) = delete;
+
+    void write(const void *data, std::size_t size) {
+        const char *bytes = static_cast<const char *>(data);
+        while (size > 0) {
+            const ssize_t n = ::write(fd_, bytes, size);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                fail("write");
+            }
+            bytes += n;
+            size -= static_cast<std::size_t>(n);
+            offset_ += static_cast<std::uint64_t>(n);
+        }
+    }
+
+    void pad_to(std::uint64_t offset) {
+        static const char zeros[block_alignment] = {};
+        while (offset_ < offset) {
+            write(zeros, static_cast<std::size_t>(std::min<std::uint64_t>(offset - offset_, block_alignment)));
+        }
+    }
+
+    void sync_and_close() {
+        if (::fsync(fd_) != 0) {
+            fail("sync");
+        }
+        const int fd = fd_;
+        fd_ = -1;
+        if (::close(fd) != 0) {
+            fail("close");
+        }
+    }
+
+private:
+    [[noreturn]] void fail(const char *what) const {
+        throw std::runtime_error(std::string("Unable to ") + what + " checkpoint " + path_ + ": " +
+                                 std::strerror(errno));
+    }
+
+    std::string path_;
+    int fd_ = -1;
+    std::uint64_t offset_ = 0;
+};
+
+// Makes a rename in the directory holding `path` durable; without it a crash may bring back the old entry.
+void sync_directory(const std::string &path) {
+    const std::size_t slash = path.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+
+    const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open checkpoint directory " + directory + ": " + std::strerror(errno));
+    }
+    const int result = ::fsync(fd);
+    const int error = errno;
+    ::close(fd);
+    if (result != 0) {
+        throw std::runtime_error("Unable to sync checkpoint directory " + directory + ": " + std::strerror(error));
+    }
+}
+
+} // namespace
+
+bool checkpoint_exists(const std::string &path) {
+    struct stat info {};
+    return ::stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode);
+}
+
+CheckpointView::CheckpointView(const std::string &path) : file_(path) {
+    const auto corrupt = [&path](const std::string &reason) {
+        return std::runtime_error("Invalid checkpoint " + path + ": " + reason);
+    };
+
+    if (file_.size() < sizeof(CheckpointHeader)) {
+        throw corrupt("file is too small");
+    }
+    header_ = reinterpret_cast<const CheckpointHeader *>(file_.data());
+    if (std::memcmp(header_->magic, checkpoint_magic, sizeof(checkpoint_magic)) != 0) {
+        throw corrupt("bad magic number");
+    }
+    if (header_->version != CheckpointHeader::current_version || header_->header_size != sizeof(CheckpointHeader)) {
+        throw corrupt("unsupported version " + std::to_string(header_->version));
+    }
+    if (header_->file_size != file_.size()) {
+        throw corrupt("truncated file");
+    }
+
+    // the counts come from the file, so each product is checked by division before it is formed
+    const auto block_bytes = [this, &corrupt](std::uint64_t count, std::uint64_t cols, std::uint64_t width) {
+        if (cols != 0 && count > header_->file_size / width / cols) {
+            throw corrupt("block outside the file");
+        }
+        return count * cols * width;
+    };
+    const struct {
+        std::uint64_t offset;
+        std::uint64_t bytes;
+    } blocks[] = {
+        {header_->population_offset, block_bytes(header_->rows, header_->n_var, sizeof(double))},
+        {header_->objectives_offset, block_bytes(header_->rows, header_->n_obj, sizeof(double))},
+        {header_->rank_offset, block_bytes(header_->rows, 1, sizeof(std::uint64_t))},
+        {header_->crowding_offset, block_bytes(header_->rows, 1, sizeof(double))},
+        {header_->rng_offset, block_bytes(header_->rng_size, 1, 1)},
+    };
+    for (const auto &b : blocks) {
+        if (b.offset % block_alignment != 0 || b.offset > header_->file_size || b.bytes > header_->file_size - b.offset) {
+            throw corrupt("block outside the file");
+        }
+    }
+}
+
+void CheckpointView::restore_rng(std::mt19937 &rng) const {
+    std::istringstream in(std::string(file_.data() + header_->rng_offset, header_->rng_size));
+    in >> rng;
+    if (!in) {
+        throw std::runtime_error("Invalid checkpoint: unreadable random number generator state");
+    }
+}
+
+CheckpointWriter::CheckpointWriter(std::string path)
+    : path_(std::move(path)), worker_(&CheckpointWriter::worker_loop, this) {}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_one();
+    worker_.join();
+}
+
+void CheckpointWriter::submit(std::size_t generation, const PopulationMatrix &population,
+                              const ObjectiveMatrix &objectives, Span<const std::size_t> rank,
+                              Span<const double> crowding, const std::mt19937 &rng) {
+    std::ostringstream rng_state;
+    rng_state << rng;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    rethrow_error();
+
+    pending_.generation = generation;
+    pending_.population.resize(population.rows(), population.cols());
+    std::copy(population.data(), population.data() + population.size(), pending_.population.data());
+    pending_.objectives.resize(objectives.rows(), objectives.cols());
+    std::copy(objectives.data(), objectives.data() + objectives.size(), pending_.objectives.data());
+    pending_.rank.assign(rank.begin(), rank.end());
+    pending_.crowding.assign(crowding.begin(), crowding.end());
+    pending_.rng_state = rng_state.str();
+    has_pending_ = true;
+    work_cv_.notify_one();
+}
+
+void CheckpointWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return !has_pending_ && !busy_; });
+    rethrow_error();
+}
+
+std::size_t CheckpointWriter::written() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+void CheckpointWriter::rethrow_error() {
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+void CheckpointWriter::worker_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock, [this] { return stopping_ || has_pending_; });
+        if (!has_pending_) {
+            return;
+        }
+
+        // the snapshots trade places, so the next submit reuses the buffers just written
+        std::swap(pending_, writing_);
+        has_pending_ = false;
+        busy_ = true;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            write(writing_);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        busy_ = false;
+        if (error) {
+            error_ = error;
+        } else {
+            ++written_;
+        }
+        idle_cv_.notify_all();
+    }
+}
+
+void CheckpointWriter::write(const Snapshot &snapshot) const {
+    EDDIE_TELEMETRY_SCOPE(io);
+    CheckpointHeader header{};
+    std::memcpy(header.magic, checkpoint_magic, sizeof(checkpoint_magic));
+    header.version = CheckpointHeader::current_version;
+    header.header_size = sizeof(CheckpointHeader);
+    header.generation = snapshot.generation;
+    header.rows = snapshot.population.rows();
+    header.n_var = snapshot.population.cols();
+    header.n_obj = snapshot.objectives.cols();
+
+    header.population_offset = align_up(sizeof(CheckpointHeader));
+    header.objectives_offset = align_up(header.population_offset + snapshot.population.size() * sizeof(double));
+    header.rank_offset = align_up(header.objectives_offset + snapshot.objectives.size() * sizeof(double));
+    header.crowding_offset = align_up(header.rank_offset + snapshot.rank.size() * sizeof(std::uint64_t));
+    header.rng_offset = align_up(header.crowding_offset + snapshot.crowding.size() * sizeof(double));
+    header.rng_size = snapshot.rng_state.size();
+    header.file_size = header.rng_offset + header.rng_size;
+
+    const std::string temporary = path_ + ".tmp";
+    {
+        OutputFile out(temporary);
+        out.write(&header, sizeof(header));
+        out.pad_to(header.population_offset);
+        out.write(snapshot.population.data(), snapshot.population.size() * sizeof(double));
+        out.pad_to(header.objectives_offset);
+        out.write(snapshot.objectives.data(), snapshot.objectives.size() * sizeof(double));
+        out.pad_to(header.rank_offset);
+        out.write(snapshot.rank.data(), snapshot.rank.size() * sizeof(std::uint64_t));
+        out.pad_to(header.crowding_offset);
+        out.write(snapshot.crowding.data(), snapshot.crowding.size() * sizeof(double));
+        out.pad_to(header.rng_offset);
+        out.write(snapshot.rng_state.data(), snapshot.rng_state.size());
+        out.sync_and_close();
+    }
+
+    if (std::rename(temporary.c_str(), path_.c_str()) != 0) {
+        throw std::runtime_error("Unable to replace checkpoint " + path_ + ": " + std::strerror(errno));
+    }
+    sync_directory(path_);
+}
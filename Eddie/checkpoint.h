@@ -0,0 +1,122 @@
+#ifndef EDDIE_CHECKPOINT_H
+#define EDDIE_CHECKPOINT_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mapped_file.h"
+#include "population.h"
+
+// On-disk checkpoint layout (native endianness, version 1):
+//
+//   CheckpointHeader | population (rows x n_var doubles) | objectives (rows x n_obj doubles)
+//   | rank (rows uint64) | crowding (rows doubles) | mt19937 state (text, as written by operator<<)
+//
+// Every block starts at a 64-byte aligned offset recorded in the header, so a mapped checkpoint
+// is used in place without parsing. Files are written to `<path>.tmp` and renamed over `path`,
+// so a preemption during a write leaves the previous checkpoint intact.
+struct CheckpointHeader {
+    static constexpr std::uint32_t current_version = 1;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint64_t file_size;
+    std::uint64_t generation;
+    std::uint64_t rows;
+    std::uint64_t n_var;
+    std::uint64_t n_obj;
+    std::uint64_t population_offset;
+    std::uint64_t objectives_offset;
+    std::uint64_t rank_offset;
+    std::uint64_t crowding_offset;
+    std::uint64_t rng_offset;
+    std::uint64_t rng_size;
+};
+
+bool checkpoint_exists(const std::string &path);
+
+// A validated, memory-mapped checkpoint. The spans point into the mapping.
+class CheckpointView {
+public:
+    explicit CheckpointView(const std::string &path);
+
+    std::size_t generation() const { return static_cast<std::size_t>(header_->generation); }
+    std::size_t rows() const { return static_cast<std::size_t>(header_->rows); }
+    std::size_t n_var() const { return static_cast<std::size_t>(header_->n_var); }
+    std::size_t n_obj() const { return static_cast<std::size_t>(header_->n_obj); }
+
+    Span<const double> population() const { return block<double>(header_->population_offset, rows() * n_var()); }
+    Span<const double> objectives() const { return block<double>(header_->objectives_offset, rows() * n_obj()); }
+    Span<const std::uint64_t> rank() const { return block<std::uint64_t>(header_->rank_offset, rows()); }
+    Span<const double> crowding() const { return block<double>(header_->crowding_offset, rows()); }
+
+    void restore_rng(std::mt19937 &rng) const;
+
+private:
+    template <typename T>
+    Span<const T> block(std::uint64_t offset, std::size_t count) const {
+        return Span<const T>(reinterpret_cast<const T *>(file_.data() + offset), count);
+    }
+
+    MappedFile file_;
+    const CheckpointHeader *header_ = nullptr;
+};
+
+// Writes checkpoints on a background thread. `submit` copies the state into a reusable snapshot
+// and returns, so the optimization loop only pays for a memcpy; if a snapshot is still waiting
+// when the next one arrives, the newer one replaces it.
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(std::string path);
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    // Rethrows the error of an earlier failed write, if any.
+    void submit(std::size_t generation, const PopulationMatrix &population, const ObjectiveMatrix &objectives,
+                Span<const std::size_t> rank, Span<const double> crowding, const std::mt19937 &rng);
+
+    // Blocks until every submitted snapshot is on disk; rethrows write errors.
+    void flush();
+
+    std::size_t written() const;
+
+private:
+    struct Snapshot {
+        std::size_t generation = 0;
+        PopulationMatrix population{};
+        ObjectiveMatrix objectives{};
+        std::vector<std::uint64_t> rank{};
+        std::vector<double> crowding{};
+        std::string rng_state{};
+    };
+
+    void worker_loop();
+    void write(const Snapshot &snapshot) const;
+    void rethrow_error();
+
+    std::string path_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    Snapshot pending_{};
+    Snapshot writing_{};
+    bool has_pending_ = false;
+    bool busy_ = false;
+    bool stopping_ = false;
+    std::size_t written_ = 0;
+    std::exception_ptr error_{};
+    std::thread worker_;
+};
+
+#endif // EDDIE_CHECKPOINT_H
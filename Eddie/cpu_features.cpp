@@ -0,0 +1,110 @@
+#include "cpu_features.h"
+
+#include <cstdlib>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#define EDDIE_X86_MSVC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define EDDIE_X86_GNU
+#endif
+
+namespace {
+
+#if defined(EDDIE_X86_MSVC)
+
+// CPUID bits, and XCR0 bits of the register state the operating system saves on a context switch.
+SimdLevel detect_msvc() {
+    int info[4];
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    if (max_leaf < 1) {
+        return SimdLevel::scalar;
+    }
+
+    __cpuid(info, 1);
+    const bool sse4 = (info[2] & (1 << 19)) != 0 && (info[2] & (1 << 20)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!sse4) {
+        return SimdLevel::scalar;
+    }
+    if (!osxsave || !avx || max_leaf < 7) {
+        return SimdLevel::sse4;
+    }
+
+    const unsigned long long xcr0 = _xgetbv(0);
+    const bool ymm_state = (xcr0 & 0x6) == 0x6;
+    const bool zmm_state = (xcr0 & 0xe6) == 0xe6;
+
+    __cpuidex(info, 7, 0);
+    const bool avx2 = (info[1] & (1 << 5)) != 0;
+    const bool avx512f = (info[1] & (1 << 16)) != 0;
+    if (!avx2 || !ymm_state) {
+        return SimdLevel::sse4;
+    }
+    return avx512f && zmm_state ? SimdLevel::avx512 : SimdLevel::avx2;
+}
+
+#endif
+
+} // namespace
+
+SimdLevel detect_simd_level() {
+#if defined(EDDIE_X86_GNU)
+    // libgcc / compiler-rt also check XGETBV, so AVX is only reported where the OS supports it
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return SimdLevel::sse4;
+    }
+    return SimdLevel::scalar;
+#elif defined(EDDIE_X86_MSVC)
+    return detect_msvc();
+#else
+    return SimdLevel::scalar;
+#endif
+}
+
+SimdLevel active_simd_level() {
+    static const SimdLevel level = [] {
+        const SimdLevel detected = detect_simd_level();
+        SimdLevel requested;
+        const char *value = std::getenv("EDDIE_SIMD");
+        if (value != nullptr && parse_simd_level(value, requested) && requested < detected) {
+            return requested;
+        }
+        return detected;
+    }();
+    return level;
+}
+
+const char *simd_level_name(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::scalar:
+        return "scalar";
+    case SimdLevel::sse4:
+        return "sse4";
+    case SimdLevel::avx2:
+        return "avx2";
+    case SimdLevel::avx512:
+        return "avx512";
+    }
+    return "scalar";
+}
+
+bool parse_simd_level(const std::string &name, SimdLevel &level) {
+    for (const SimdLevel candidate : {SimdLevel::scalar, SimdLevel::sse4, SimdLevel::avx2, SimdLevel::avx512}) {
+        if (name == simd_level_name(candidate)) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,25 @@
+#ifndef EDDIE_CPU_FEATURES_H
+#define EDDIE_CPU_FEATURES_H
+
+#include <string>
+
+// Instruction set levels of the kernels in simd_kernels.h, in increasing order. Each level is a
+// separate translation unit compiled with the matching target flags (see the Makefile and
+// setup.py), so one binary carries all of them and picks the best one the host supports.
+enum class SimdLevel { scalar = 0, sse4 = 1, avx2 = 2, avx512 = 3 };
+
+// Highest level supported by the CPU and the operating system (AVX state saved by the kernel).
+// Always `scalar` on other architectures than x86-64.
+SimdLevel detect_simd_level();
+
+// Level the kernels run at: the detected one, or a lower one requested by the environment
+// variable EDDIE_SIMD (`scalar`, `sse4`, `avx2` or `avx512`). Requests above the detected level
+// and unknown values are ignored. Resolved on the first call and fixed afterwards.
+SimdLevel active_simd_level();
+
+const char *simd_level_name(SimdLevel level);
+
+// Parses one of the names of simd_level_name; returns false for anything else.
+bool parse_simd_level(const std::string &name, SimdLevel &level);
+
+#endif // EDDIE_CPU_FEATURES_H
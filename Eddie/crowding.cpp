@@ -0,0 +1,45 @@
+#include "crowding.h"
+
+#include <algorithm>
+#include <limits>
+
+void crowding_distance(const ObjectiveMatrix &objectives,
+                       Span<const std::size_t> front,
+                       Span<double> distance,
+                       std::vector<std::size_t> &scratch) {
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    const std::size_t n = front.size();
+
+    if (n <= 2) {
+        for (const std::size_t p : front) {
+            distance[p] = infinity;
+        }
+        return;
+    }
+
+    for (const std::size_t p : front) {
+        distance[p] = 0.0;
+    }
+
+    scratch.assign(front.begin(), front.end());
+    for (std::size_t m = 0; m < objectives.cols(); ++m) {
+        std::sort(scratch.begin(), scratch.end(), [&objectives, m](std::size_t a, std::size_t b) {
+            return objectives(a, m) < objectives(b, m);
+        });
+
+        const double f_min = objectives(scratch.front(), m);
+        const double f_max = objectives(scratch.back(), m);
+        distance[scratch.front()] = infinity;
+        distance[scratch.back()] = infinity;
+
+        const double range = f_max - f_min;
+        if (range <= 0.0) {
+            continue;
+        }
+
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            const std::size_t p = scratch[i];
+            distance[p] += (objectives(scratch[i + 1], m) - objectives(scratch[i - 1], m)) / range;
+        }
+    }
+}
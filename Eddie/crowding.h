@@ -0,0 +1,17 @@
+#ifndef EDDIE_CROWDING_H
+#define EDDIE_CROWDING_H
+
+#include <cstddef>
+#include <vector>
+
+#include "population.h"
+
+// Crowding distance (Deb et al., 2002) of the points listed in `front`. Results are written
+// to `distance[point]`; boundary points of every objective receive +infinity. `scratch` is
+// reused for the per-objective ordering and does not reallocate once it holds the front size.
+void crowding_distance(const ObjectiveMatrix &objectives,
+                       Span<const std::size_t> front,
+                       Span<double> distance,
+                       std::vector<std::size_t> &scratch);
+
+#endif // EDDIE_CROWDING_H
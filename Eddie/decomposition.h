@@ -0,0 +1,223 @@
+#ifndef EDDIE_DECOMPOSITION_H
+#define EDDIE_DECOMPOSITION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "parallel.h"
+#include "simd_kernels.h"
+
+// Scalarizing functions of decomposition-based algorithms (MOEA/D), for a point f, a weight
+// vector w and the utopian point z:
+//
+//   pbi:          d1 + theta * d2, where d1 = (f - z) . w / |w| and d2 = |f - z - d1 * w / |w||
+//   tchebycheff:  max_k |f_k - z_k| * w_k
+//   asf:          max_k (f_k - z_k) / w_k, with zero weights replaced by weight_0
+//
+// The weights are prepared once (norms, substituted zeros) and stored objective-major in tiles
+// of 64, so that evaluating one point against a tile runs along consecutive weights and
+// vectorizes; that loop comes from the kernel table of simd_kernels.h, in the variant for the
+// host CPU. `cross` evaluates every point against every weight in a single pass without
+// materializing the repeated F x W pairs; tiles of points are spread over threads and every
+// thread writes its own output rows, so the result does not depend on the thread count. The
+// arithmetic follows the numpy implementations of pymoo/decomposition operation for operation.
+//
+// Besides that table (the Eddie core library) it only depends on parallel.h, so the compiled pymoo
+// module can share it (pymoo/functions/compiled/decomposition.pyx).
+
+enum class Scalarization { pbi, tchebycheff, asf };
+
+inline Scalarization parse_scalarization(const std::string &name) {
+    if (name == "pbi") {
+        return Scalarization::pbi;
+    }
+    if (name == "tchebycheff") {
+        return Scalarization::tchebycheff;
+    }
+    if (name == "asf") {
+        return Scalarization::asf;
+    }
+    throw std::invalid_argument("Unknown scalarization: " + name);
+}
+
+class DecompositionKernel {
+public:
+    static constexpr std::size_t weight_tile = simd_detail::tile_width;
+    static constexpr std::size_t point_tile = 64;
+
+    // An empty kernel without weights, set up later with `assign`.
+    DecompositionKernel() = default;
+
+    DecompositionKernel(Scalarization kind, const double *weights, std::size_t n_weights, std::size_t n_obj,
+                        double theta = 5.0, double weight_0 = 1e-10) {
+        assign(kind, weights, n_weights, n_obj, theta, weight_0);
+    }
+
+    DecompositionKernel(const std::string &kind, const double *weights, std::size_t n_weights, std::size_t n_obj,
+                        double theta = 5.0, double weight_0 = 1e-10)
+        : DecompositionKernel(parse_scalarization(kind), weights, n_weights, n_obj, theta, weight_0) {}
+
+    // Replaces the scalarization and the weights. The tiles keep their capacity, so a kernel
+    // that is kept across calls (see KernelWorkspace) stops allocating once it has seen the
+    // largest weight set.
+    void assign(Scalarization kind, const double *weights, std::size_t n_weights, std::size_t n_obj,
+                double theta = 5.0, double weight_0 = 1e-10) {
+        if (n_obj == 0) {
+            throw std::invalid_argument("Decomposition requires at least one objective");
+        }
+        kind_ = kind;
+        n_weights_ = n_weights;
+        n_obj_ = n_obj;
+        theta_ = theta;
+        n_tiles_ = (n_weights + weight_tile - 1) / weight_tile;
+        tiles_.assign(n_tiles_ * n_obj * weight_tile, 0.0);
+        norms_.assign(n_tiles_ * weight_tile, 1.0);
+
+        for (std::size_t j = 0; j < n_weights_; ++j) {
+            double norm = 0.0;
+            for (std::size_t k = 0; k < n_obj_; ++k) {
+                double w = weights[j * n_obj_ + k];
+                norm += w * w;
+                if (kind_ == Scalarization::asf && w == 0.0) {
+                    w = weight_0;
+                }
+                weight(j, k) = w;
+            }
+            norms_[j] = std::sqrt(norm);
+        }
+    }
+
+    void assign(const std::string &kind, const double *weights, std::size_t n_weights, std::size_t n_obj,
+                double theta = 5.0, double weight_0 = 1e-10) {
+        assign(parse_scalarization(kind), weights, n_weights, n_obj, theta, weight_0);
+    }
+
+    std::size_t n_weights() const { return n_weights_; }
+    std::size_t n_obj() const { return n_obj_; }
+
+    // out[i * n_weights + j] = g(F_i | w_j, z) for the rows of the row-major n_points x n_obj F.
+    void cross(const double *F, std::size_t n_points, const double *utopian, double *out,
+               std::size_t n_threads = 1) const {
+        const std::size_t n_point_tiles = (n_points + point_tile - 1) / point_tile;
+        n_threads = resolve_thread_count(n_threads, n_points * n_weights_, min_pairs_per_thread);
+        parallel_for_tiles(n_point_tiles, n_threads, [&](std::size_t tile, std::size_t) {
+            const std::size_t begin = tile * point_tile;
+            const std::size_t end = std::min(begin + point_tile, n_points);
+
+            double shifted[point_tile * max_stack_obj];
+            std::vector<double> heap_shifted;
+            double *f_shifted = shifted;
+            if (n_obj_ > max_stack_obj) {
+                heap_shifted.resize(point_tile * n_obj_);
+                f_shifted = heap_shifted.data();
+            }
+            for (std::size_t i = begin; i < end; ++i) {
+                for (std::size_t k = 0; k < n_obj_; ++k) {
+                    f_shifted[(i - begin) * n_obj_ + k] = F[i * n_obj_ + k] - utopian[k];
+                }
+            }
+
+            // each weight tile stays in cache while the whole point tile is evaluated against it
+            double values[weight_tile];
+            const DecompositionTileKernel kernel = tile_kernel();
+            for (std::size_t t = 0; t < n_tiles_; ++t) {
+                const std::size_t first = t * weight_tile;
+                const std::size_t count = std::min(weight_tile, n_weights_ - first);
+                for (std::size_t i = begin; i < end; ++i) {
+                    evaluate_tile(kernel, f_shifted + (i - begin) * n_obj_, t, values);
+                    std::copy(values, values + count, out + i * n_weights_ + first);
+                }
+            }
+        });
+    }
+
+    // out[i] = g(F_i | w_i, z) for the n_weights rows of F, one weight per point.
+    void paired(const double *F, const double *utopian, double *out) const {
+        for (std::size_t i = 0; i < n_weights_; ++i) {
+            const double *f = F + i * n_obj_;
+            switch (kind_) {
+            case Scalarization::pbi: {
+                double d1 = 0.0;
+                for (std::size_t k = 0; k < n_obj_; ++k) {
+                    d1 += (f[k] - utopian[k]) * weight(i, k);
+                }
+                d1 /= norms_[i];
+                double d2 = 0.0;
+                for (std::size_t k = 0; k < n_obj_; ++k) {
+                    const double r = (f[k] - utopian[k]) - d1 * weight(i, k) / norms_[i];
+                    d2 += r * r;
+                }
+                out[i] = d1 + theta_ * std::sqrt(d2);
+                break;
+            }
+            case Scalarization::tchebycheff: {
+                double value = -std::numeric_limits<double>::infinity();
+                for (std::size_t k = 0; k < n_obj_; ++k) {
+                    value = nan_max(value, std::fabs(f[k] - utopian[k]) * weight(i, k));
+                }
+                out[i] = value;
+                break;
+            }
+            case Scalarization::asf: {
+                double value = -std::numeric_limits<double>::infinity();
+                for (std::size_t k = 0; k < n_obj_; ++k) {
+                    value = nan_max(value, (f[k] - utopian[k]) / weight(i, k));
+                }
+                out[i] = value;
+                break;
+            }
+            }
+        }
+    }
+
+private:
+    // Maximum that keeps a NaN from either side (std::max drops it when it is the second argument),
+    // as the tiles of simd_kernels.inc do.
+    static double nan_max(double value, double v) { return v > value || v != v ? v : value; }
+
+    // Point-weight pairs per thread below which starting another thread costs more than it saves.
+    static constexpr std::size_t min_pairs_per_thread = std::size_t{1} << 16;
+    static constexpr std::size_t max_stack_obj = 16;
+
+    // weight j, objective k, in tile j / 64 at column j % 64
+    double &weight(std::size_t j, std::size_t k) {
+        return tiles_[((j / weight_tile) * n_obj_ + k) * weight_tile + j % weight_tile];
+    }
+    double weight(std::size_t j, std::size_t k) const {
+        return tiles_[((j / weight_tile) * n_obj_ + k) * weight_tile + j % weight_tile];
+    }
+
+    // values[c] = g(f | w_(64 t + c), z) for one shifted point f - z and all 64 columns of tile t
+    // (padding columns carry zero weights and are never copied out).
+    void evaluate_tile(DecompositionTileKernel kernel, const double *f, std::size_t t, double *values) const {
+        kernel(f, tiles_.data() + t * n_obj_ * weight_tile, norms_.data() + t * weight_tile, n_obj_, theta_, values);
+    }
+
+    DecompositionTileKernel tile_kernel() const {
+        const SimdKernels &kernels = simd_kernels();
+        switch (kind_) {
+        case Scalarization::tchebycheff:
+            return kernels.tchebycheff_tile;
+        case Scalarization::asf:
+            return kernels.asf_tile;
+        case Scalarization::pbi:
+            break;
+        }
+        return kernels.pbi_tile;
+    }
+
+    Scalarization kind_ = Scalarization::pbi;
+    std::size_t n_weights_ = 0;
+    std::size_t n_obj_ = 0;
+    double theta_ = 5.0;
+    std::size_t n_tiles_ = 0;
+    std::vector<double> tiles_{};  // per tile: n_obj rows of 64 weights
+    std::vector<double> norms_{};
+};
+
+#endif // EDDIE_DECOMPOSITION_H
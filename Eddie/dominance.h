@@ -0,0 +1,130 @@
+#ifndef EDDIE_DOMINANCE_H
+#define EDDIE_DOMINANCE_H
+
+#include <cstddef>
+#include <type_traits>
+
+#include "telemetry.h"
+
+// Pareto relations between objective vectors (minimization). Every kernel is a template on the
+// objective count M: M = 2, 3 and 4 get their own instantiation with the loop fully unrolled, and
+// M = dynamic_objectives reads `n_obj` at run time. `with_objective_count` picks the
+// instantiation for a run-time count once, outside the loops that call the kernel, and the
+// `*_kernel` functions hand out the same choice as function pointers for the Cython layer.
+constexpr int dynamic_objectives = 0;
+
+namespace dominance_detail {
+
+template <int M>
+constexpr std::size_t objective_count(std::size_t n_obj) {
+    return M == dynamic_objectives ? n_obj : static_cast<std::size_t>(M);
+}
+
+} // namespace dominance_detail
+
+// Returns 1 if `a` dominates `b`, -1 if `b` dominates `a` and 0 if they are indifferent or
+// equal. This mirrors `c_get_relation` in the compiled pymoo sorting module.
+template <int M>
+inline int dominance_relation_fixed(const double *a, const double *b, std::size_t n_obj, double epsilon = 0.0) {
+    EDDIE_TELEMETRY_ADD(dominance_comparisons, 1);
+    const std::size_t m = dominance_detail::objective_count<M>(n_obj);
+    int val = 0;
+    for (std::size_t i = 0; i < m; ++i) {
+        if (a[i] + epsilon < b[i]) {
+            if (val == -1) {
+                return 0;
+            }
+            val = 1;
+        } else if (a[i] > b[i] + epsilon) {
+            if (val == 1) {
+                return 0;
+            }
+            val = -1;
+        }
+    }
+    return val;
+}
+
+inline int dominance_relation(const double *a, const double *b, std::size_t n_obj, double epsilon = 0.0) {
+    return dominance_relation_fixed<dynamic_objectives>(a, b, n_obj, epsilon);
+}
+
+// True if `a` dominates `b`.
+template <int M>
+inline bool dominates_fixed(const double *a, const double *b, std::size_t n_obj) {
+    const std::size_t m = dominance_detail::objective_count<M>(n_obj);
+    bool better = false;
+    for (std::size_t k = 0; k < m; ++k) {
+        if (a[k] > b[k]) {
+            return false;
+        }
+        better = better || a[k] < b[k];
+    }
+    return better;
+}
+
+template <int M>
+inline bool objectives_equal_fixed(const double *a, const double *b, std::size_t n_obj) {
+    const std::size_t m = dominance_detail::objective_count<M>(n_obj);
+    for (std::size_t k = 0; k < m; ++k) {
+        if (a[k] != b[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// True unless `b` is better than `a` in one of the objectives objectives[first..n_obj) (b's
+// objectives in sorted order, as kept by best order sort, whose earlier objectives are already
+// known to be no better).
+template <int M>
+inline bool no_better_from_fixed(const double *a, const double *b, const int *objectives, std::size_t first,
+                                 std::size_t n_obj) {
+    const std::size_t m = dominance_detail::objective_count<M>(n_obj);
+    for (std::size_t i = first; i < m; ++i) {
+        const auto k = static_cast<std::size_t>(objectives[i]);
+        if (b[k] < a[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Calls kernel(std::integral_constant<int, M>{}) with the instantiation for `n_obj`.
+template <typename Kernel>
+inline decltype(auto) with_objective_count(std::size_t n_obj, Kernel &&kernel) {
+    switch (n_obj) {
+    case 2:
+        return kernel(std::integral_constant<int, 2>{});
+    case 3:
+        return kernel(std::integral_constant<int, 3>{});
+    case 4:
+        return kernel(std::integral_constant<int, 4>{});
+    default:
+        return kernel(std::integral_constant<int, dynamic_objectives>{});
+    }
+}
+
+using DominanceRelationKernel = int (*)(const double *, const double *, std::size_t, double);
+using ObjectivesEqualKernel = bool (*)(const double *, const double *, std::size_t);
+using NoBetterFromKernel = bool (*)(const double *, const double *, const int *, std::size_t, std::size_t);
+
+inline DominanceRelationKernel dominance_relation_kernel(std::size_t n_obj) {
+    return with_objective_count(n_obj, [](auto m) -> DominanceRelationKernel {
+        return &dominance_relation_fixed<decltype(m)::value>;
+    });
+}
+
+inline ObjectivesEqualKernel objectives_equal_kernel(std::size_t n_obj) {
+    return with_objective_count(n_obj, [](auto m) -> ObjectivesEqualKernel {
+        return &objectives_equal_fixed<decltype(m)::value>;
+    });
+}
+
+inline NoBetterFromKernel no_better_from_kernel(std::size_t n_obj) {
+    return with_objective_count(n_obj, [](auto m) -> NoBetterFromKernel {
+        return &no_better_from_fixed<decltype(m)::value>;
+    });
+}
+
+#endif // EDDIE_DOMINANCE_H
@@ -0,0 +1,417 @@
+#include "evaluation_cache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "initpop.h"
+#include "telemetry.h"
+
+namespace {
+
+constexpr char cache_magic[8] = {'E', 'D', 'D', 'I', 'E', 'E', 'C', '\0'};
+
+// |t| beyond which llround would overflow an int64
+constexpr double max_quantized = 9.0e18;
+
+std::uint64_t mix(std::uint64_t h) {
+    // splitmix64 finalizer
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    return h ^ (h >> 31);
+}
+
+std::size_t next_power_of_two(std::size_t n) {
+    std::size_t power = 1;
+    while (power < n) {
+        power <<= 1;
+    }
+    return power;
+}
+
+void write_all(int fd, const void *data, std::size_t bytes, const std::string &path) {
+    const char *cursor = static_cast<const char *>(data);
+    while (bytes > 0) {
+        const ssize_t written = ::write(fd, cursor, bytes);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Unable to write evaluation cache " + path + ": " + std::strerror(errno));
+        }
+        cursor += written;
+        bytes -= static_cast<std::size_t>(written);
+    }
+}
+
+} // namespace
+
+EvaluationCache::EvaluationCache(std::vector<double> lower, std::vector<double> upper, std::size_t n_obj,
+                                 std::size_t n_constr, std::size_t capacity, double resolution, std::string path)
+    : lower_(std::move(lower)), upper_(std::move(upper)), n_obj_(n_obj), n_constr_(n_constr),
+      resolution_(resolution), path_(std::move(path)) {
+    if (lower_.size() != upper_.size() || lower_.empty()) {
+        throw std::invalid_argument("Evaluation cache requires matching, non-empty variable bounds");
+    }
+    // below ~1e-16 of the range the quantization is finer than a double resolves
+    if (!(resolution_ >= 1e-16 && resolution_ < 1.0)) {
+        throw std::invalid_argument("Evaluation cache resolution must lie in [1e-16, 1)");
+    }
+    scale_.resize(n_var());
+    for (std::size_t j = 0; j < n_var(); ++j) {
+        const double range = upper_[j] - lower_[j];
+        scale_[j] = range > 0.0 ? 1.0 / (range * resolution_) : 0.0;
+    }
+
+    struct stat info {};
+    const bool resume = !path_.empty() && ::stat(path_.c_str(), &info) == 0 && info.st_size > 0;
+    std::unique_ptr<MappedFile> file;
+    std::size_t n_records = 0;
+    if (resume) {
+        file = std::make_unique<MappedFile>(path_);
+        n_records = validate(*file);
+    }
+
+    const std::size_t n_slots = next_power_of_two(std::max<std::size_t>(16, (capacity + n_records) * 4 / 3 + 1));
+    mask_ = n_slots - 1;
+    max_used_ = n_slots / 4 * 3;
+    states_ = std::make_unique<std::atomic<std::uint64_t>[]>(n_slots);
+    for (std::size_t s = 0; s < n_slots; ++s) {
+        states_[s].store(empty, std::memory_order_relaxed);
+    }
+    keys_.assign(n_slots * n_var(), 0);
+    values_.assign(n_slots * (n_obj_ + n_constr_), 0.0);
+
+    if (file) {
+        for (std::size_t r = 0; r < n_records; ++r) {
+            const char *record = file->data() + prefix_size() + r * record_size();
+            // records are not 8-byte aligned once n_var is odd, so copy them out
+            std::vector<std::int64_t> key(n_var());
+            std::vector<double> values(n_obj_ + n_constr_);
+            std::memcpy(key.data(), record, key.size() * sizeof(std::int64_t));
+            std::memcpy(values.data(), record + key.size() * sizeof(std::int64_t), values.size() * sizeof(double));
+            insert_loaded(key.data(), values.data());
+        }
+        loaded_ = size();
+    }
+    if (!path_.empty()) {
+        open_log(resume ? prefix_size() + n_records * record_size() : 0);
+    }
+}
+
+EvaluationCache::~EvaluationCache() {
+    if (log_fd_ >= 0) {
+        ::close(log_fd_);
+    }
+}
+
+std::uint64_t EvaluationCache::quantize(Span<const double> x, std::int64_t *key) const {
+    for (std::size_t j = 0; j < n_var(); ++j) {
+        const double t = std::clamp((x[j] - lower_[j]) * scale_[j], -max_quantized, max_quantized);
+        key[j] = std::isnan(t) ? std::numeric_limits<std::int64_t>::min() : static_cast<std::int64_t>(std::llround(t));
+    }
+    return hash_key(key);
+}
+
+std::uint64_t EvaluationCache::hash_key(const std::int64_t *key) const {
+    std::uint64_t hash = 0x9E3779B97F4A7C15ULL;
+    for (std::size_t j = 0; j < n_var(); ++j) {
+        hash = mix(hash ^ static_cast<std::uint64_t>(key[j]));
+    }
+    return hash;
+}
+
+EvaluationCache::Lookup EvaluationCache::acquire(const std::int64_t *key, std::uint64_t hash, std::size_t &slot) {
+    // the tag keeps the state of a used slot non-zero whatever its status
+    const std::uint64_t tag = ((hash >> status_bits) | 1) << status_bits;
+    const std::size_t n = n_var();
+
+    for (std::size_t probe = 0; probe <= mask_; ++probe) {
+        slot = (hash + probe) & mask_;
+        auto &state = states_[slot];
+        std::uint64_t current = state.load(std::memory_order_acquire);
+
+        for (;;) {
+            if (current == empty) {
+                if (n_used_.fetch_add(1, std::memory_order_relaxed) >= max_used_) {
+                    n_used_.fetch_sub(1, std::memory_order_relaxed);
+                    return Lookup::full;
+                }
+                if (state.compare_exchange_weak(current, tag | writing, std::memory_order_acq_rel)) {
+                    std::copy(key, key + n, keys_.data() + slot * n);
+                    state.store(tag | pending_value, std::memory_order_release);
+                    return Lookup::claimed;
+                }
+                n_used_.fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+            if ((current & status_mask) == writing) {
+                // the key of this slot is being written, which takes a few nanoseconds
+                std::this_thread::yield();
+                current = state.load(std::memory_order_acquire);
+                continue;
+            }
+            if ((current & ~status_mask) != tag || !std::equal(key, key + n, keys_.data() + slot * n)) {
+                break;
+            }
+
+            switch (current & status_mask) {
+            case ready:
+                return Lookup::hit;
+            case pending_value:
+                return Lookup::pending;
+            default:
+                // abandoned after a failed evaluation: take over
+                if (state.compare_exchange_weak(current, tag | pending_value, std::memory_order_acq_rel)) {
+                    return Lookup::claimed;
+                }
+                continue;
+            }
+        }
+    }
+    return Lookup::full;
+}
+
+void EvaluationCache::read(std::size_t slot, Span<double> f, Span<double> g) const {
+    const double *values = values_.data() + slot * (n_obj_ + n_constr_);
+    std::copy(values, values + n_obj_, f.data());
+    std::copy(values + n_obj_, values + n_obj_ + n_constr_, g.data());
+}
+
+void EvaluationCache::publish(std::size_t slot, Span<const double> f, Span<const double> g) {
+    double *values = values_.data() + slot * (n_obj_ + n_constr_);
+    std::copy(f.begin(), f.end(), values);
+    std::copy(g.begin(), g.end(), values + n_obj_);
+
+    auto &state = states_[slot];
+    state.store((state.load(std::memory_order_relaxed) & ~status_mask) | ready, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+    }
+    ready_cv_.notify_all();
+
+    if (log_fd_ >= 0) {
+        append(slot);
+    }
+}
+
+void EvaluationCache::abandon(std::size_t slot) {
+    auto &state = states_[slot];
+    state.store(state.load(std::memory_order_relaxed) & ~status_mask, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+    }
+    ready_cv_.notify_all();
+}
+
+bool EvaluationCache::wait(std::size_t slot) {
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    ready_cv_.wait(lock, [&] { return status(slot) != pending_value; });
+    return status(slot) == ready;
+}
+
+std::size_t EvaluationCache::validate(const MappedFile &file) const {
+    const auto invalid = [this](const std::string &reason) {
+        return std::runtime_error("Invalid evaluation cache " + path_ + ": " + reason);
+    };
+
+    if (file.size() < prefix_size()) {
+        throw invalid("file is too small");
+    }
+    EvaluationCacheHeader header{};
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0) {
+        throw invalid("bad magic number");
+    }
+    if (header.version != EvaluationCacheHeader::current_version || header.header_size != sizeof(header)) {
+        throw invalid("unsupported version " + std::to_string(header.version));
+    }
+    if (header.n_var != n_var() || header.n_obj != n_obj_ || header.n_constr != n_constr_ ||
+        header.resolution != resolution_) {
+        throw invalid("written for other problem dimensions or another cache_resolution");
+    }
+
+    std::vector<double> bounds(2 * n_var());
+    std::memcpy(bounds.data(), file.data() + sizeof(header), bounds.size() * sizeof(double));
+    if (!std::equal(lower_.begin(), lower_.end(), bounds.begin()) ||
+        !std::equal(upper_.begin(), upper_.end(), bounds.begin() + n_var())) {
+        throw invalid("written for other variable bounds");
+    }
+    return (file.size() - prefix_size()) / record_size();
+}
+
+void EvaluationCache::insert_loaded(const std::int64_t *key, const double *values) {
+    std::size_t slot = 0;
+    if (acquire(key, hash_key(key), slot) == Lookup::claimed) {
+        double *stored = values_.data() + slot * (n_obj_ + n_constr_);
+        std::copy(values, values + n_obj_ + n_constr_, stored);
+        auto &state = states_[slot];
+        state.store((state.load(std::memory_order_relaxed) & ~status_mask) | ready, std::memory_order_release);
+    }
+}
+
+void EvaluationCache::open_log(std::size_t valid_bytes) {
+    log_fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (log_fd_ < 0) {
+        throw std::runtime_error("Unable to open evaluation cache " + path_ + ": " + std::strerror(errno));
+    }
+    // drops a record cut short by an interrupted run, so appends stay aligned to records
+    if (::ftruncate(log_fd_, static_cast<off_t>(valid_bytes)) != 0 ||
+        ::lseek(log_fd_, 0, SEEK_END) < 0) {
+        throw std::runtime_error("Unable to open evaluation cache " + path_ + ": " + std::strerror(errno));
+    }
+
+    if (valid_bytes == 0) {
+        EvaluationCacheHeader header{};
+        std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+        header.version = EvaluationCacheHeader::current_version;
+        header.header_size = sizeof(header);
+        header.n_var = n_var();
+        header.n_obj = n_obj_;
+        header.n_constr = n_constr_;
+        header.resolution = resolution_;
+        write_all(log_fd_, &header, sizeof(header), path_);
+        write_all(log_fd_, lower_.data(), n_var() * sizeof(double), path_);
+        write_all(log_fd_, upper_.data(), n_var() * sizeof(double), path_);
+    }
+}
+
+void EvaluationCache::append(std::size_t slot) {
+    EDDIE_TELEMETRY_SCOPE(io);
+    std::vector<char> record(record_size());
+    std::memcpy(record.data(), keys_.data() + slot * n_var(), n_var() * sizeof(std::int64_t));
+    std::memcpy(record.data() + n_var() * sizeof(std::int64_t), values_.data() + slot * (n_obj_ + n_constr_),
+                (n_obj_ + n_constr_) * sizeof(double));
+
+    // one write per record, so records of concurrent publishers never interleave
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    write_all(log_fd_, record.data(), record.size(), path_);
+}
+
+CachedProblem::CachedProblem(const Problem &problem, const OptimizationParameters &params, std::size_t n_runs)
+    : problem_(problem) {
+    std::vector<double> lower;
+    std::vector<double> upper;
+    decision_bounds(params, lower, upper);
+    if (lower.size() != problem_.n_var()) {
+        throw std::invalid_argument("Number of design variables does not match the problem");
+    }
+
+    const std::size_t run_budget = params.population_size + params.max_generations * params.offspring_population_size;
+    const std::size_t budget = run_budget * std::max<std::size_t>(n_runs, 1);
+    cache_ = std::make_unique<EvaluationCache>(std::move(lower), std::move(upper), problem_.n_obj(),
+                                               problem_.n_constr(), budget, params.cache_resolution,
+                                               params.cache_path);
+}
+
+void CachedProblem::evaluate_individual(Span<const double> x, Span<double> f, Span<double> g) const {
+    std::vector<std::int64_t> key(cache_->n_var());
+    const std::uint64_t hash = cache_->quantize(x, key.data());
+
+    std::size_t slot = 0;
+    switch (cache_->acquire(key.data(), hash, slot)) {
+    case EvaluationCache::Lookup::hit:
+        cache_->read(slot, f, g);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    case EvaluationCache::Lookup::pending:
+        if (cache_->wait(slot)) {
+            cache_->read(slot, f, g);
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        break;
+    case EvaluationCache::Lookup::claimed:
+        try {
+            problem_.evaluate_individual(x, f, g);
+        } catch (...) {
+            cache_->abandon(slot);
+            throw;
+        }
+        evaluations_.fetch_add(1, std::memory_order_relaxed);
+        cache_->publish(slot, f, g);
+        return;
+    case EvaluationCache::Lookup::full:
+        uncached_.fetch_add(1, std::memory_order_relaxed);
+        break;
+    }
+
+    problem_.evaluate_individual(x, f, g);
+    evaluations_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CachedProblem::evaluate_rows(const PopulationMatrix &x, std::size_t begin, std::size_t end, ObjectiveMatrix &f,
+                                  ConstraintMatrix &g) const {
+    using Lookup = EvaluationCache::Lookup;
+    const std::size_t n = end - begin;
+    std::vector<std::int64_t> key(cache_->n_var());
+    std::vector<std::size_t> slots(n);
+    std::vector<Lookup> lookups(n);
+    std::vector<unsigned char> published(n, 0);
+
+    for (std::size_t r = 0; r < n; ++r) {
+        const std::uint64_t hash = cache_->quantize(x.row(begin + r), key.data());
+        lookups[r] = cache_->acquire(key.data(), hash, slots[r]);
+        if (lookups[r] == Lookup::hit) {
+            cache_->read(slots[r], f.row(begin + r), g.row(begin + r));
+            hits_.fetch_add(1, std::memory_order_relaxed);
+        } else if (lookups[r] == Lookup::full) {
+            uncached_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // runs of misses go to the wrapped batch kernel; own claims are published before waiting
+    // on other threads' ones, so two threads never wait for each other
+    const auto evaluated = [&](std::size_t r) { return lookups[r] == Lookup::claimed || lookups[r] == Lookup::full; };
+    try {
+        for (std::size_t r = 0; r < n;) {
+            if (!evaluated(r)) {
+                ++r;
+                continue;
+            }
+            std::size_t stop = r;
+            while (stop < n && evaluated(stop)) {
+                ++stop;
+            }
+            problem_.evaluate_rows(x, begin + r, begin + stop, f, g);
+            evaluations_.fetch_add(stop - r, std::memory_order_relaxed);
+            for (; r < stop; ++r) {
+                if (lookups[r] == Lookup::claimed) {
+                    published[r] = 1;
+                    cache_->publish(slots[r], f.row(begin + r), g.row(begin + r));
+                }
+            }
+        }
+    } catch (...) {
+        for (std::size_t r = 0; r < n; ++r) {
+            if (lookups[r] == Lookup::claimed && !published[r]) {
+                cache_->abandon(slots[r]);
+            }
+        }
+        throw;
+    }
+
+    for (std::size_t r = 0; r < n; ++r) {
+        if (lookups[r] != Lookup::pending) {
+            continue;
+        }
+        if (cache_->wait(slots[r])) {
+            cache_->read(slots[r], f.row(begin + r), g.row(begin + r));
+            hits_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            problem_.evaluate_rows(x, begin + r, begin + r + 1, f, g);
+            evaluations_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,150 @@
+#ifndef EDDIE_EVALUATION_CACHE_H
+#define EDDIE_EVALUATION_CACHE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "evaluator.h"
+#include "mapped_file.h"
+#include "parameter.h"
+#include "population.h"
+
+// On-disk cache layout (native endianness, version 1):
+//
+//   EvaluationCacheHeader | lower bounds (n_var doubles) | upper bounds (n_var doubles)
+//   | records: quantized key (n_var int64) followed by objectives and constraints (doubles)
+//
+// Records are appended as evaluations finish, so an interrupted run keeps every result it paid
+// for; a record cut short by the interruption is ignored on load.
+struct EvaluationCacheHeader {
+    static constexpr std::uint32_t current_version = 1;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint64_t n_var;
+    std::uint64_t n_obj;
+    std::uint64_t n_constr;
+    double resolution;
+};
+
+// Concurrent open-addressing map from quantized decision vectors to objective and constraint
+// values. A decision vector is normalized by the variable bounds and rounded to multiples of
+// `resolution` (a fraction of each variable's range), so vectors closer than that share a key.
+//
+// Slots are claimed with a compare-and-swap on their state word and probed linearly. A thread
+// that misses claims the slot before evaluating, so other threads asking for the same key wait
+// for that one result instead of evaluating it again. The table is sized once for `capacity`
+// entries (plus those loaded from `path`) and never rehashed; past 3/4 load new keys are simply
+// not cached. With a `path`, earlier results are loaded and new ones appended to the file.
+class EvaluationCache {
+public:
+    enum class Lookup {
+        hit,      // value available, see `read`
+        claimed,  // the caller evaluates and then calls `publish` or `abandon`
+        pending,  // another thread is evaluating the key, see `wait`
+        full      // not cached; the caller evaluates without publishing
+    };
+
+    EvaluationCache(std::vector<double> lower, std::vector<double> upper, std::size_t n_obj, std::size_t n_constr,
+                    std::size_t capacity, double resolution = 1e-9, std::string path = {});
+    ~EvaluationCache();
+
+    EvaluationCache(const EvaluationCache &) = delete;
+    EvaluationCache &operator=(const EvaluationCache &) = delete;
+
+    std::size_t n_var() const { return lower_.size(); }
+
+    // Writes the n_var quantized coordinates of x to `key` and returns their hash.
+    std::uint64_t quantize(Span<const double> x, std::int64_t *key) const;
+
+    Lookup acquire(const std::int64_t *key, std::uint64_t hash, std::size_t &slot);
+    void read(std::size_t slot, Span<double> f, Span<double> g) const;
+    void publish(std::size_t slot, Span<const double> f, Span<const double> g);
+    void abandon(std::size_t slot);
+
+    // Blocks while `slot` is pending; true if it then holds a value, false if it was abandoned.
+    bool wait(std::size_t slot);
+
+    std::size_t size() const { return n_used_.load(std::memory_order_relaxed); }
+    std::size_t loaded() const { return loaded_; }
+
+private:
+    static constexpr std::uint64_t status_bits = 2;
+    static constexpr std::uint64_t status_mask = 3;
+    enum Status : std::uint64_t { empty = 0, writing = 1, pending_value = 2, ready = 3 };
+
+    std::uint64_t status(std::size_t slot) const {
+        return states_[slot].load(std::memory_order_acquire) & status_mask;
+    }
+
+    std::size_t record_size() const { return n_var() * sizeof(std::int64_t) + (n_obj_ + n_constr_) * sizeof(double); }
+    std::size_t prefix_size() const { return sizeof(EvaluationCacheHeader) + 2 * n_var() * sizeof(double); }
+
+    std::uint64_t hash_key(const std::int64_t *key) const;
+    std::size_t validate(const MappedFile &file) const;
+    void insert_loaded(const std::int64_t *key, const double *values);
+    void open_log(std::size_t valid_bytes);
+    void append(std::size_t slot);
+
+    std::vector<double> lower_;
+    std::vector<double> upper_;
+    std::vector<double> scale_{};  // 1 / (range * resolution), 0 for fixed variables
+    std::size_t n_obj_;
+    std::size_t n_constr_;
+    double resolution_;
+
+    std::size_t mask_ = 0;
+    std::size_t max_used_ = 0;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> states_{};
+    std::vector<std::int64_t> keys_{};
+    std::vector<double> values_{};
+    std::atomic<std::size_t> n_used_{0};
+    std::size_t loaded_ = 0;
+
+    std::mutex wait_mutex_;
+    std::condition_variable ready_cv_;
+
+    std::mutex log_mutex_;
+    int log_fd_ = -1;
+    std::string path_;
+};
+
+// Problem decorator that answers repeated (or, up to `cache_resolution`, nearly repeated)
+// decision vectors from an `EvaluationCache` and forwards only the misses to the wrapped problem.
+// Consecutive misses of a batch are passed on as one `evaluate_rows` range, so batch kernels keep
+// working. The cache holds the whole evaluation budget of `n_runs` runs of `params` (one per
+// island that shares it) and persists to `cache_path`.
+class CachedProblem : public Problem {
+public:
+    CachedProblem(const Problem &problem, const OptimizationParameters &params, std::size_t n_runs = 1);
+
+    std::size_t n_var() const override { return problem_.n_var(); }
+    std::size_t n_obj() const override { return problem_.n_obj(); }
+    std::size_t n_constr() const override { return problem_.n_constr(); }
+
+    void evaluate_individual(Span<const double> x, Span<double> f, Span<double> g) const override;
+    void evaluate_rows(const PopulationMatrix &x, std::size_t begin, std::size_t end, ObjectiveMatrix &f,
+                       ConstraintMatrix &g) const override;
+
+    const EvaluationCache &cache() const { return *cache_; }
+    std::size_t hits() const { return hits_.load(std::memory_order_relaxed); }
+    std::size_t evaluations() const { return evaluations_.load(std::memory_order_relaxed); }
+    // evaluations whose result could not be stored because the cache was full
+    std::size_t uncached() const { return uncached_.load(std::memory_order_relaxed); }
+
+private:
+    const Problem &problem_;
+    std::unique_ptr<EvaluationCache> cache_;
+    mutable std::atomic<std::size_t> hits_{0};
+    mutable std::atomic<std::size_t> evaluations_{0};
+    mutable std::atomic<std::size_t> uncached_{0};
+};
+
+#endif // EDDIE_EVALUATION_CACHE_H
@@ -0,0 +1,159 @@
+#include "evaluator.h"
+
+#include <algorithm>
+
+#include "telemetry.h"
+
+void Problem::evaluate_rows(const PopulationMatrix &x, std::size_t begin, std::size_t end, ObjectiveMatrix &f,
+                            ConstraintMatrix &g) const {
+    for (std::size_t i = begin; i < end; ++i) {
+        evaluate_individual(x.row(i), f.row(i), g.row(i));
+    }
+}
+
+void Problem::evaluate(const PopulationMatrix &x, ObjectiveMatrix &f, ConstraintMatrix &g) const {
+    f.resize(x.rows(), n_obj());
+    g.resize(x.rows(), n_constr());
+    evaluate_rows(x, 0, x.rows(), f, g);
+}
+
+void SerialEvaluator::evaluate(const Problem &problem, const PopulationMatrix &x, ObjectiveMatrix &f,
+                               ConstraintMatrix &g) {
+    EDDIE_TELEMETRY_ADD(evaluations, x.rows());
+    problem.evaluate(x, f, g);
+}
+
+ThreadPoolEvaluator::ThreadPoolEvaluator(std::size_t n_threads, std::size_t grain) : grain_(std::max<std::size_t>(grain, 1)) {
+    if (n_threads == 0) {
+        n_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    queues_.reserve(n_threads);
+    for (std::size_t i = 0; i < n_threads; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    workers_.reserve(n_threads - 1);
+    for (std::size_t id = 1; id < n_threads; ++id) {
+        workers_.emplace_back(&ThreadPoolEvaluator::worker_loop, this, id);
+    }
+}
+
+ThreadPoolEvaluator::~ThreadPoolEvaluator() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPoolEvaluator::evaluate(const Problem &problem, const PopulationMatrix &x, ObjectiveMatrix &f,
+                                   ConstraintMatrix &g) {
+    const std::size_t n = x.rows();
+    f.resize(n, problem.n_obj());
+    g.resize(n, problem.n_constr());
+    if (n == 0) {
+        return;
+    }
+    EDDIE_TELEMETRY_ADD(evaluations, n);
+    EDDIE_TELEMETRY_QUEUE_DEPTH((n + grain_ - 1) / grain_);
+
+    // contiguous shares keep neighbouring rows on one core until stealing kicks in
+    const std::size_t n_workers = queues_.size();
+    const std::size_t n_chunks = (n + grain_ - 1) / grain_;
+    for (std::size_t w = 0; w < n_workers; ++w) {
+        auto &queue = *queues_[w];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.chunks.clear();
+        for (std::size_t c = w * n_chunks / n_workers; c < (w + 1) * n_chunks / n_workers; ++c) {
+            queue.chunks.push_back(Chunk{c * grain_, std::min(n, (c + 1) * grain_)});
+        }
+        queue.head = 0;
+        queue.tail = queue.chunks.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        problem_ = &problem;
+        x_ = &x;
+        f_ = &f;
+        g_ = &g;
+        error_ = nullptr;
+        active_workers_ = workers_.size();
+        ++batch_;
+    }
+    start_cv_.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return active_workers_ == 0; });
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+void ThreadPoolEvaluator::worker_loop(std::size_t id) {
+    std::size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [this, seen] { return stopping_ || batch_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = batch_;
+        }
+
+        drain(id);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--active_workers_ == 0) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+void ThreadPoolEvaluator::drain(std::size_t id) {
+    Chunk chunk;
+    while (pop_local(id, chunk) || steal(id, chunk)) {
+        try {
+            run_chunk(chunk);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+        }
+    }
+}
+
+bool ThreadPoolEvaluator::pop_local(std::size_t id, Chunk &chunk) {
+    auto &queue = *queues_[id];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.head == queue.tail) {
+        return false;
+    }
+    chunk = queue.chunks[queue.head++];
+    return true;
+}
+
+bool ThreadPoolEvaluator::steal(std::size_t thief, Chunk &chunk) {
+    const std::size_t n_workers = queues_.size();
+    for (std::size_t offset = 1; offset < n_workers; ++offset) {
+        auto &queue = *queues_[(thief + offset) % n_workers];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.head != queue.tail) {
+            chunk = queue.chunks[--queue.tail];
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPoolEvaluator::run_chunk(const Chunk &chunk) {
+    problem_->evaluate_rows(*x_, chunk.begin, chunk.end, *f_, *g_);
+}
@@ -0,0 +1,105 @@
+#ifndef EDDIE_EVALUATOR_H
+#define EDDIE_EVALUATOR_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "population.h"
+
+// An optimization problem with `n_var` decision variables, `n_obj` objectives and `n_constr`
+// inequality constraints (g <= 0 is feasible). `evaluate_individual` must be safe to call
+// concurrently for different rows.
+class Problem {
+public:
+    virtual ~Problem() = default;
+
+    virtual std::size_t n_var() const = 0;
+    virtual std::size_t n_obj() const = 0;
+    virtual std::size_t n_constr() const { return 0; }
+
+    virtual void evaluate_individual(Span<const double> x, Span<double> f, Span<double> g) const = 0;
+
+    // Evaluates rows [begin, end) of `x`. The default calls `evaluate_individual` per row;
+    // problems with a batch kernel override it. Evaluators hand whole chunks to this hook.
+    virtual void evaluate_rows(const PopulationMatrix &x, std::size_t begin, std::size_t end, ObjectiveMatrix &f,
+                               ConstraintMatrix &g) const;
+
+    // Serial batch evaluation into preallocated (reused) objective and constraint matrices.
+    void evaluate(const PopulationMatrix &x, ObjectiveMatrix &f, ConstraintMatrix &g) const;
+};
+
+// Strategy for evaluating a whole population against a problem.
+class Evaluator {
+public:
+    virtual ~Evaluator() = default;
+
+    virtual void evaluate(const Problem &problem, const PopulationMatrix &x, ObjectiveMatrix &f,
+                          ConstraintMatrix &g) = 0;
+};
+
+class SerialEvaluator : public Evaluator {
+public:
+    void evaluate(const Problem &problem, const PopulationMatrix &x, ObjectiveMatrix &f,
+                  ConstraintMatrix &g) override;
+};
+
+// Splits a batch into chunks of `grain` rows and runs them on a persistent pool of threads.
+// Every worker starts on its own contiguous share of chunks and, once that runs dry, steals
+// chunks from the back of the other workers' queues, so a few slow individuals do not leave
+// the remaining cores idle. The calling thread participates as worker 0.
+class ThreadPoolEvaluator : public Evaluator {
+public:
+    explicit ThreadPoolEvaluator(std::size_t n_threads = 0, std::size_t grain = 1);
+    ~ThreadPoolEvaluator() override;
+
+    ThreadPoolEvaluator(const ThreadPoolEvaluator &) = delete;
+    ThreadPoolEvaluator &operator=(const ThreadPoolEvaluator &) = delete;
+
+    void evaluate(const Problem &problem, const PopulationMatrix &x, ObjectiveMatrix &f,
+                  ConstraintMatrix &g) override;
+
+    std::size_t thread_count() const { return queues_.size(); }
+
+private:
+    struct Chunk {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<Chunk> chunks;
+        std::size_t head = 0;
+        std::size_t tail = 0;
+    };
+
+    void worker_loop(std::size_t id);
+    void drain(std::size_t id);
+    bool pop_local(std::size_t id, Chunk &chunk);
+    bool steal(std::size_t thief, Chunk &chunk);
+    void run_chunk(const Chunk &chunk);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_{};
+    std::vector<std::thread> workers_{};
+    std::size_t grain_ = 1;
+
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    std::size_t batch_ = 0;
+    std::size_t active_workers_ = 0;
+    bool stopping_ = false;
+    std::exception_ptr error_{};
+
+    const Problem *problem_ = nullptr;
+    const PopulationMatrix *x_ = nullptr;
+    ObjectiveMatrix *f_ = nullptr;
+    ConstraintMatrix *g_ = nullptr;
+};
+
+#endif // EDDIE_EVALUATOR_H
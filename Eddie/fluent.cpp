@@ -0,0 +1,397 @@
+#include "fluent.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "initpop.h"
+#include "mapped_file.h"
+#include "telemetry.h"
+
+extern char **environ;
+
+namespace {
+
+// Placeholders naming a case path, in the order of FluentProblem::CasePaths.
+constexpr std::string_view path_placeholders[] = {"case", "case_dir", "journal", "report"};
+
+constexpr const char *journal_name = "case.jou";
+constexpr const char *log_name = "solver.log";
+
+bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+// One whitespace-delimited field, all of it a number.
+bool parse_field(const char *begin, const char *end, double &value) {
+    const char *start = begin != end && *begin == '+' ? begin + 1 : begin;
+    const auto result = std::from_chars(start, end, value);
+    return result.ec == std::errc() && result.ptr == end && start != end;
+}
+
+void write_all(int fd, const std::string &text, const std::string &path) {
+    const char *data = text.data();
+    std::size_t left = text.size();
+    while (left > 0) {
+        const ssize_t written = ::write(fd, data, left);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            const int error = errno;
+            ::close(fd);
+            throw std::runtime_error("Unable to write " + path + ": " + std::strerror(error));
+        }
+        data += written;
+        left -= static_cast<std::size_t>(written);
+    }
+}
+
+std::vector<std::string> placeholder_names(const OptimizationParameters &params, std::size_t n_var) {
+    if (!params.variable_names.empty()) {
+        return params.variable_names;
+    }
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < n_var; ++i) {
+        names.push_back("x" + std::to_string(i + 1));
+    }
+    return names;
+}
+
+std::string read_template(const std::string &path) {
+    if (path.empty()) {
+        throw std::invalid_argument("evaluator = fluent requires fluent_journal_template");
+    }
+    const MappedFile file(path);
+    return std::string(file.view());
+}
+
+} // namespace
+
+FluentTemplate::FluentTemplate(std::string text, const std::vector<std::string> &variable_names)
+    : text_(std::move(text)) {
+    std::size_t literal = 0;
+    std::size_t cursor = 0;
+    while ((cursor = text_.find('{', cursor)) != std::string::npos) {
+        const std::size_t close = text_.find('}', cursor);
+        if (close == std::string::npos) {
+            throw std::invalid_argument("Unterminated placeholder in template: " + text_.substr(cursor, 40));
+        }
+        const std::string_view name(text_.data() + cursor + 1, close - cursor - 1);
+
+        Segment placeholder;
+        const auto *path = std::find(std::begin(path_placeholders), std::end(path_placeholders), name);
+        const auto variable = std::find(variable_names.begin(), variable_names.end(), name);
+        if (path != std::end(path_placeholders)) {
+            placeholder.kind = Kind::path;
+            placeholder.begin = static_cast<std::size_t>(path - std::begin(path_placeholders));
+        } else if (variable != variable_names.end()) {
+            placeholder.kind = Kind::variable;
+            placeholder.begin = static_cast<std::size_t>(variable - variable_names.begin());
+        } else {
+            throw std::invalid_argument("Unknown placeholder {" + std::string(name) + "} in template");
+        }
+
+        if (cursor > literal) {
+            segments_.push_back(Segment{Kind::literal, literal, cursor - literal});
+        }
+        segments_.push_back(placeholder);
+        literal = cursor = close + 1;
+    }
+    if (text_.size() > literal) {
+        segments_.push_back(Segment{Kind::literal, literal, text_.size() - literal});
+    }
+}
+
+void FluentTemplate::render(const std::string *paths, Span<const double> x, std::string &out) const {
+    for (const Segment &segment : segments_) {
+        switch (segment.kind) {
+        case Kind::literal:
+            out.append(text_, segment.begin, segment.size);
+            break;
+        case Kind::path:
+            out += paths[segment.begin];
+            break;
+        case Kind::variable: {
+            // shortest text that reads back as the same double
+            char digits[32];
+            const auto result = std::to_chars(digits, digits + sizeof(digits), x[segment.begin]);
+            out.append(digits, result.ptr);
+            break;
+        }
+        }
+    }
+}
+
+bool parse_fluent_report(const char *data, std::size_t size, const std::vector<std::size_t> &columns,
+                         Span<double> f) {
+    // last non-blank line
+    const char *end = data + size;
+    while (end != data && is_blank(end[-1])) {
+        --end;
+    }
+    const char *begin = end;
+    while (begin != data && begin[-1] != '\n') {
+        --begin;
+    }
+    if (begin == end) {
+        return false;
+    }
+
+    std::size_t found = 0;
+    std::size_t column = 0;
+    for (const char *cursor = begin; cursor != end; ++column) {
+        while (cursor != end && is_blank(*cursor)) {
+            ++cursor;
+        }
+        const char *field = cursor;
+        while (cursor != end && !is_blank(*cursor)) {
+            ++cursor;
+        }
+        if (field == cursor) {
+            break;
+        }
+        double value = 0.0;
+        const bool numeric = parse_field(field, cursor, value);
+        if (column == 0 && !numeric) {
+            return false; // a header line: the report has no data row yet
+        }
+        for (std::size_t m = 0; m < columns.size(); ++m) {
+            if (columns[m] == column) {
+                if (!numeric) {
+                    return false;
+                }
+                f[m] = value;
+                ++found;
+            }
+        }
+    }
+    return found == columns.size();
+}
+
+FluentProblem::FluentProblem(const OptimizationParameters &params)
+    : n_var_(decision_dimension(params)),
+      columns_(params.fluent_report_columns),
+      journal_(read_template(params.fluent_journal_template), placeholder_names(params, n_var_)),
+      work_dir_(std::filesystem::absolute(params.fluent_work_dir).lexically_normal().string()),
+      report_(params.fluent_report),
+      slots_(params.max_in_flight) {
+    if (columns_.empty()) {
+        const std::size_t n_obj = params.objective_names.empty() ? 2 : params.objective_names.size();
+        for (std::size_t m = 0; m < n_obj; ++m) {
+            columns_.push_back(m + 1);
+        }
+    }
+    if (params.fluent_command.empty()) {
+        throw std::invalid_argument("fluent_command must not be empty");
+    }
+    if (report_.empty()) {
+        throw std::invalid_argument("fluent_report must not be empty");
+    }
+    if (slots_ == 0) {
+        throw std::invalid_argument("max_in_flight must be positive");
+    }
+    for (const std::string &argument : params.fluent_command) {
+        command_.emplace_back(argument, std::vector<std::string>{}); // case paths only
+    }
+    std::filesystem::create_directories(work_dir_);
+}
+
+FluentProblem::CasePaths FluentProblem::paths(std::size_t id) const {
+    CasePaths paths;
+    paths.values[0] = std::to_string(id);
+    paths.values[1] = work_dir_ + "/case_" + paths.values[0];
+    paths.values[2] = paths.values[1] + "/" + journal_name;
+    paths.values[3] = paths.values[1] + "/" + report_;
+    return paths;
+}
+
+void FluentProblem::write_case(const CasePaths &paths, Span<const double> x, std::string &buffer) const {
+    EDDIE_TELEMETRY_SCOPE(io);
+    const std::string &dir = paths.values[1];
+    const std::string &journal = paths.values[2];
+    if (::mkdir(dir.c_str(), 0777) != 0 && errno != EEXIST) {
+        throw std::runtime_error("Unable to create " + dir + ": " + std::strerror(errno));
+    }
+    // a report left by an earlier campaign in the same directory must not be read as this result
+    ::unlink(paths.values[3].c_str());
+
+    buffer.clear();
+    journal_.render(paths.values, x, buffer);
+    const int fd = ::open(journal.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        throw std::runtime_error("Unable to create " + journal + ": " + std::strerror(errno));
+    }
+    write_all(fd, buffer, journal);
+    ::close(fd);
+}
+
+bool FluentProblem::run_solver(const CasePaths &paths) const {
+    std::vector<std::string> arguments(command_.size());
+    std::vector<char *> argv;
+    for (std::size_t i = 0; i < command_.size(); ++i) {
+        command_[i].render(paths.values, Span<const double>(), arguments[i]);
+        argv.push_back(arguments[i].data());
+    }
+    argv.push_back(nullptr);
+
+    const std::string &dir = paths.values[1];
+    const std::string log = dir + "/" + log_name;
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+    posix_spawn_file_actions_addchdir_np(&actions, dir.c_str());
+
+    pid_t pid = 0;
+    const int error = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (error != 0) {
+        // a missing or unrunnable solver is a configuration error, not a failed case
+        throw std::runtime_error("Unable to start " + arguments[0] + ": " + std::strerror(error));
+    }
+
+    int status = 0;
+    while (::waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            throw std::runtime_error("Unable to wait for " + arguments[0] + ": " + std::strerror(errno));
+        }
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+void FluentProblem::run_case(const CasePaths &paths, Span<double> f) const {
+    struct Slot {
+        const FluentProblem &problem;
+        explicit Slot(const FluentProblem &p) : problem(p) {
+            std::unique_lock<std::mutex> lock(problem.slot_mutex_);
+            problem.slot_cv_.wait(lock, [&] { return problem.running_ < problem.slots_; });
+            ++problem.running_;
+        }
+        ~Slot() {
+            {
+                std::lock_guard<std::mutex> lock(problem.slot_mutex_);
+                --problem.running_;
+            }
+            problem.slot_cv_.notify_one();
+        }
+    };
+
+    bool parsed = false;
+    {
+        const Slot slot(*this);
+        parsed = run_solver(paths);
+    }
+    if (parsed) {
+        EDDIE_TELEMETRY_SCOPE(io);
+        try {
+            const MappedFile report(paths.values[3]);
+            parsed = parse_fluent_report(report.data(), report.size(), columns_, f);
+        } catch (const std::runtime_error &) {
+            parsed = false; // the solver exited without writing its report
+        }
+    }
+    if (!parsed) {
+        std::fill(f.begin(), f.end(), std::numeric_limits<double>::infinity());
+        failed_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void FluentProblem::evaluate_individual(Span<const double> x, Span<double> f, Span<double>) const {
+    const CasePaths case_paths = paths(next_case_.fetch_add(1, std::memory_order_relaxed));
+    std::string buffer;
+    write_case(case_paths, x, buffer);
+    run_case(case_paths, f);
+}
+
+void FluentProblem::evaluate_rows(const PopulationMatrix &x, std::size_t begin, std::size_t end, ObjectiveMatrix &f,
+                                  ConstraintMatrix &) const {
+    const std::size_t n = end - begin;
+    if (n == 0) {
+        return;
+    }
+    const std::size_t first = next_case_.fetch_add(n, std::memory_order_relaxed);
+    std::vector<CasePaths> cases(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        cases[i] = paths(first + i);
+    }
+
+    // cases [0, written) have their journals on disk; the writer stays ahead of the solvers
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::size_t written = 0;
+    bool stopped = false;
+    std::exception_ptr error;
+
+    const auto fail = [&](std::exception_ptr failure) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+            error = std::move(failure);
+        }
+        stopped = true;
+        ready.notify_all();
+    };
+
+    std::thread writer([&] {
+        std::string buffer;
+        for (std::size_t i = 0; i < n; ++i) {
+            try {
+                write_case(cases[i], x.row(begin + i), buffer);
+            } catch (...) {
+                fail(std::current_exception());
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            written = i + 1;
+            ready.notify_all();
+            if (stopped) {
+                return;
+            }
+        }
+    });
+
+    std::atomic<std::size_t> next{0};
+    const auto work = [&] {
+        for (std::size_t i = next.fetch_add(1); i < n; i = next.fetch_add(1)) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [&] { return written > i || stopped; });
+                if (stopped) {
+                    return;
+                }
+            }
+            try {
+                run_case(cases[i], f.row(begin + i));
+            } catch (...) {
+                fail(std::current_exception());
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (std::size_t t = 1; t < std::min(slots_, n); ++t) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    writer.join();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef EDDIE_FLUENT_H
+#define EDDIE_FLUENT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "evaluator.h"
+#include "parameter.h"
+#include "population.h"
+
+// Fluent journal (or any text input) with {placeholders}, split once into literal and
+// placeholder segments so that writing a case is a concatenation into a reused buffer.
+//
+//   {case}       case number          {case_dir}  case directory
+//   {journal}    journal path         {report}    report file path
+//   {<name>}     value of the decision variable called <name> in variable_names
+//
+// Unknown placeholders are rejected when the template is parsed.
+class FluentTemplate {
+public:
+    FluentTemplate(std::string text, const std::vector<std::string> &variable_names);
+
+    // Appends the text of one case to `out`; `paths` are the case number, case directory,
+    // journal and report, in that order.
+    void render(const std::string *paths, Span<const double> x, std::string &out) const;
+
+private:
+    enum class Kind { literal, path, variable };
+    struct Segment {
+        Kind kind = Kind::literal;
+        std::size_t begin = 0;  // literal: offset into text_; path or variable: index
+        std::size_t size = 0;
+    };
+
+    std::string text_;
+    std::vector<Segment> segments_{};
+};
+
+// Last data row of a Fluent report file (the `.out` written by report-file definitions):
+// header lines are skipped and columns[m] (0 = the iteration or time-step column) of the last
+// row whose first field is a number is written to f[m]. Works on the mapped file without
+// allocating; false if the file ends without such a row or a column is missing.
+bool parse_fluent_report(const char *data, std::size_t size, const std::vector<std::size_t> &columns,
+                         Span<double> f);
+
+// Problem evaluated by external solver runs, one case directory per individual under
+// `fluent_work_dir`: the journal rendered from `fluent_journal_template`, the solver started as
+// `fluent_command` (path placeholders only) in the case directory with its output in solver.log,
+// and the objectives read from `fluent_report` (relative to the case directory) when the process
+// exits.
+//
+// `evaluate_rows` pipelines a whole batch: a writer thread renders all journals ahead, up to
+// `max_in_flight` solver processes run at once (the limit holds across concurrent calls), and
+// each report is mapped and parsed as soon as its process exits while the other cases keep
+// running. A case whose solver fails or leaves no readable report gets +infinity objectives
+// and is counted in `failed_cases()`, so one diverged run does not end a campaign.
+class FluentProblem : public Problem {
+public:
+    explicit FluentProblem(const OptimizationParameters &params);
+
+    std::size_t n_var() const override { return n_var_; }
+    std::size_t n_obj() const override { return columns_.size(); }
+
+    // One case, start to finish; the steady-state job queue calls this from its slots.
+    void evaluate_individual(Span<const double> x, Span<double> f, Span<double> g) const override;
+    void evaluate_rows(const PopulationMatrix &x, std::size_t begin, std::size_t end, ObjectiveMatrix &f,
+                       ConstraintMatrix &g) const override;
+
+    std::size_t cases() const { return next_case_.load(std::memory_order_relaxed); }
+    std::size_t failed_cases() const { return failed_.load(std::memory_order_relaxed); }
+
+private:
+    struct CasePaths {
+        std::string values[4];  // case number, directory, journal, report
+    };
+
+    CasePaths paths(std::size_t id) const;
+    void write_case(const CasePaths &paths, Span<const double> x, std::string &buffer) const;
+    void run_case(const CasePaths &paths, Span<double> f) const;
+    bool run_solver(const CasePaths &paths) const;
+
+    std::size_t n_var_;
+    std::vector<std::size_t> columns_;
+    FluentTemplate journal_;
+    std::vector<FluentTemplate> command_{};
+    std::string work_dir_;
+    std::string report_;
+    std::size_t slots_;
+
+    mutable std::atomic<std::size_t> next_case_{0};
+    mutable std::atomic<std::size_t> failed_{0};
+
+    // solver processes running across all callers, at most slots_
+    mutable std::mutex slot_mutex_;
+    mutable std::condition_variable slot_cv_;
+    mutable std::size_t running_ = 0;
+};
+
+#endif // EDDIE_FLUENT_H
@@ -0,0 +1,68 @@
+#ifndef EDDIE_FRONTS_H
+#define EDDIE_FRONTS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "population.h"
+
+// Pareto fronts in compressed form: front k holds members[offsets[k] .. offsets[k + 1]).
+// `rank[i]` is the front index of point i. All vectors keep their capacity between calls.
+struct FrontSet {
+    static constexpr std::size_t unranked = static_cast<std::size_t>(-1);
+
+    std::vector<std::size_t> members{};
+    std::vector<std::size_t> offsets{};
+    std::vector<std::size_t> rank{};
+
+    std::size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    Span<const std::size_t> front(std::size_t k) const {
+        return Span<const std::size_t>(members.data() + offsets[k], offsets[k + 1] - offsets[k]);
+    }
+
+    void reserve(std::size_t n_points) {
+        members.reserve(n_points);
+        offsets.reserve(n_points + 1);
+        rank.reserve(n_points);
+    }
+};
+
+// Survival cut for sorts that place one point at a time into its final front (ENS, BOS): when
+// only the fronts holding the first `n_stop_if_ranked` points (and at most `max_fronts` fronts)
+// are needed, a front whose predecessors already hold that many points is never read, so
+// points that would land in it or behind it are not placed at all and later points are not
+// compared against it. The front sizes only grow, so the number of kept fronts only shrinks.
+class FrontCut {
+public:
+    static constexpr std::size_t unlimited = static_cast<std::size_t>(-1);
+
+    explicit FrontCut(std::size_t n_stop_if_ranked = unlimited, std::size_t max_fronts = unlimited)
+        : n_stop_(n_stop_if_ranked), n_kept_(std::max<std::size_t>(max_fronts, 1)) {}
+
+    // Number of leading fronts still needed; a point dominated in all of them stays unranked.
+    std::size_t limit() const { return n_kept_; }
+    bool keeps(std::size_t k) const { return k < n_kept_; }
+
+    // Records a point placed into one of the kept fronts. `front_size` holds the sizes of the
+    // `n_fronts` fronts created so far, including the new point.
+    void add(const std::size_t *front_size, std::size_t n_fronts) {
+        ++n_ranked_;
+        if (n_ranked_ < n_stop_) {
+            return;
+        }
+        n_kept_ = std::min(n_kept_, n_fronts);
+        while (n_kept_ > 1 && n_ranked_ - front_size[n_kept_ - 1] >= n_stop_) {
+            n_ranked_ -= front_size[n_kept_ - 1];
+            --n_kept_;
+        }
+    }
+
+private:
+    std::size_t n_stop_;
+    std::size_t n_kept_;
+    std::size_t n_ranked_ = 0;  // points in the kept fronts
+};
+
+#endif // EDDIE_FRONTS_H
@@ -0,0 +1,633 @@
+#ifndef EDDIE_HYPERVOLUME_H
+#define EDDIE_HYPERVOLUME_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.h"
+#include "philox.h"
+
+// Hypervolume indicator (minimization): the volume dominated by a point set and bounded by a
+// reference point. Points that do not strictly dominate the reference point contribute nothing.
+//
+//   two objectives:    sweep over the points sorted by the first objective, O(n log n)
+//   three objectives:  dimension sweep over the third objective keeping the two-dimensional
+//                      front in a staircase (Beume et al.), O(n log n)
+//   four objectives:   sweep over the fourth objective; the three-dimensional volume of every
+//                      slab grows by the exclusive contribution of the new point, computed from
+//                      scratch, O(n^2 log n) (not the incremental O(n^2) HV4D of Guerreiro et al.)
+//   more objectives:   WFG (While et al.): with the points ordered worst-first in the last
+//                      objective, hv = sum_k (r_M - p_kM) * excl_(M-1)(p_k, {p_j : j > k}), the
+//                      exclusive terms evaluated on non-dominated limit sets one dimension lower
+//
+// The exclusive contribution of p to S is the volume of its box minus the hypervolume of the
+// limit set {max(p, s) : s in S}. `HypervolumeArchive` keeps the value and all contributions up to
+// date when one point is inserted or removed: only contributions of points whose joint box with the
+// changed point is not dominated by a third point change. The updates add and subtract volumes
+// whose rounding error is relative to the boxes moved, not to the value, so the archive recomputes
+// everything from scratch once those boxes outweigh the value (see `refresh_ratio`).
+// `hypervolume_monte_carlo` estimates the value with its standard error for many objectives, from
+// a Philox stream and on all cores.
+//
+// Header-only and free of other Eddie dependencies (besides parallel.h and philox.h) so the
+// compiled pymoo module can share it (pymoo/functions/compiled/hv.pyx).
+
+namespace hypervolume_detail {
+
+// Row-major set of points with d objectives.
+using Points = std::vector<double>;
+
+inline double box_volume(const double *p, const double *ref, std::size_t d) {
+    double volume = 1.0;
+    for (std::size_t k = 0; k < d; ++k) {
+        volume *= ref[k] - p[k];
+    }
+    return volume;
+}
+
+inline bool weakly_dominates(const double *a, const double *b, std::size_t d) {
+    for (std::size_t k = 0; k < d; ++k) {
+        if (a[k] > b[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool inside(const double *p, const double *ref, std::size_t d) {
+    for (std::size_t k = 0; k < d; ++k) {
+        if (!(p[k] < ref[k])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Removes weakly dominated points (and all but one of equal points), keeping the first d
+// objectives of every row of the stride-wide input.
+inline Points non_dominated(const Points &points, std::size_t stride, std::size_t d) {
+    const std::size_t n = points.size() / stride;
+    std::vector<unsigned char> dominated(n, 0U);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n && !dominated[i]; ++j) {
+            if (j == i || dominated[j]) {
+                continue;
+            }
+            // equal points: the later one is dropped
+            if (weakly_dominates(&points[j * stride], &points[i * stride], d) &&
+                (j < i || !weakly_dominates(&points[i * stride], &points[j * stride], d))) {
+                dominated[i] = 1U;
+            }
+        }
+    }
+    Points out;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!dominated[i]) {
+            out.insert(out.end(), points.begin() + static_cast<std::ptrdiff_t>(i * stride),
+                       points.begin() + static_cast<std::ptrdiff_t>(i * stride + d));
+        }
+    }
+    return out;
+}
+
+inline double hv2d(const Points &points, const double *ref) {
+    const std::size_t n = points.size() / 2;
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::sort(order.begin(), order.end(), [&points](std::size_t a, std::size_t b) {
+        return points[2 * a] != points[2 * b] ? points[2 * a] < points[2 * b] : points[2 * a + 1] < points[2 * b + 1];
+    });
+    double volume = 0.0;
+    double top = ref[1];
+    for (const std::size_t i : order) {
+        const double y = points[2 * i + 1];
+        if (y < top) {
+            volume += (ref[0] - points[2 * i]) * (top - y);
+            top = y;
+        }
+    }
+    return volume;
+}
+
+// Two-dimensional front sorted by the first objective (second one strictly falling) and its area.
+class Staircase {
+public:
+    explicit Staircase(const double *ref) : ref_(ref) {}
+
+    double area() const { return area_; }
+
+    // Adds (x, y) and returns the area it adds (zero if it is weakly dominated).
+    double insert(double x, double y) {
+        auto it = steps_.lower_bound(x);
+        if (it != steps_.end() && it->first == x && it->second <= y) {
+            return 0.0;
+        }
+        double top = ref_[1];
+        if (it != steps_.begin()) {
+            const double left = std::prev(it)->second;
+            if (left <= y) {
+                return 0.0;
+            }
+            top = left;
+        }
+
+        // the steps (x', y') with x' >= x and y' >= y are dominated by the new one
+        double added = 0.0;
+        double from = x;
+        while (it != steps_.end() && it->second >= y) {
+            added += (it->first - from) * (top - y);
+            from = it->first;
+            top = it->second;
+            it = steps_.erase(it);
+        }
+        added += ((it != steps_.end() ? it->first : ref_[0]) - from) * (top - y);
+        steps_.emplace_hint(it, x, y);
+        area_ += added;
+        return added;
+    }
+
+private:
+    const double *ref_;
+    std::map<double, double> steps_{};
+    double area_ = 0.0;
+};
+
+// Sweep over the last objective: `slice` holds the points of the lower dimension seen so far and
+// returns the volume each new point adds to it.
+template <typename Slice>
+double sweep(const Points &points, std::size_t d, const double *ref, Slice &slice) {
+    const std::size_t n = points.size() / d;
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::sort(order.begin(), order.end(),
+              [&points, d](std::size_t a, std::size_t b) { return points[a * d + d - 1] < points[b * d + d - 1]; });
+
+    double volume = 0.0;
+    double content = 0.0;
+    for (std::size_t r = 0; r < n; ++r) {
+        const double *p = &points[order[r] * d];
+        content += slice.insert(p);
+        const double next = r + 1 < n ? points[order[r + 1] * d + d - 1] : ref[d - 1];
+        volume += content * (next - p[d - 1]);
+    }
+    return volume;
+}
+
+struct StaircaseSlice {
+    Staircase staircase;
+    double insert(const double *p) { return staircase.insert(p[0], p[1]); }
+};
+
+inline double hv3d(const Points &points, const double *ref) {
+    StaircaseSlice slice{Staircase(ref)};
+    return sweep(points, 3, ref, slice);
+}
+
+// Exclusive three-dimensional contribution of p to `set` (the first three objectives of the rows
+// of a stride-wide buffer): its box minus the hypervolume of the limit set.
+inline double exclusive3d(const double *p, const Points &set, std::size_t stride, const double *ref) {
+    const std::size_t n = set.size() / stride;
+    Points limit;
+    limit.reserve(3 * n);
+    for (std::size_t j = 0; j < n; ++j) {
+        for (std::size_t k = 0; k < 3; ++k) {
+            limit.push_back(std::max(p[k], set[j * stride + k]));
+        }
+    }
+    return box_volume(p, ref, 3) - hv3d(limit, ref);
+}
+
+// Three-dimensional slice of the four-dimensional sweep. Each insertion recomputes the exclusive
+// volume of the new point with hv3d over its whole limit set, O(n log n).
+struct VolumeSlice {
+    const double *ref;
+    Points seen{};
+
+    double insert(const double *p) {
+        const std::size_t n = seen.size() / 3;
+        for (std::size_t j = 0; j < n; ++j) {
+            if (weakly_dominates(&seen[3 * j], p, 3)) {
+                return 0.0;
+            }
+        }
+        const double added = exclusive3d(p, seen, 3, ref);
+
+        // points the new one dominates no longer shape the union
+        Points kept;
+        kept.reserve(seen.size() + 3);
+        for (std::size_t j = 0; j < n; ++j) {
+            if (!weakly_dominates(p, &seen[3 * j], 3)) {
+                kept.insert(kept.end(), seen.begin() + static_cast<std::ptrdiff_t>(3 * j),
+                            seen.begin() + static_cast<std::ptrdiff_t>(3 * j + 3));
+            }
+        }
+        kept.insert(kept.end(), p, p + 3);
+        seen.swap(kept);
+        return added;
+    }
+};
+
+inline double hv4d_slices(const Points &points, const double *ref) {
+    VolumeSlice slice{ref};
+    return sweep(points, 4, ref, slice);
+}
+
+// Hypervolume of points with d objectives that all strictly dominate ref.
+inline double hv(const Points &points, std::size_t d, const double *ref) {
+    const std::size_t n = points.size() / d;
+    if (n == 0) {
+        return 0.0;
+    }
+    if (n == 1) {
+        return box_volume(points.data(), ref, d);
+    }
+    switch (d) {
+    case 1:
+        return ref[0] - *std::min_element(points.begin(), points.end());
+    case 2:
+        return hv2d(points, ref);
+    case 3:
+        return hv3d(points, ref);
+    case 4:
+        return hv4d_slices(points, ref);
+    default:
+        break;
+    }
+
+    // WFG slicing: worst-first in the last objective, so the limit sets of later points all share
+    // the last objective of p_k and are solved one dimension lower
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::sort(order.begin(), order.end(),
+              [&points, d](std::size_t a, std::size_t b) { return points[a * d + d - 1] > points[b * d + d - 1]; });
+
+    double volume = 0.0;
+    Points limit;
+    for (std::size_t r = 0; r < n; ++r) {
+        const double *p = &points[order[r] * d];
+        limit.clear();
+        for (std::size_t s = r + 1; s < n; ++s) {
+            const double *q = &points[order[s] * d];
+            for (std::size_t k = 0; k + 1 < d; ++k) {
+                limit.push_back(std::max(p[k], q[k]));
+            }
+        }
+        const double exclusive = box_volume(p, ref, d - 1) - hv(non_dominated(limit, d - 1, d - 1), d - 1, ref);
+        volume += (ref[d - 1] - p[d - 1]) * exclusive;
+    }
+    return volume;
+}
+
+// Exclusive contribution of p to the points `others` (all inside the reference box).
+inline double exclusive(const double *p, const Points &others, std::size_t d, const double *ref) {
+    const std::size_t n = others.size() / d;
+    Points limit;
+    limit.reserve(others.size());
+    for (std::size_t j = 0; j < n; ++j) {
+        for (std::size_t k = 0; k < d; ++k) {
+            limit.push_back(std::max(p[k], others[j * d + k]));
+        }
+    }
+    // the sweeps accept dominated points; WFG is much faster without them
+    return box_volume(p, ref, d) - hv(d > 4 ? non_dominated(limit, d, d) : limit, d, ref);
+}
+
+} // namespace hypervolume_detail
+
+// Hypervolume of the rows of the row-major n x n_obj matrix F with respect to ref.
+inline double hypervolume(const double *F, std::size_t n, std::size_t n_obj, const double *ref) {
+    namespace detail = hypervolume_detail;
+    if (n_obj == 0) {
+        throw std::invalid_argument("Hypervolume requires at least one objective");
+    }
+    detail::Points points;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (detail::inside(F + i * n_obj, ref, n_obj)) {
+            points.insert(points.end(), F + i * n_obj, F + (i + 1) * n_obj);
+        }
+    }
+    if (n_obj > 4) {
+        points = detail::non_dominated(points, n_obj, n_obj);
+    }
+    return detail::hv(points, n_obj, ref);
+}
+
+// out[i] = exclusive hypervolume contribution of row i of F, on n_threads threads (0 = all cores).
+inline void hypervolume_contributions(const double *F, std::size_t n, std::size_t n_obj, const double *ref,
+                                      double *out, std::size_t n_threads = 1) {
+    namespace detail = hypervolume_detail;
+    if (n_obj == 0) {
+        throw std::invalid_argument("Hypervolume requires at least one objective");
+    }
+    std::vector<std::size_t> rows;
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = 0.0;
+        if (detail::inside(F + i * n_obj, ref, n_obj)) {
+            rows.push_back(i);
+        }
+    }
+
+    if (n_obj == 2) {
+        // the exclusive rectangles of the front members are disjoint, and every other point covers
+        // part of at most one of them
+        std::sort(rows.begin(), rows.end(), [F](std::size_t a, std::size_t b) {
+            return F[2 * a] != F[2 * b] ? F[2 * a] < F[2 * b] : F[2 * a + 1] < F[2 * b + 1];
+        });
+        std::vector<std::size_t> front;
+        std::vector<std::size_t> rest;
+        for (const std::size_t i : rows) {
+            if (front.empty() || F[2 * i + 1] < F[2 * front.back() + 1]) {
+                front.push_back(i);
+            } else {
+                rest.push_back(i);
+            }
+        }
+
+        std::vector<double> right(front.size());
+        std::vector<double> top(front.size());
+        for (std::size_t r = 0; r < front.size(); ++r) {
+            right[r] = r + 1 < front.size() ? F[2 * front[r + 1]] : ref[0];
+            top[r] = r > 0 ? F[2 * front[r - 1] + 1] : ref[1];
+        }
+        std::vector<detail::Points> covered(front.size());
+        for (const std::size_t i : rest) {
+            // the last front member at or left of the point
+            const auto it = std::upper_bound(front.begin(), front.end(), F[2 * i],
+                                             [F](double x, std::size_t m) { return x < F[2 * m]; });
+            const std::size_t r = static_cast<std::size_t>(it - front.begin()) - 1;
+            if (F[2 * i] < right[r] && F[2 * i + 1] < top[r]) {
+                covered[r].insert(covered[r].end(), F + 2 * i, F + 2 * i + 2);
+            }
+        }
+        for (std::size_t r = 0; r < front.size(); ++r) {
+            const double *p = F + 2 * front[r];
+            const double corner[2] = {right[r], top[r]};
+            out[front[r]] = (right[r] - p[0]) * (top[r] - p[1]) - detail::hv2d(covered[r], corner);
+        }
+        return;
+    }
+
+    // every contribution is one hypervolume of the other n - 1 points
+    constexpr std::size_t min_points_per_thread = 16;
+    n_threads = resolve_thread_count(n_threads, rows.size(), min_points_per_thread);
+    parallel_for_tiles(rows.size(), n_threads, [&](std::size_t r, std::size_t) {
+        detail::Points others;
+        others.reserve((rows.size() - 1) * n_obj);
+        for (std::size_t s = 0; s < rows.size(); ++s) {
+            if (s != r) {
+                others.insert(others.end(), F + rows[s] * n_obj, F + (rows[s] + 1) * n_obj);
+            }
+        }
+        out[rows[r]] = detail::exclusive(F + rows[r] * n_obj, others, n_obj, ref);
+    });
+}
+
+struct HypervolumeEstimate {
+    double value = 0.0;
+    double standard_error = 0.0;  // of the value; the true value lies within 2 errors ~95% of the time
+    std::size_t n_samples = 0;
+};
+
+// Monte-Carlo estimate over n_samples uniform samples of the box between the best objective values
+// and ref, drawn from the Philox stream `seed`; the result does not depend on the thread count.
+inline HypervolumeEstimate hypervolume_monte_carlo(const double *F, std::size_t n, std::size_t n_obj,
+                                                   const double *ref, std::size_t n_samples, std::uint64_t seed,
+                                                   std::size_t n_threads = 1) {
+    namespace detail = hypervolume_detail;
+    if (n_obj == 0) {
+        throw std::invalid_argument("Hypervolume requires at least one objective");
+    }
+    detail::Points points;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (detail::inside(F + i * n_obj, ref, n_obj)) {
+            points.insert(points.end(), F + i * n_obj, F + (i + 1) * n_obj);
+        }
+    }
+    points = detail::non_dominated(points, n_obj, n_obj);
+    const std::size_t n_points = points.size() / n_obj;
+
+    HypervolumeEstimate estimate;
+    estimate.n_samples = n_samples;
+    if (n_points == 0 || n_samples == 0) {
+        return estimate;
+    }
+
+    std::vector<double> lower(points.begin(), points.begin() + static_cast<std::ptrdiff_t>(n_obj));
+    for (std::size_t i = 1; i < n_points; ++i) {
+        for (std::size_t k = 0; k < n_obj; ++k) {
+            lower[k] = std::min(lower[k], points[i * n_obj + k]);
+        }
+    }
+    const double box = detail::box_volume(lower.data(), ref, n_obj);
+
+    constexpr std::size_t samples_per_tile = 4096;
+    const std::size_t n_tiles = (n_samples + samples_per_tile - 1) / samples_per_tile;
+    std::vector<std::size_t> hits(n_tiles, 0U);
+    n_threads = resolve_thread_count(n_threads, n_samples * n_points, std::size_t{1} << 20);
+    parallel_for_tiles(n_tiles, n_threads, [&](std::size_t tile, std::size_t) {
+        PhiloxUniformStream uniform(seed, 0);
+        std::vector<double> sample(n_obj);
+        const std::size_t end = std::min(n_samples, (tile + 1) * samples_per_tile);
+        for (std::size_t s = tile * samples_per_tile; s < end; ++s) {
+            for (std::size_t k = 0; k < n_obj; ++k) {
+                sample[k] = lower[k] + uniform(static_cast<std::uint64_t>(s) * n_obj + k) * (ref[k] - lower[k]);
+            }
+            for (std::size_t i = 0; i < n_points; ++i) {
+                if (detail::weakly_dominates(&points[i * n_obj], sample.data(), n_obj)) {
+                    ++hits[tile];
+                    break;
+                }
+            }
+        }
+    });
+
+    const double fraction =
+        static_cast<double>(std::accumulate(hits.begin(), hits.end(), std::size_t{0})) / static_cast<double>(n_samples);
+    estimate.value = box * fraction;
+    estimate.standard_error = box * std::sqrt(fraction * (1.0 - fraction) / static_cast<double>(n_samples));
+    return estimate;
+}
+
+// Hypervolume and exclusive contributions of a changing point set, updated one point at a time.
+class HypervolumeArchive {
+public:
+    using Id = std::size_t;
+
+    // The value and the contributions are recomputed once the boxes of the points inserted and
+    // removed since the last refresh add up to this multiple of the value. Each update rounds to
+    // ~1e-16 of the box it moves, so the error stays near 1e-13 of the value, also when removals
+    // shrink the value by orders of magnitude. A refresh costs about as much as one update.
+    static constexpr double refresh_ratio = 1e3;
+
+    HypervolumeArchive(const double *ref, std::size_t n_obj) : ref_(ref, ref + n_obj), n_obj_(n_obj) {
+        if (n_obj_ == 0) {
+            throw std::invalid_argument("Hypervolume requires at least one objective");
+        }
+    }
+
+    std::size_t n_obj() const { return n_obj_; }
+    std::size_t size() const { return size_; }
+    double value() const { return value_; }
+
+    bool contains(Id id) const { return id < alive_.size() && alive_[id]; }
+
+    double contribution(Id id) const {
+        if (!contains(id)) {
+            throw std::out_of_range("Point is not in the hypervolume archive");
+        }
+        return contribution_[id];
+    }
+
+    const double *objectives(Id id) const { return objectives_.data() + id * n_obj_; }
+
+    // Adds a point and returns its id. Ids of removed points are reused.
+    Id insert(const double *f) {
+        const Id id = allocate(f);
+        if (inside_[id]) {
+            // every other contribution loses what the new point covers of it alone
+            update_shared(id, -1.0);
+            contribution_[id] = hypervolume_detail::exclusive(f, gather(id, id), n_obj_, ref_.data());
+            value_ += contribution_[id];
+        }
+        alive_[id] = 1U;
+        ++size_;
+        if (inside_[id]) {
+            moved(f);
+        }
+        return id;
+    }
+
+    void remove(Id id) {
+        if (!contains(id)) {
+            throw std::out_of_range("Point is not in the hypervolume archive");
+        }
+        alive_[id] = 0U;
+        --size_;
+        free_ids_.push_back(id);
+        if (inside_[id]) {
+            value_ -= contribution_[id];
+            update_shared(id, 1.0);
+        }
+        contribution_[id] = 0.0;
+        if (size_ == 0) {
+            value_ = 0.0;
+        }
+        if (inside_[id]) {
+            moved(objectives(id));
+        }
+    }
+
+    // Adds the rows of the row-major n x n_obj matrix F, writing their ids to `ids`, and computes the
+    // value and all contributions once afterwards instead of updating them per point: filling an
+    // archive this way costs one hypervolume_contributions call, n insertions cost n of them.
+    void insert_many(const double *F, std::size_t n, Id *ids, std::size_t n_threads = 1) {
+        for (std::size_t i = 0; i < n; ++i) {
+            ids[i] = allocate(F + i * n_obj_);
+            alive_[ids[i]] = 1U;
+            ++size_;
+        }
+        refresh(n_threads);
+    }
+
+    // Recomputes the value and every contribution from the points, discarding the rounding error
+    // the updates have accumulated.
+    void refresh(std::size_t n_threads = 1) {
+        std::vector<Id> ids;
+        hypervolume_detail::Points points;
+        for (Id j = 0; j < alive_.size(); ++j) {
+            if (alive_[j] && inside_[j]) {
+                ids.push_back(j);
+                points.insert(points.end(), objectives(j), objectives(j) + n_obj_);
+            }
+        }
+        value_ = hypervolume(points.data(), ids.size(), n_obj_, ref_.data());
+        std::vector<double> contributions(ids.size());
+        hypervolume_contributions(points.data(), ids.size(), n_obj_, ref_.data(), contributions.data(), n_threads);
+        for (std::size_t r = 0; r < ids.size(); ++r) {
+            contribution_[ids[r]] = contributions[r];
+        }
+        moved_ = 0.0;
+    }
+
+private:
+    // Stores f under a free id, not yet alive and with a zero contribution.
+    Id allocate(const double *f) {
+        Id id;
+        if (!free_ids_.empty()) {
+            id = free_ids_.back();
+            free_ids_.pop_back();
+        } else {
+            id = alive_.size();
+            alive_.push_back(0U);
+            inside_.push_back(0U);
+            contribution_.push_back(0.0);
+            objectives_.resize(objectives_.size() + n_obj_);
+        }
+        std::copy(f, f + n_obj_, objectives_.begin() + static_cast<std::ptrdiff_t>(id * n_obj_));
+        contribution_[id] = 0.0;
+        inside_[id] = hypervolume_detail::inside(f, ref_.data(), n_obj_) ? 1U : 0U;
+        return id;
+    }
+
+    void moved(const double *f) {
+        moved_ += hypervolume_detail::box_volume(f, ref_.data(), n_obj_);
+        if (moved_ > refresh_ratio * value_) {
+            refresh();
+        }
+    }
+
+    // Objectives of the alive points inside the reference box, except `skip_a` and `skip_b`.
+    hypervolume_detail::Points gather(Id skip_a, Id skip_b) const {
+        hypervolume_detail::Points points;
+        for (Id j = 0; j < alive_.size(); ++j) {
+            if (alive_[j] && inside_[j] && j != skip_a && j != skip_b) {
+                points.insert(points.end(), objectives(j), objectives(j) + n_obj_);
+            }
+        }
+        return points;
+    }
+
+    // Adds sign * (the volume point `changed` shares only with point j) to every contribution j.
+    void update_shared(Id changed, double sign) {
+        namespace detail = hypervolume_detail;
+        std::vector<double> joint(n_obj_);
+        for (Id j = 0; j < alive_.size(); ++j) {
+            if (!alive_[j] || !inside_[j] || j == changed) {
+                continue;
+            }
+            for (std::size_t k = 0; k < n_obj_; ++k) {
+                joint[k] = std::max(objectives(changed)[k], objectives(j)[k]);
+            }
+
+            // nothing changes if a third point already covers the joint box
+            bool covered = false;
+            for (Id s = 0; s < alive_.size() && !covered; ++s) {
+                covered = alive_[s] && inside_[s] && s != j && s != changed &&
+                          detail::weakly_dominates(objectives(s), joint.data(), n_obj_);
+            }
+            if (!covered) {
+                contribution_[j] += sign * detail::exclusive(joint.data(), gather(changed, j), n_obj_, ref_.data());
+            }
+        }
+    }
+
+    std::vector<double> ref_;
+    std::size_t n_obj_;
+    std::size_t size_ = 0;
+    double value_ = 0.0;
+    double moved_ = 0.0;  // box volume inserted and removed since the last refresh
+    std::vector<unsigned char> alive_{};
+    std::vector<unsigned char> inside_{};
+    std::vector<double> contribution_{};
+    std::vector<double> objectives_{};
+    std::vector<Id> free_ids_{};
+};
+
+#endif // EDDIE_HYPERVOLUME_H
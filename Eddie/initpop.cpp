@@ -2,38 +2,176 @@
 
 #include <algorithm>
 #include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
-Population latin_hypercube_population(const OptimizationParameters &params, std::mt19937 &rng) {
+#include "philox.h"
+#include "telemetry.h"
+
+namespace {
+
+// Philox stream ids at and above this value derive keys; jitter uses stream = dim below it.
+constexpr std::uint64_t key_stream = std::uint64_t{1} << 63;
+
+// SplitMix64 finalizer, the Feistel round function.
+std::uint64_t mix64(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Rows per thread below which starting another thread costs more than it saves.
+constexpr std::size_t min_rows_per_thread = 4096;
+
+} // namespace
+
+std::size_t decision_dimension(const OptimizationParameters &params) {
+    return params.variable_names.empty()
+               ? std::max(params.variable_lower_bounds.size(), params.variable_upper_bounds.size())
+               : params.variable_names.size();
+}
+
+void decision_bounds(const OptimizationParameters &params, std::vector<double> &lower, std::vector<double> &upper) {
+    const std::size_t dimension = decision_dimension(params);
+    lower.resize(dimension);
+    upper.resize(dimension);
+    for (std::size_t dim = 0; dim < dimension; ++dim) {
+        lower[dim] = dim < params.variable_lower_bounds.size() ? params.variable_lower_bounds[dim] : 0.0;
+        upper[dim] = dim < params.variable_upper_bounds.size() ? params.variable_upper_bounds[dim] : 1.0;
+    }
+}
+
+PopulationMatrix latin_hypercube_population(const OptimizationParameters &params, std::mt19937 &rng) {
+    EDDIE_TELEMETRY_SCOPE(initialization);
     const std::size_t population_size = params.population_size;
-    const std::size_t dimension = params.variable_names.empty()
-                                      ? std::max(params.variable_lower_bounds.size(),
-                                                 params.variable_upper_bounds.size())
-                                      : params.variable_names.size();
+    const std::size_t dimension = decision_dimension(params);
 
-    Population population(population_size, Individual(dimension, 0.0));
+    // Each dimension is sampled into a contiguous row of the column-major scratch and the
+    // result is transposed once, instead of writing every sample with a stride of `dimension`.
+    PopulationMatrix samples(dimension, population_size);
 
     std::uniform_real_distribution<double> unit_dist(0.0, 1.0);
+    std::vector<std::size_t> permutation(population_size);
 
     for (std::size_t dim = 0; dim < dimension; ++dim) {
         const double lower = dim < params.variable_lower_bounds.size() ? params.variable_lower_bounds[dim] : 0.0;
         const double upper = dim < params.variable_upper_bounds.size() ? params.variable_upper_bounds[dim] : 1.0;
-        std::vector<std::size_t> permutation(population_size);
         std::iota(permutation.begin(), permutation.end(), 0U);
         std::shuffle(permutation.begin(), permutation.end(), rng);
 
+        auto column = samples.row(dim);
         for (std::size_t i = 0; i < population_size; ++i) {
             const double jitter = unit_dist(rng);
             const double scaled = (static_cast<double>(permutation[i]) + jitter) /
                                   static_cast<double>(population_size);
-            const double value = lower + scaled * (upper - lower);
-            population[i][dim] = value;
+            column[i] = lower + scaled * (upper - lower);
         }
     }
 
+    PopulationMatrix population;
+    samples.transpose_into(population);
     return population;
 }
 
-Population latin_hypercube_population(const OptimizationParameters &params) {
+PopulationMatrix latin_hypercube_population(const OptimizationParameters &params) {
     std::mt19937 rng(params.random_seed);
     return latin_hypercube_population(params, rng);
 }
+
+LatinHypercubeSampler::LatinHypercubeSampler(const OptimizationParameters &params)
+    : population_size_(params.population_size), seed_(params.random_seed) {
+    decision_bounds(params, lower_, upper_);
+
+    // the bijection works on [0, 4^half_bits) and cycle-walks back into [0, population_size)
+    while ((std::uint64_t{1} << (2 * half_bits_)) < population_size_) {
+        ++half_bits_;
+    }
+
+    round_keys_.resize(lower_.size());
+    for (std::size_t dim = 0; dim < lower_.size(); ++dim) {
+        for (std::size_t pair = 0; pair < 2; ++pair) {
+            const auto words = Philox4x32::generate(seed_, key_stream | dim, pair);
+            round_keys_[dim][2 * pair] = static_cast<std::uint64_t>(words[0]) << 32 | words[1];
+            round_keys_[dim][2 * pair + 1] = static_cast<std::uint64_t>(words[2]) << 32 | words[3];
+        }
+    }
+}
+
+std::uint64_t LatinHypercubeSampler::stratum(std::size_t dim, std::uint64_t index) const {
+    // four-round Feistel network keyed per dimension; cycle walking keeps it a bijection on
+    // [0, population_size) and needs fewer than four passes on average
+    const auto &keys = round_keys_[dim];
+    const std::uint64_t mask = (std::uint64_t{1} << half_bits_) - 1;
+    std::uint64_t value = index;
+    do {
+        std::uint64_t left = value >> half_bits_;
+        std::uint64_t right = value & mask;
+        for (const std::uint64_t key : keys) {
+            const std::uint64_t next = left ^ (mix64(right ^ key) & mask);
+            left = right;
+            right = next;
+        }
+        value = left << half_bits_ | right;
+    } while (value >= population_size_);
+    return value;
+}
+
+void LatinHypercubeSampler::sample_rows(std::size_t begin, std::size_t end, PopulationMatrix &out,
+                                        std::size_t out_row) const {
+    if (begin > end || end > population_size_) {
+        throw std::invalid_argument("Latin hypercube row range exceeds the design");
+    }
+    if (out.cols() != cols() || out_row + (end - begin) > out.rows()) {
+        throw std::invalid_argument("Latin hypercube output matrix is too small");
+    }
+
+    const double inverse_size = 1.0 / static_cast<double>(population_size_);
+    for (std::size_t i = begin; i < end; ++i) {
+        auto row = out.row(out_row + (i - begin));
+        for (std::size_t dim = 0; dim < lower_.size(); ++dim) {
+            const double jitter = philox_unit(seed_, dim, i);
+            const double scaled = (static_cast<double>(stratum(dim, i)) + jitter) * inverse_size;
+            row[dim] = lower_[dim] + scaled * (upper_[dim] - lower_[dim]);
+        }
+    }
+}
+
+PopulationMatrix latin_hypercube_population_parallel(const OptimizationParameters &params, std::size_t n_threads) {
+    EDDIE_TELEMETRY_SCOPE(initialization);
+    const LatinHypercubeSampler sampler(params);
+    PopulationMatrix population(sampler.rows(), sampler.cols());
+
+    if (n_threads == 0) {
+        n_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    n_threads = std::max<std::size_t>(1, std::min(n_threads, sampler.rows() / min_rows_per_thread));
+
+    const std::size_t n = sampler.rows();
+    std::vector<std::thread> workers;
+    workers.reserve(n_threads - 1);
+    for (std::size_t t = 1; t < n_threads; ++t) {
+        const std::size_t begin = t * n / n_threads;
+        const std::size_t end = (t + 1) * n / n_threads;
+        workers.emplace_back([&sampler, &population, begin, end] { sampler.sample_rows(begin, end, population, begin); });
+    }
+    sampler.sample_rows(0, n / n_threads, population, 0);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    return population;
+}
+
+LatinHypercubeStream::LatinHypercubeStream(const OptimizationParameters &params, std::size_t chunk_rows)
+    : sampler_(params), chunk_rows_(std::max<std::size_t>(chunk_rows, 1)) {}
+
+bool LatinHypercubeStream::next(PopulationMatrix &chunk) {
+    if (position_ >= sampler_.rows()) {
+        return false;
+    }
+    const std::size_t end = std::min(sampler_.rows(), position_ + chunk_rows_);
+    chunk.resize(end - position_, sampler_.cols());
+    sampler_.sample_rows(position_, end, chunk);
+    position_ = end;
+    return true;
+}
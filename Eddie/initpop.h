@@ -1,16 +1,69 @@
 #ifndef EDDIE_INITPOP_H
 #define EDDIE_INITPOP_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <random>
 #include <vector>
 
 #include "parameter.h"
+#include "population.h"
 
-using Individual = std::vector<double>;
-using Population = std::vector<Individual>;
+std::size_t decision_dimension(const OptimizationParameters &params);
 
-Population latin_hypercube_population(const OptimizationParameters &params, std::mt19937 &rng);
+// Per-variable bounds, defaulting to [0, 1] where the parameters leave them unspecified.
+void decision_bounds(const OptimizationParameters &params, std::vector<double> &lower, std::vector<double> &upper);
 
-Population latin_hypercube_population(const OptimizationParameters &params);
+PopulationMatrix latin_hypercube_population(const OptimizationParameters &params, std::mt19937 &rng);
+
+PopulationMatrix latin_hypercube_population(const OptimizationParameters &params);
+
+// Latin hypercube design driven by a counter-based RNG. Sample (i, dim) is a pure function of
+// (random_seed, dim, i): the stratum comes from a keyed bijection on [0, population_size) and the
+// jitter from Philox4x32, so any block of rows can be generated on its own. Results depend only on
+// the seed, never on the thread count or the chunking, but differ from the mt19937 design above.
+class LatinHypercubeSampler {
+public:
+    explicit LatinHypercubeSampler(const OptimizationParameters &params);
+
+    std::size_t rows() const { return population_size_; }
+    std::size_t cols() const { return lower_.size(); }
+
+    // Writes design rows [begin, end) into `out` starting at `out_row`; `out` must already have
+    // `cols()` columns and room for the rows.
+    void sample_rows(std::size_t begin, std::size_t end, PopulationMatrix &out, std::size_t out_row = 0) const;
+
+private:
+    std::uint64_t stratum(std::size_t dim, std::uint64_t index) const;
+
+    std::size_t population_size_ = 0;
+    std::uint64_t seed_ = 0;
+    unsigned half_bits_ = 1;
+    std::vector<double> lower_{};
+    std::vector<double> upper_{};
+    std::vector<std::array<std::uint64_t, 4>> round_keys_{};
+};
+
+// Whole counter-based design, split over `n_threads` threads (0 uses every hardware thread).
+PopulationMatrix latin_hypercube_population_parallel(const OptimizationParameters &params, std::size_t n_threads = 0);
+
+// Yields a counter-based design in chunks of at most `chunk_rows` rows, for designs that should
+// not be held in memory at once. Concatenating the chunks gives the parallel design exactly.
+class LatinHypercubeStream {
+public:
+    LatinHypercubeStream(const OptimizationParameters &params, std::size_t chunk_rows);
+
+    // Fills `chunk` with the next rows; returns false once the whole design has been produced.
+    bool next(PopulationMatrix &chunk);
+
+    std::size_t position() const { return position_; }
+    std::size_t size() const { return sampler_.rows(); }
+
+private:
+    LatinHypercubeSampler sampler_;
+    std::size_t chunk_rows_ = 1;
+    std::size_t position_ = 0;
+};
 
 #endif // EDDIE_INITPOP_H
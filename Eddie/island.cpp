@@ -0,0 +1,196 @@
+#include "island.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "philox.h"
+#include "telemetry.h"
+#include "telemetry_report.h"
+
+MigrationTopology parse_migration_topology(const std::string &name) {
+    if (name == "ring") {
+        return MigrationTopology::ring;
+    }
+    if (name == "complete") {
+        return MigrationTopology::complete;
+    }
+    throw std::invalid_argument("Unknown migration topology: " + name);
+}
+
+std::vector<std::size_t> migration_targets(MigrationTopology topology, std::size_t island, std::size_t n_islands) {
+    std::vector<std::size_t> targets;
+    if (n_islands < 2) {
+        return targets;
+    }
+    if (topology == MigrationTopology::ring) {
+        targets.push_back((island + 1) % n_islands);
+    } else {
+        for (std::size_t i = 0; i < n_islands; ++i) {
+            if (i != island) {
+                targets.push_back(i);
+            }
+        }
+    }
+    return targets;
+}
+
+std::vector<std::size_t> migration_sources(MigrationTopology topology, std::size_t island, std::size_t n_islands) {
+    if (topology == MigrationTopology::ring && n_islands >= 2) {
+        return {(island + n_islands - 1) % n_islands};
+    }
+    // the complete graph is symmetric
+    return migration_targets(topology, island, n_islands);
+}
+
+unsigned int island_seed(unsigned int random_seed, std::size_t island) {
+    // stream 1 keeps the island seeds apart from other Philox streams of the same seed
+    return Philox4x32::generate(random_seed, 1, island)[0];
+}
+
+IslandModel::IslandModel(const OptimizationParameters &params, const Problem &problem, Evaluator &evaluator,
+                         MigrationTransport &transport)
+    : params_(params), transport_(transport), topology_(parse_migration_topology(params.migration_topology)) {
+    if (params_.islands == 0) {
+        throw std::invalid_argument("The island model requires at least one island");
+    }
+    if (params_.islands < transport_.n_processes()) {
+        throw std::invalid_argument("The island model needs at least one island per process");
+    }
+    if (params_.migrants > 0 && params_.migration_interval == 0) {
+        throw std::invalid_argument("Migration requires a positive migration_interval");
+    }
+    if (params_.steady_state || !params_.checkpoint_path.empty()) {
+        throw std::invalid_argument("The island model supports neither steady-state mode nor checkpoints yet");
+    }
+
+    for (std::size_t i = transport_.process(); i < params_.islands; i += transport_.n_processes()) {
+        OptimizationParameters island_params = params_;
+        island_params.random_seed = island_seed(params_.random_seed, i);
+        Island island;
+        island.index = i;
+        island.algorithm = std::make_unique<NSGA2>(island_params, problem, evaluator);
+        islands_.push_back(std::move(island));
+    }
+}
+
+void IslandModel::run() {
+    for (auto &island : islands_) {
+        island.algorithm->initialize();
+    }
+    if (telemetry_ != nullptr) {
+        telemetry_->record(0);
+    }
+
+    const bool migrating = params_.islands > 1 && params_.migrants > 0;
+    for (std::size_t generation = 1; generation <= params_.max_generations; ++generation) {
+        for (auto &island : islands_) {
+            island.algorithm->step();
+        }
+        transport_.progress();
+
+        if (migrating && generation % params_.migration_interval == 0) {
+            // only send what a later migration within the run will merge
+            migrate(generation / params_.migration_interval,
+                    generation + params_.migration_interval <= params_.max_generations);
+        }
+        if (telemetry_ != nullptr) {
+            telemetry_->record(generation);
+        }
+    }
+    transport_.finish();
+}
+
+void IslandModel::migrate(std::size_t epoch, bool send) {
+    EDDIE_TELEMETRY_SCOPE(migration);
+    for (auto &island : islands_) {
+        if (epoch > 1) {
+            receive(island, epoch - 1);
+        }
+        if (send) {
+            MigrationMessage message;
+            message.source = island.index;
+            message.epoch = epoch;
+            island.algorithm->emigrants(params_.migrants, message.rows);
+            for (const std::size_t target : migration_targets(topology_, island.index, params_.islands)) {
+                transport_.send(target, message);
+            }
+        }
+    }
+}
+
+void IslandModel::receive(Island &island, std::size_t epoch) {
+    const std::size_t expected = migration_sources(topology_, island.index, params_.islands).size();
+
+    // messages of this epoch that came in early, then blocking receives for the rest
+    std::vector<MigrationMessage> arrived;
+    for (auto it = island.pending.begin(); it != island.pending.end();) {
+        if (it->epoch == epoch) {
+            arrived.push_back(std::move(*it));
+            it = island.pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    while (arrived.size() < expected) {
+        MigrationMessage message = transport_.receive(island.index);
+        if (message.epoch == epoch) {
+            arrived.push_back(std::move(message));
+        } else {
+            island.pending.push_back(std::move(message));
+        }
+    }
+
+    std::sort(arrived.begin(), arrived.end(),
+              [](const MigrationMessage &a, const MigrationMessage &b) { return a.source < b.source; });
+    immigrants_.clear();
+    for (const auto &message : arrived) {
+        immigrants_.insert(immigrants_.end(), message.rows.begin(), message.rows.end());
+    }
+    island.algorithm->immigrate(Span<const double>(immigrants_.data(), immigrants_.size()));
+}
+
+NonDominatedArchive IslandModel::gather_front() const {
+    // per island: [index, rows, rows x (x, f)]
+    std::vector<double> local;
+    for (const auto &island : islands_) {
+        const auto &algorithm = *island.algorithm;
+        const auto rank = algorithm.rank();
+        local.push_back(static_cast<double>(island.index));
+        local.push_back(static_cast<double>(std::count(rank.begin(), rank.end(), std::size_t{0})));
+        for (std::size_t i = 0; i < rank.size(); ++i) {
+            if (rank[i] == 0) {
+                const auto x = algorithm.population().row(i);
+                const auto f = algorithm.objectives().row(i);
+                local.insert(local.end(), x.begin(), x.end());
+                local.insert(local.end(), f.begin(), f.end());
+            }
+        }
+    }
+
+    std::vector<double> all;
+    transport_.gather(local, all);
+
+    const std::size_t n_var = islands_.front().algorithm->population().cols();
+    const std::size_t n_obj = islands_.front().algorithm->objectives().cols();
+    const std::size_t width = n_var + n_obj;
+
+    // merged in island order, so the archive does not depend on the number of processes
+    std::vector<std::pair<std::size_t, std::size_t>> segments;  // (island, offset of its header)
+    for (std::size_t offset = 0; offset < all.size();) {
+        segments.emplace_back(static_cast<std::size_t>(all[offset]), offset);
+        offset += 2 + static_cast<std::size_t>(all[offset + 1]) * width;
+    }
+    std::sort(segments.begin(), segments.end());
+
+    NonDominatedArchive front(n_var, n_obj);
+    for (const auto &segment : segments) {
+        const double *rows = all.data() + segment.second + 2;
+        const auto n_rows = static_cast<std::size_t>(all[segment.second + 1]);
+        for (std::size_t i = 0; i < n_rows; ++i) {
+            const double *row = rows + i * width;
+            front.insert(Span<const double>(row, n_var), Span<const double>(row + n_var, n_obj));
+        }
+    }
+    return front;
+}
@@ -0,0 +1,76 @@
+#ifndef EDDIE_ISLAND_H
+#define EDDIE_ISLAND_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "archive.h"
+#include "evaluator.h"
+#include "migration.h"
+#include "nsga2.h"
+#include "parameter.h"
+
+class TelemetryReport;
+
+enum class MigrationTopology { ring, complete };
+
+MigrationTopology parse_migration_topology(const std::string &name);
+
+// Islands that `island` sends its migrants to, and the ones it receives from, in increasing order.
+std::vector<std::size_t> migration_targets(MigrationTopology topology, std::size_t island, std::size_t n_islands);
+std::vector<std::size_t> migration_sources(MigrationTopology topology, std::size_t island, std::size_t n_islands);
+
+// Seed of island i, derived from (random_seed, i) by Philox, so it does not depend on how the
+// islands are spread over processes.
+unsigned int island_seed(unsigned int random_seed, std::size_t island);
+
+// Island-model NSGA-II: `params.islands` independent NSGA-II populations of `population_size`
+// each, spread over the processes of `transport` (island i on process i % n_processes). Every
+// `migration_interval` generations each island sends up to `migrants` first-front individuals
+// (the least crowded ones) to its targets in `migration_topology`.
+//
+// Migrants sent at one migration are merged at the next, one interval later: sends return at
+// once and travel while the islands evaluate, and a receiver only waits if they are still not
+// there after a full interval. Because every island merges exactly the migrants of the previous
+// migration, ordered by source island, results only depend on the seed and the island count,
+// not on the number of processes or on message timing.
+class IslandModel {
+public:
+    IslandModel(const OptimizationParameters &params, const Problem &problem, Evaluator &evaluator,
+                MigrationTransport &transport);
+
+    // Initializes every local island and runs them for `max_generations` with migration.
+    void run();
+
+    // Makes `run()` write a row to `report` for all local islands together after every generation.
+    void set_telemetry(TelemetryReport *report) { telemetry_ = report; }
+
+    // The islands of this process, in increasing island index.
+    std::size_t n_local_islands() const { return islands_.size(); }
+    std::size_t island_index(std::size_t local) const { return islands_[local].index; }
+    const NSGA2 &island(std::size_t local) const { return *islands_[local].algorithm; }
+
+    // Non-dominated union of the first fronts of all islands; filled on process 0 only.
+    NonDominatedArchive gather_front() const;
+
+private:
+    struct Island {
+        std::size_t index = 0;
+        std::unique_ptr<NSGA2> algorithm{};
+        std::vector<MigrationMessage> pending{};  // arrived early, for a later migration
+    };
+
+    void migrate(std::size_t epoch, bool send);
+    void receive(Island &island, std::size_t epoch);
+
+    OptimizationParameters params_;
+    MigrationTransport &transport_;
+    MigrationTopology topology_;
+    std::vector<Island> islands_{};
+    std::vector<double> immigrants_{};
+    TelemetryReport *telemetry_ = nullptr;
+};
+
+#endif // EDDIE_ISLAND_H
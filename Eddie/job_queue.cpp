@@ -0,0 +1,108 @@
+#include "job_queue.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "telemetry.h"
+
+EvaluationJobQueue::EvaluationJobQueue(const Problem &problem, std::size_t slots) : problem_(problem) {
+    if (slots == 0) {
+        throw std::invalid_argument("Evaluation job queue requires at least one slot");
+    }
+    workers_.reserve(slots);
+    for (std::size_t i = 0; i < slots; ++i) {
+        workers_.emplace_back(&EvaluationJobQueue::worker_loop, this);
+    }
+}
+
+EvaluationJobQueue::~EvaluationJobQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        jobs_.clear();
+    }
+    job_cv_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+std::size_t EvaluationJobQueue::submit(Span<const double> x) {
+    std::size_t id = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = next_id_++;
+        jobs_.push_back(Job{id, std::vector<double>(x.begin(), x.end())});
+        ++outstanding_;
+        EDDIE_TELEMETRY_QUEUE_DEPTH(outstanding_);
+    }
+    job_cv_.notify_one();
+    return id;
+}
+
+bool EvaluationJobQueue::wait_result(EvaluationResult &result) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (outstanding_ == 0) {
+        return false;
+    }
+    result_cv_.wait(lock, [this] { return !results_.empty(); });
+    result = std::move(results_.front());
+    results_.pop_front();
+    --outstanding_;
+    return true;
+}
+
+std::size_t EvaluationJobQueue::outstanding() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return outstanding_;
+}
+
+std::size_t EvaluationJobQueue::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size();
+}
+
+double EvaluationJobQueue::busy_seconds() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return busy_seconds_;
+}
+
+void EvaluationJobQueue::worker_loop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            job_cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        EvaluationResult result;
+        result.id = job.id;
+        result.f.assign(problem_.n_obj(), 0.0);
+        result.g.assign(problem_.n_constr(), 0.0);
+
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            EDDIE_TELEMETRY_SCOPE(evaluation);
+            EDDIE_TELEMETRY_ADD(evaluations, 1);
+            problem_.evaluate_individual(Span<const double>(job.x.data(), job.x.size()),
+                                         Span<double>(result.f.data(), result.f.size()),
+                                         Span<double>(result.g.data(), result.g.size()));
+        } catch (...) {
+            result.error = std::current_exception();
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.x = std::move(job.x);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_seconds_ += result.seconds;
+            results_.push_back(std::move(result));
+        }
+        result_cv_.notify_one();
+    }
+}
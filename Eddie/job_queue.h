@@ -0,0 +1,76 @@
+#ifndef EDDIE_JOB_QUEUE_H
+#define EDDIE_JOB_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "evaluator.h"
+#include "population.h"
+
+struct EvaluationResult {
+    std::size_t id = 0;
+    std::vector<double> x{};
+    std::vector<double> f{};
+    std::vector<double> g{};
+    std::exception_ptr error{};
+    double seconds = 0.0;
+};
+
+// Keeps up to `slots` evaluations of `problem` running at once (one per solver license) and
+// hands results back in completion order, not submission order. Jobs submitted while every
+// slot is busy wait in a FIFO until a slot frees up. Destruction drops waiting jobs but lets
+// running evaluations finish.
+class EvaluationJobQueue {
+public:
+    EvaluationJobQueue(const Problem &problem, std::size_t slots);
+    ~EvaluationJobQueue();
+
+    EvaluationJobQueue(const EvaluationJobQueue &) = delete;
+    EvaluationJobQueue &operator=(const EvaluationJobQueue &) = delete;
+
+    // Queues an evaluation of `x` and returns its job id.
+    std::size_t submit(Span<const double> x);
+
+    // Blocks until some job finishes. Returns false if nothing is pending or running.
+    bool wait_result(EvaluationResult &result);
+
+    std::size_t slots() const { return workers_.size(); }
+
+    // Jobs submitted but not yet returned by `wait_result`.
+    std::size_t outstanding() const;
+
+    // Jobs waiting for a free slot.
+    std::size_t pending() const;
+
+    // Sum of the wall time spent inside `evaluate_individual` over all finished jobs.
+    double busy_seconds() const;
+
+private:
+    struct Job {
+        std::size_t id = 0;
+        std::vector<double> x{};
+    };
+
+    void worker_loop();
+
+    const Problem &problem_;
+    std::vector<std::thread> workers_{};
+
+    mutable std::mutex mutex_;
+    std::condition_variable job_cv_;
+    std::condition_variable result_cv_;
+    std::deque<Job> jobs_{};
+    std::deque<EvaluationResult> results_{};
+    std::size_t next_id_ = 0;
+    std::size_t outstanding_ = 0;
+    double busy_seconds_ = 0.0;
+    bool stopping_ = false;
+};
+
+#endif // EDDIE_JOB_QUEUE_H
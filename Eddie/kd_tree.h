@@ -0,0 +1,192 @@
+#ifndef EDDIE_KD_TREE_H
+#define EDDIE_KD_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// k-d tree over the rows of a row-major n x dim matrix for k-nearest-neighbour queries under the
+// squared Euclidean distance, with point removal for iterative pruning.
+//
+// Nodes split their widest bounding-box extent at the median and keep their bounding box, so a
+// subtree is skipped once its box is farther away than the current k-th neighbour. Removed
+// points stay in the tree; every node counts its remaining points, and empty subtrees are
+// skipped as well. The matrix is not copied and must outlive the tree.
+//
+// Header-only and free of other Eddie dependencies so the compiled pymoo module can share it
+// (pymoo/functions/compiled/mnn.pyx).
+class KdTree {
+public:
+    using Neighbor = std::pair<double, std::size_t>;  // squared distance, row
+
+    KdTree(const double *points, std::size_t n, std::size_t dim, std::size_t leaf_size = 8)
+        : points_(points), n_(n), dim_(dim), leaf_size_(std::max<std::size_t>(leaf_size, 1)), size_(n),
+          index_(n), alive_(n, 1U), leaf_of_(n, npos) {
+        for (std::size_t i = 0; i < n; ++i) {
+            index_[i] = i;
+        }
+        if (n_ > 0) {
+            nodes_.reserve(2 * (n_ / leaf_size_ + 1));
+            build(0, n_, npos);
+        }
+    }
+
+    std::size_t size() const { return size_; }
+    bool contains(std::size_t i) const { return i < n_ && alive_[i]; }
+
+    void remove(std::size_t i) {
+        if (!contains(i)) {
+            return;
+        }
+        alive_[i] = 0U;
+        --size_;
+        for (std::size_t node = leaf_of_[i]; node != npos; node = nodes_[node].parent) {
+            --nodes_[node].count;
+        }
+    }
+
+    // The (up to) k nearest remaining points to row i, excluding i itself, ascending by distance.
+    void nearest(std::size_t i, std::size_t k, std::vector<Neighbor> &out) const {
+        out.clear();
+        if (k == 0 || nodes_.empty()) {
+            return;
+        }
+        search(0, i, points_ + i * dim_, k, out);
+    }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    struct Node {
+        std::size_t begin;
+        std::size_t end;
+        std::size_t parent;
+        std::size_t left = npos;
+        std::size_t right = npos;
+        std::size_t count = 0;  // remaining points in the subtree
+    };
+
+    const double *row(std::size_t i) const { return points_ + i * dim_; }
+    const double *lower(std::size_t node) const { return boxes_.data() + 2 * node * dim_; }
+    const double *upper(std::size_t node) const { return boxes_.data() + (2 * node + 1) * dim_; }
+
+    std::size_t build(std::size_t begin, std::size_t end, std::size_t parent) {
+        const std::size_t id = nodes_.size();
+        nodes_.push_back(Node{begin, end, parent});
+        nodes_[id].count = end - begin;
+
+        boxes_.resize(boxes_.size() + 2 * dim_);
+        double *lo = boxes_.data() + 2 * id * dim_;
+        double *hi = lo + dim_;
+        std::copy(row(index_[begin]), row(index_[begin]) + dim_, lo);
+        std::copy(row(index_[begin]), row(index_[begin]) + dim_, hi);
+        for (std::size_t p = begin + 1; p < end; ++p) {
+            const double *x = row(index_[p]);
+            for (std::size_t m = 0; m < dim_; ++m) {
+                lo[m] = std::min(lo[m], x[m]);
+                hi[m] = std::max(hi[m], x[m]);
+            }
+        }
+
+        if (end - begin <= leaf_size_) {
+            for (std::size_t p = begin; p < end; ++p) {
+                leaf_of_[index_[p]] = id;
+            }
+            return id;
+        }
+
+        std::size_t axis = 0;
+        for (std::size_t m = 1; m < dim_; ++m) {
+            if (hi[m] - lo[m] > hi[axis] - lo[axis]) {
+                axis = m;
+            }
+        }
+        const std::size_t mid = begin + (end - begin) / 2;
+        std::nth_element(index_.begin() + static_cast<std::ptrdiff_t>(begin),
+                         index_.begin() + static_cast<std::ptrdiff_t>(mid),
+                         index_.begin() + static_cast<std::ptrdiff_t>(end),
+                         [this, axis](std::size_t a, std::size_t b) { return row(a)[axis] < row(b)[axis]; });
+
+        const std::size_t left = build(begin, mid, id);
+        const std::size_t right = build(mid, end, id);
+        nodes_[id].left = left;
+        nodes_[id].right = right;
+        return id;
+    }
+
+    double box_distance(std::size_t node, const double *q) const {
+        const double *lo = lower(node);
+        const double *hi = upper(node);
+        double dist = 0.0;
+        for (std::size_t m = 0; m < dim_; ++m) {
+            const double gap = q[m] < lo[m] ? lo[m] - q[m] : (q[m] > hi[m] ? q[m] - hi[m] : 0.0);
+            dist += gap * gap;
+        }
+        return dist;
+    }
+
+    static double worst(const std::vector<Neighbor> &out, std::size_t k) {
+        return out.size() < k ? std::numeric_limits<double>::infinity() : out.back().first;
+    }
+
+    void search(std::size_t node, std::size_t i, const double *q, std::size_t k, std::vector<Neighbor> &out) const {
+        const Node &current = nodes_[node];
+        if (current.count == 0) {
+            return;
+        }
+
+        if (current.left == npos) {
+            for (std::size_t p = current.begin; p < current.end; ++p) {
+                const std::size_t j = index_[p];
+                if (j == i || !alive_[j]) {
+                    continue;
+                }
+                // same summation order as the dense distance matrix, so the values match exactly
+                const double *x = row(j);
+                double dist = 0.0;
+                for (std::size_t m = 0; m < dim_; ++m) {
+                    dist += (x[m] - q[m]) * (x[m] - q[m]);
+                }
+                if (dist < worst(out, k)) {
+                    if (out.size() == k) {
+                        out.pop_back();
+                    }
+                    out.insert(std::upper_bound(out.begin(), out.end(), Neighbor{dist, j},
+                                                [](const Neighbor &a, const Neighbor &b) { return a.first < b.first; }),
+                               Neighbor{dist, j});
+                }
+            }
+            return;
+        }
+
+        std::size_t near = current.left;
+        std::size_t far = current.right;
+        double near_dist = box_distance(near, q);
+        double far_dist = box_distance(far, q);
+        if (far_dist < near_dist) {
+            std::swap(near, far);
+            std::swap(near_dist, far_dist);
+        }
+        if (near_dist < worst(out, k)) {
+            search(near, i, q, k, out);
+        }
+        if (far_dist < worst(out, k)) {
+            search(far, i, q, k, out);
+        }
+    }
+
+    const double *points_;
+    std::size_t n_;
+    std::size_t dim_;
+    std::size_t leaf_size_;
+    std::size_t size_;
+    std::vector<std::size_t> index_;
+    std::vector<unsigned char> alive_;
+    std::vector<std::size_t> leaf_of_;
+    std::vector<Node> nodes_{};
+    std::vector<double> boxes_{};  // per node: lower corner, then upper corner
+};
+
+#endif // EDDIE_KD_TREE_H
@@ -3,10 +3,20 @@
 #include <exception>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
 
+#include "evaluation_cache.h"
+#include "fluent.h"
 #include "initpop.h"
+#include "island.h"
+#include "migration.h"
+#include "nsga2.h"
 #include "parameter.h"
 #include "problem.h"
+#include "steady_state.h"
+#include "telemetry_report.h"
 
 OptimizationParameters load_default_parameters() {
     OptimizationParameters params{};
@@ -31,6 +41,40 @@ void print_parameters(const OptimizationParameters &params) {
     std::cout << "SBX distribution index: " << params.distribution_index_crossover << '\n';
     std::cout << "Polynomial mutation index: " << params.distribution_index_mutation << '\n';
     std::cout << "Random seed: " << params.random_seed << '\n';
+    std::cout << "Evaluation threads: " << params.evaluation_threads << '\n';
+    std::cout << "Steady-state mode: " << (params.steady_state ? "on" : "off") << '\n';
+    std::cout << "Max evaluations in flight: " << params.max_in_flight << '\n';
+    std::cout << "Checkpoint: " << (params.checkpoint_path.empty() ? "off" : params.checkpoint_path);
+    if (!params.checkpoint_path.empty()) {
+        std::cout << " every " << params.checkpoint_interval << " generations";
+    }
+    std::cout << '\n';
+    std::cout << "Evaluation cache: " << (params.evaluation_cache ? "on" : "off");
+    if (params.evaluation_cache) {
+        std::cout << ", resolution " << params.cache_resolution << ", "
+                  << (params.cache_path.empty() ? "in memory" : params.cache_path);
+    }
+    std::cout << '\n';
+    std::cout << "Surrogate pre-screening: ";
+    if (params.prescreen_factor > 1) {
+        std::cout << params.prescreen_factor << " candidates per evaluation, up to " << params.surrogate_points
+                  << " points";
+    } else {
+        std::cout << "off";
+    }
+    std::cout << '\n';
+    std::cout << "Telemetry: " << (params.telemetry_path.empty() ? "off" : params.telemetry_path) << '\n';
+    std::cout << "Problem: " << params.problem;
+    if (params.problem == "fluent") {
+        std::cout << ", journal " << params.fluent_journal_template << ", cases in " << params.fluent_work_dir;
+    }
+    std::cout << '\n';
+    std::cout << "Islands: " << params.islands;
+    if (params.islands > 1) {
+        std::cout << ", " << params.migrants << " migrants every " << params.migration_interval
+                  << " generations (" << params.migration_topology << ")";
+    }
+    std::cout << '\n';
 
     std::cout << "Design variables:" << '\n';
     for (std::size_t i = 0; i < params.variable_names.size(); ++i) {
@@ -46,16 +90,16 @@ void print_parameters(const OptimizationParameters &params) {
     }
 }
 
-void print_population_sample(const Population &population, std::size_t count = 5) {
+void print_population_sample(const PopulationMatrix &population, std::size_t count = 5) {
     std::cout << "\nLatin Hypercube Initial Population (first "
-              << std::min(count, population.size()) << " individuals)" << '\n';
+              << std::min(count, population.rows()) << " individuals)" << '\n';
     std::cout << "-----------------------------------------------------" << '\n';
-    const std::size_t display_count = std::min(count, population.size());
+    const std::size_t display_count = std::min(count, population.rows());
     for (std::size_t i = 0; i < display_count; ++i) {
         std::cout << "Individual " << (i + 1) << ": ";
-        for (std::size_t j = 0; j < population[i].size(); ++j) {
-            std::cout << std::fixed << std::setprecision(4) << population[i][j];
-            if (j + 1 < population[i].size()) {
+        for (std::size_t j = 0; j < population.cols(); ++j) {
+            std::cout << std::fixed << std::setprecision(4) << population(i, j);
+            if (j + 1 < population.cols()) {
                 std::cout << ", ";
             }
         }
@@ -63,20 +107,146 @@ void print_population_sample(const Population &population, std::size_t count = 5
     }
 }
 
-int main() {
+void print_final_front(const std::string &title, const ObjectiveMatrix &objectives, Span<const std::size_t> rank,
+                       std::size_t count = 5) {
+    const auto n_first = static_cast<std::size_t>(std::count(rank.begin(), rank.end(), std::size_t{0}));
+
+    std::cout << "\n" << title << ": " << n_first << " of " << objectives.rows()
+              << " individuals in the first front" << '\n';
+    std::cout << "-----------------------------------------------------" << '\n';
+    std::size_t shown = 0;
+    for (std::size_t i = 0; i < objectives.rows() && shown < count; ++i) {
+        if (rank[i] != 0) {
+            continue;
+        }
+        std::cout << "Objectives: " << std::fixed << std::setprecision(6) << objectives(i, 0) << ", "
+                  << objectives(i, 1) << '\n';
+        ++shown;
+    }
+}
+
+void print_cache_stats(const CachedProblem *cached) {
+    if (cached != nullptr) {
+        std::cout << "Evaluation cache: " << cached->hits() << " hits, " << cached->evaluations() << " evaluations, "
+                  << cached->cache().loaded() << " results loaded";
+        if (cached->uncached() > 0) {
+            std::cout << ", " << cached->uncached() << " not cached (cache full)";
+        }
+        std::cout << '\n';
+    }
+}
+
+std::unique_ptr<Problem> make_problem(const OptimizationParameters &params) {
+    if (params.problem == "zdt4") {
+        return std::make_unique<ZDT4Problem>(decision_dimension(params));
+    }
+    if (params.problem == "fluent") {
+        return std::make_unique<FluentProblem>(params);
+    }
+    throw std::invalid_argument("problem must be zdt4 or fluent, got " + params.problem);
+}
+
+// Solver runs pipeline their own batches (up to max_in_flight processes), so they are handed
+// whole populations instead of per-thread chunks.
+std::unique_ptr<Evaluator> make_evaluator(const OptimizationParameters &params) {
+    if (params.problem == "fluent") {
+        return std::make_unique<SerialEvaluator>();
+    }
+    return std::make_unique<ThreadPoolEvaluator>(params.evaluation_threads);
+}
+
+void print_fluent_stats(const Problem &problem) {
+    if (const auto *fluent = dynamic_cast<const FluentProblem *>(&problem)) {
+        std::cout << "Fluent: " << fluent->cases() << " cases, " << fluent->failed_cases() << " failed" << '\n';
+    }
+}
+
+// Island-model run; with an MPI build every rank runs its share of the islands and rank 0 reports.
+int run_islands(OptimizationParameters params, int &argc, char **&argv) {
+    const auto transport = make_migration_transport(params.islands, argc, argv);
+    const bool root = transport->process() == 0;
+    if (root) {
+        print_parameters(params);
+    }
+    if (transport->n_processes() > 1 && !params.cache_path.empty()) {
+        // one cache file per rank; a rank reuses its own results on restart
+        params.cache_path += "." + std::to_string(transport->process());
+    }
+    if (transport->n_processes() > 1 && !params.telemetry_path.empty()) {
+        params.telemetry_path = telemetry_path_for_process(params.telemetry_path, transport->process());
+    }
+    const auto telemetry =
+        params.telemetry_path.empty() ? nullptr : std::make_unique<TelemetryReport>(params.telemetry_path);
+
+    const auto base = make_problem(params);
+    // all islands of this process share one cache, sized for all of their budgets
+    const auto cached = params.evaluation_cache
+                            ? std::make_unique<CachedProblem>(*base, params, transport->n_local(params.islands))
+                            : nullptr;
+    const Problem &problem = cached ? static_cast<const Problem &>(*cached) : *base;
+    const auto evaluator = make_evaluator(params);
+    IslandModel model(params, problem, *evaluator, *transport);
+    model.set_telemetry(telemetry.get());
+    model.run();
+
+    const auto front = model.gather_front();
+    if (root) {
+        std::cout << "\nIsland model after " << params.max_generations << " generations on "
+                  << transport->n_processes() << " process(es): " << front.size()
+                  << " non-dominated individuals over " << params.islands << " islands" << '\n';
+        std::cout << "-----------------------------------------------------" << '\n';
+        for (std::size_t i = 0; i < std::min<std::size_t>(front.size(), 5); ++i) {
+            std::cout << "Objectives: " << std::fixed << std::setprecision(6) << front.objectives()(i, 0) << ", "
+                      << front.objectives()(i, 1) << '\n';
+        }
+        print_cache_stats(cached.get());
+        print_fluent_stats(*base);
+    }
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv) {
     try {
-        const auto params = load_default_parameters();
+        const auto params = argc > 1 ? load_parameters_from_file(argv[1]) : load_default_parameters();
+        if (params.islands > 1) {
+            return run_islands(params, argc, argv);
+        }
         print_parameters(params);
 
         const auto population = latin_hypercube_population(params);
         print_population_sample(population);
 
-        if (!population.empty()) {
-            const auto objectives = evaluate_zdt4(population.front());
+        if (!population.empty() && params.problem == "zdt4") {
+            const auto objectives = evaluate_zdt4(population.row(0));
             std::cout << "\nZDT4 objectives for first individual: "
                       << std::fixed << std::setprecision(6) << objectives[0] << ", "
                       << objectives[1] << '\n';
         }
+
+        const auto base = make_problem(params);
+        const auto cached = params.evaluation_cache ? std::make_unique<CachedProblem>(*base, params) : nullptr;
+        const Problem &problem = cached ? static_cast<const Problem &>(*cached) : *base;
+        const auto telemetry =
+            params.telemetry_path.empty() ? nullptr : std::make_unique<TelemetryReport>(params.telemetry_path);
+        if (params.steady_state) {
+            SteadyStateNSGA2 algorithm(params, problem);
+            algorithm.set_telemetry(telemetry.get());
+            algorithm.run();
+            const auto &stats = algorithm.stats();
+            print_final_front("Steady-state NSGA-II after " + std::to_string(stats.evaluations) + " evaluations",
+                              algorithm.objectives(), algorithm.rank());
+            std::cout << "Slot utilization: " << std::setprecision(3) << stats.utilization() << ", "
+                      << stats.evaluations_per_slot_hour() << " evaluations per slot-hour" << '\n';
+        } else {
+            const auto evaluator = make_evaluator(params);
+            NSGA2 algorithm(params, problem, *evaluator);
+            algorithm.set_telemetry(telemetry.get());
+            algorithm.run();
+            print_final_front("NSGA-II after " + std::to_string(algorithm.generation()) + " generations",
+                              algorithm.objectives(), algorithm.rank());
+        }
+        print_cache_stats(cached.get());
+        print_fluent_stats(*base);
     } catch (const std::exception &ex) {
         std::cerr << "Failed to initialize NSGA-II parameters: " << ex.what() << '\n';
         return EXIT_FAILURE;
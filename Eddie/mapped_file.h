@@ -0,0 +1,27 @@
+#ifndef EDDIE_MAPPED_FILE_H
+#define EDDIE_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only private mapping of a whole file; empty files map to an empty view. The mapping is
+// page aligned, so blocks stored at aligned file offsets can be used in place.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data() const { return data_; }
+    std::size_t size() const { return size_; }
+    std::string_view view() const { return std::string_view(data_, size_); }
+
+private:
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+#endif // EDDIE_MAPPED_FILE_H
@@ -0,0 +1,172 @@
+#include "migration.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef EDDIE_WITH_MPI
+#include <iterator>
+#include <list>
+
+#include <mpi.h>
+#endif
+
+void LocalMigrationTransport::send(std::size_t target_island, const MigrationMessage &message) {
+    inboxes_.at(target_island).push_back(message);
+}
+
+MigrationMessage LocalMigrationTransport::receive(std::size_t target_island) {
+    auto &inbox = inboxes_.at(target_island);
+    if (inbox.empty()) {
+        // the islands of one process advance in lockstep, so a missing message can never arrive
+        throw std::logic_error("No migrants waiting for island " + std::to_string(target_island));
+    }
+    MigrationMessage message = std::move(inbox.front());
+    inbox.pop_front();
+    return message;
+}
+
+#ifdef EDDIE_WITH_MPI
+
+namespace {
+
+void check(int status, const char *call) {
+    if (status != MPI_SUCCESS) {
+        throw std::runtime_error(std::string(call) + " failed");
+    }
+}
+
+// One MPI rank per process. A message is sent as doubles [source, epoch, rows...] tagged with
+// the target island; sends are non-blocking and their buffers are kept until they complete.
+class MpiMigrationTransport final : public MigrationTransport {
+public:
+    MpiMigrationTransport(std::size_t n_islands, int &argc, char **&argv) {
+        int initialized = 0;
+        check(MPI_Initialized(&initialized), "MPI_Initialized");
+        if (!initialized) {
+            // only the main thread talks to MPI; evaluation threads never do
+            int provided = 0;
+            check(MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided), "MPI_Init_thread");
+            owns_mpi_ = true;
+        }
+
+        int rank = 0;
+        int size = 0;
+        check(MPI_Comm_rank(MPI_COMM_WORLD, &rank), "MPI_Comm_rank");
+        check(MPI_Comm_size(MPI_COMM_WORLD, &size), "MPI_Comm_size");
+        rank_ = static_cast<std::size_t>(rank);
+        size_ = static_cast<std::size_t>(size);
+
+        int *tag_ub = nullptr;
+        int found = 0;
+        check(MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_TAG_UB, &tag_ub, &found), "MPI_Comm_get_attr");
+        if (found && n_islands > static_cast<std::size_t>(*tag_ub)) {
+            throw std::invalid_argument("More islands than MPI message tags");
+        }
+    }
+
+    ~MpiMigrationTransport() override {
+        if (owns_mpi_) {
+            MPI_Finalize();
+        }
+    }
+
+    std::size_t process() const override { return rank_; }
+    std::size_t n_processes() const override { return size_; }
+
+    void send(std::size_t target_island, const MigrationMessage &message) override {
+        reap();
+        pending_.emplace_back();
+        auto &send = pending_.back();
+        send.buffer.reserve(message.rows.size() + 2);
+        send.buffer.push_back(static_cast<double>(message.source));
+        send.buffer.push_back(static_cast<double>(message.epoch));
+        send.buffer.insert(send.buffer.end(), message.rows.begin(), message.rows.end());
+        check(MPI_Isend(send.buffer.data(), static_cast<int>(send.buffer.size()), MPI_DOUBLE,
+                        static_cast<int>(target_island % size_), static_cast<int>(target_island), MPI_COMM_WORLD,
+                        &send.request),
+              "MPI_Isend");
+    }
+
+    MigrationMessage receive(std::size_t target_island) override {
+        reap();
+        MPI_Status status;
+        check(MPI_Probe(MPI_ANY_SOURCE, static_cast<int>(target_island), MPI_COMM_WORLD, &status), "MPI_Probe");
+        int count = 0;
+        check(MPI_Get_count(&status, MPI_DOUBLE, &count), "MPI_Get_count");
+        if (count < 2) {
+            throw std::runtime_error("Malformed migration message");
+        }
+
+        std::vector<double> buffer(static_cast<std::size_t>(count));
+        check(MPI_Recv(buffer.data(), count, MPI_DOUBLE, status.MPI_SOURCE, status.MPI_TAG, MPI_COMM_WORLD,
+                       MPI_STATUS_IGNORE),
+              "MPI_Recv");
+
+        MigrationMessage message;
+        message.source = static_cast<std::size_t>(buffer[0]);
+        message.epoch = static_cast<std::size_t>(buffer[1]);
+        message.rows.assign(buffer.begin() + 2, buffer.end());
+        return message;
+    }
+
+    void gather(const std::vector<double> &local, std::vector<double> &all) override {
+        int count = static_cast<int>(local.size());
+        std::vector<int> counts(rank_ == 0 ? size_ : 0);
+        check(MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, MPI_COMM_WORLD), "MPI_Gather");
+
+        std::vector<int> offsets(counts.size());
+        std::size_t total = 0;
+        for (std::size_t p = 0; p < counts.size(); ++p) {
+            offsets[p] = static_cast<int>(total);
+            total += static_cast<std::size_t>(counts[p]);
+        }
+        all.assign(total, 0.0);
+        check(MPI_Gatherv(local.data(), count, MPI_DOUBLE, all.data(), counts.data(), offsets.data(), MPI_DOUBLE, 0,
+                          MPI_COMM_WORLD),
+              "MPI_Gatherv");
+    }
+
+    void progress() override { reap(); }
+
+    void finish() override {
+        for (auto &send : pending_) {
+            check(MPI_Wait(&send.request, MPI_STATUS_IGNORE), "MPI_Wait");
+        }
+        pending_.clear();
+    }
+
+private:
+    struct PendingSend {
+        std::vector<double> buffer{};
+        MPI_Request request = MPI_REQUEST_NULL;
+    };
+
+    // Frees the buffers of completed sends; testing also lets MPI progress the others.
+    void reap() {
+        for (auto it = pending_.begin(); it != pending_.end();) {
+            int done = 0;
+            check(MPI_Test(&it->request, &done, MPI_STATUS_IGNORE), "MPI_Test");
+            it = done ? pending_.erase(it) : std::next(it);
+        }
+    }
+
+    std::size_t rank_ = 0;
+    std::size_t size_ = 1;
+    bool owns_mpi_ = false;
+    std::list<PendingSend> pending_{};
+};
+
+} // namespace
+
+std::unique_ptr<MigrationTransport> make_migration_transport(std::size_t n_islands, int &argc, char **&argv) {
+    return std::make_unique<MpiMigrationTransport>(n_islands, argc, argv);
+}
+
+#else
+
+std::unique_ptr<MigrationTransport> make_migration_transport(std::size_t n_islands, int &, char **&) {
+    return std::make_unique<LocalMigrationTransport>(n_islands);
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef EDDIE_MIGRATION_H
+#define EDDIE_MIGRATION_H
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Migrants sent by island `source` at migration `epoch`: rows of decision variables followed by
+// objectives, in the layout of `NSGA2::emigrants`.
+struct MigrationMessage {
+    std::size_t source = 0;
+    std::size_t epoch = 0;
+    std::vector<double> rows{};
+};
+
+// Delivers migrants between islands, which are spread over one or more processes: island i lives
+// on process i % n_processes(). `send` returns immediately, so messages travel while the sender
+// goes on evaluating; `receive` waits for the next message addressed to a local island.
+class MigrationTransport {
+public:
+    virtual ~MigrationTransport() = default;
+
+    virtual std::size_t process() const = 0;
+    virtual std::size_t n_processes() const = 0;
+
+    virtual void send(std::size_t target_island, const MigrationMessage &message) = 0;
+    virtual MigrationMessage receive(std::size_t target_island) = 0;
+
+    // Concatenates `local` of every process, in process order, into `all` on process 0.
+    virtual void gather(const std::vector<double> &local, std::vector<double> &all) = 0;
+
+    // Gives pending sends a chance to advance; called once per generation.
+    virtual void progress() {}
+
+    // Waits until every message sent from this process has left its buffer.
+    virtual void finish() = 0;
+
+    bool is_local(std::size_t island) const { return island % n_processes() == process(); }
+
+    // Number of the islands [0, n_islands) that live on this process.
+    std::size_t n_local(std::size_t n_islands) const {
+        return n_islands / n_processes() + (process() < n_islands % n_processes() ? 1 : 0);
+    }
+};
+
+// All islands in this process; messages are queued in memory per target island.
+class LocalMigrationTransport final : public MigrationTransport {
+public:
+    explicit LocalMigrationTransport(std::size_t n_islands) : inboxes_(n_islands) {}
+
+    std::size_t process() const override { return 0; }
+    std::size_t n_processes() const override { return 1; }
+
+    void send(std::size_t target_island, const MigrationMessage &message) override;
+    MigrationMessage receive(std::size_t target_island) override;
+    void gather(const std::vector<double> &local, std::vector<double> &all) override { all = local; }
+    void finish() override {}
+
+private:
+    std::vector<std::deque<MigrationMessage>> inboxes_;
+};
+
+// MPI transport when built with `make MPI=1` (EDDIE_WITH_MPI), the local one otherwise. The MPI
+// version initializes MPI if the caller has not and finalizes it on destruction.
+std::unique_ptr<MigrationTransport> make_migration_transport(std::size_t n_islands, int &argc, char **&argv);
+
+#endif // EDDIE_MIGRATION_H
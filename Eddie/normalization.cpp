@@ -0,0 +1,68 @@
+#include "normalization.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+template <typename Better>
+void column_arg(const double *X, std::size_t n, std::size_t m, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride,
+                int *out, Better better) {
+    for (std::size_t j = 0; j < m; ++j) {
+        const double *column = X + static_cast<std::ptrdiff_t>(j) * col_stride;
+        std::size_t best = 0;
+        for (std::size_t i = 1; i < n; ++i) {
+            if (better(column[static_cast<std::ptrdiff_t>(i) * row_stride],
+                       column[static_cast<std::ptrdiff_t>(best) * row_stride])) {
+                best = i;
+            }
+        }
+        out[j] = static_cast<int>(best);
+    }
+}
+
+} // namespace
+
+void column_argmin(const double *X, std::size_t n, std::size_t m, std::ptrdiff_t row_stride,
+                   std::ptrdiff_t col_stride, int *argmin) {
+    column_arg(X, n, m, row_stride, col_stride, argmin, [](double a, double b) { return a < b; });
+}
+
+void column_argmax(const double *X, std::size_t n, std::size_t m, std::ptrdiff_t row_stride,
+                   std::ptrdiff_t col_stride, int *argmax) {
+    column_arg(X, n, m, row_stride, col_stride, argmax, [](double a, double b) { return a > b; });
+}
+
+void normalize_columns(double *X, std::size_t n, std::size_t m, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride,
+                       const int *argmin, const int *argmax) {
+    std::vector<double> low(m);
+    std::vector<double> scale(m);
+    for (std::size_t j = 0; j < m; ++j) {
+        const double *column = X + static_cast<std::ptrdiff_t>(j) * col_stride;
+        low[j] = column[argmin[j] * row_stride];
+        const double diff = column[argmax[j] * row_stride] - low[j];
+        scale[j] = diff == 0.0 ? 1.0 : diff;
+    }
+
+    // row by row, so a C-contiguous X is read sequentially
+    for (std::size_t i = 0; i < n; ++i) {
+        double *row = X + static_cast<std::ptrdiff_t>(i) * row_stride;
+        for (std::size_t j = 0; j < m; ++j) {
+            double &x = row[static_cast<std::ptrdiff_t>(j) * col_stride];
+            x = (x - low[j]) / scale[j];
+        }
+    }
+}
+
+void row_norms(const double *X, std::size_t n, std::size_t m, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride,
+               double *out) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const double *row = X + static_cast<std::ptrdiff_t>(i) * row_stride;
+        double sum = 0.0;
+        for (std::size_t j = 0; j < m; ++j) {
+            const double x = row[static_cast<std::ptrdiff_t>(j) * col_stride];
+            sum += x * x;
+        }
+        out[i] = std::sqrt(sum);
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef EDDIE_NORMALIZATION_H
+#define EDDIE_NORMALIZATION_H
+
+#include <cstddef>
+
+// Column extremes, normalization and row norms of a strided n x m matrix: element (i, j) is at
+// X[i * row_stride + j * col_stride], strides in elements, so numpy views are used in place.
+// Part of the Eddie core library; the compiled pymoo modules use them through utils.pxd
+// (calc_mnn, calc_2nn, calc_pcd) and decomposition.pyx instead of compiling a copy each.
+
+// argmin[j] / argmax[j] = first row of the smallest / largest value of column j.
+void column_argmin(const double *X, std::size_t n, std::size_t m, std::ptrdiff_t row_stride,
+                   std::ptrdiff_t col_stride, int *argmin);
+void column_argmax(const double *X, std::size_t n, std::size_t m, std::ptrdiff_t row_stride,
+                   std::ptrdiff_t col_stride, int *argmax);
+
+// Scales column j in place to X[argmin[j], j] -> 0 and X[argmax[j], j] -> 1; columns whose two
+// extremes are equal are only shifted.
+void normalize_columns(double *X, std::size_t n, std::size_t m, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride,
+                       const int *argmin, const int *argmax);
+
+// out[i] = |X_i|, the Euclidean norm of row i.
+void row_norms(const double *X, std::size_t n, std::size_t m, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride,
+               double *out);
+
+#endif // EDDIE_NORMALIZATION_H
@@ -0,0 +1,282 @@
+#include "nsga2.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "initpop.h"
+#include "island.h"
+#include "operators.h"
+#include "telemetry.h"
+#include "telemetry_report.h"
+
+NSGA2::NSGA2(const OptimizationParameters &params, const Problem &problem, Evaluator &evaluator)
+    : params_(params), problem_(problem), evaluator_(evaluator), rng_(params.random_seed),
+      diversity_(parse_diversity(params.diversity)) {
+    if (params_.population_size == 0) {
+        throw std::invalid_argument("NSGA-II requires a positive population size");
+    }
+    if (problem_.n_constr() != 0) {
+        throw std::invalid_argument("NSGA-II does not support constrained problems yet");
+    }
+
+    dimension_ = decision_dimension(params_);
+    if (dimension_ != problem_.n_var()) {
+        throw std::invalid_argument("Number of design variables does not match the problem");
+    }
+    decision_bounds(params_, lower_, upper_);
+    if (params_.prescreen_factor == 0) {
+        throw std::invalid_argument("prescreen_factor must be at least 1");
+    }
+}
+
+void NSGA2::initialize() {
+    population_ = latin_hypercube_population(params_, rng_);
+    n_obj_ = problem_.n_obj();
+    {
+        EDDIE_TELEMETRY_SCOPE(evaluation);
+        evaluator_.evaluate(problem_, population_, objectives_, constraints_);
+    }
+
+    reserve_buffers();
+    if (prescreener_) {
+        prescreener_->observe(population_, objectives_);
+    }
+    survive(population_, objectives_);
+
+    generation_ = 0;
+    initialized_ = true;
+}
+
+void NSGA2::reserve_buffers() {
+    const std::size_t mu = params_.population_size;
+    const std::size_t lambda = params_.offspring_population_size;
+    // the merged buffers also take the (mu + migrants) survival of immigrate
+    const std::size_t merged = mu + std::max(lambda, max_immigrants());
+
+    // two rows of headroom so odd offspring counts can still produce full SBX pairs
+    offspring_.reserve((lambda + 1) * dimension_);
+    offspring_objectives_.reserve((lambda + 1) * n_obj_);
+    merged_.reserve(merged * dimension_);
+    merged_objectives_.reserve(merged * n_obj_);
+    population_.reserve(mu * dimension_);
+    objectives_.reserve(mu * n_obj_);
+    next_population_.reserve(mu * dimension_);
+    next_objectives_.reserve(mu * n_obj_);
+
+    rank_.reserve(mu);
+    crowding_.reserve(mu);
+    survival_workspace_.reserve(merged, n_obj_);
+    survivors_.reserve(mu);
+    first_front_.reserve(mu);
+
+    if (params_.prescreen_factor > 1) {
+        const std::size_t pool = params_.prescreen_factor * lambda;
+        candidates_.reserve((pool + 1) * dimension_);
+        prescreener_ = std::make_unique<SurrogatePrescreener>(params_, lower_, upper_, n_obj_);
+    }
+}
+
+void NSGA2::step() {
+    if (!initialized_) {
+        initialize();
+    }
+
+    const std::size_t lambda = params_.offspring_population_size;
+    if (prescreener_) {
+        {
+            EDDIE_TELEMETRY_SCOPE(variation);
+            make_offspring(candidates_, params_.prescreen_factor * lambda);
+        }
+        EDDIE_TELEMETRY_SCOPE(prescreening);
+        prescreener_->select(candidates_, lambda, offspring_);
+    } else {
+        EDDIE_TELEMETRY_SCOPE(variation);
+        make_offspring(offspring_, lambda);
+    }
+    {
+        EDDIE_TELEMETRY_SCOPE(evaluation);
+        evaluator_.evaluate(problem_, offspring_, offspring_objectives_, constraints_);
+    }
+    if (prescreener_) {
+        EDDIE_TELEMETRY_SCOPE(prescreening);
+        prescreener_->observe(offspring_, offspring_objectives_);
+    }
+    merge_parents_and_offspring();
+    survive(merged_, merged_objectives_);
+
+    ++generation_;
+}
+
+void NSGA2::run() {
+    std::unique_ptr<CheckpointWriter> writer;
+    if (!params_.checkpoint_path.empty()) {
+        if (!initialized_ && checkpoint_exists(params_.checkpoint_path)) {
+            restore(CheckpointView(params_.checkpoint_path));
+        }
+        writer = std::make_unique<CheckpointWriter>(params_.checkpoint_path);
+    }
+
+    if (!initialized_) {
+        initialize();
+        if (telemetry_ != nullptr) {
+            telemetry_->record(generation_);
+        }
+    }
+    while (generation_ < params_.max_generations) {
+        step();
+        if (telemetry_ != nullptr) {
+            telemetry_->record(generation_);
+        }
+        const bool periodic = params_.checkpoint_interval != 0 && generation_ % params_.checkpoint_interval == 0;
+        if (writer && (periodic || generation_ == params_.max_generations)) {
+            checkpoint(*writer);
+        }
+    }
+
+    if (writer) {
+        writer->flush();
+    }
+}
+
+void NSGA2::restore(const CheckpointView &checkpoint) {
+    n_obj_ = problem_.n_obj();
+    if (checkpoint.rows() != params_.population_size || checkpoint.n_var() != dimension_ ||
+        checkpoint.n_obj() != n_obj_) {
+        throw std::invalid_argument("Checkpoint does not match the population size or problem dimensions");
+    }
+
+    const auto x = checkpoint.population();
+    const auto f = checkpoint.objectives();
+    population_.resize(checkpoint.rows(), dimension_);
+    objectives_.resize(checkpoint.rows(), n_obj_);
+    std::copy(x.begin(), x.end(), population_.data());
+    std::copy(f.begin(), f.end(), objectives_.data());
+    reserve_buffers();
+
+    const auto rank = checkpoint.rank();
+    const auto crowding = checkpoint.crowding();
+    rank_.assign(rank.begin(), rank.end());
+    crowding_.assign(crowding.begin(), crowding.end());
+    checkpoint.restore_rng(rng_);
+    if (prescreener_) {
+        prescreener_->observe(population_, objectives_);
+    }
+
+    generation_ = checkpoint.generation();
+    initialized_ = true;
+}
+
+std::size_t NSGA2::max_immigrants() const {
+    if (params_.islands < 2 || params_.migrants == 0) {
+        return 0;
+    }
+    // every island of a topology receives from the same number of sources
+    const MigrationTopology topology = parse_migration_topology(params_.migration_topology);
+    return params_.migrants * migration_sources(topology, 0, params_.islands).size();
+}
+
+void NSGA2::checkpoint(CheckpointWriter &writer) const {
+    writer.submit(generation_, population_, objectives_, rank(), crowding(), rng_);
+}
+
+std::size_t NSGA2::emigrants(std::size_t count, std::vector<double> &out) const {
+    auto &first = first_front_;
+    first.clear();
+    for (std::size_t i = 0; i < rank_.size(); ++i) {
+        if (rank_[i] == 0) {
+            first.push_back(i);
+        }
+    }
+    count = std::min(count, first.size());
+    std::partial_sort(first.begin(), first.begin() + count, first.end(),
+                      [&](std::size_t a, std::size_t b) { return crowding_[a] > crowding_[b]; });
+
+    for (std::size_t m = 0; m < count; ++m) {
+        const auto x = population_.row(first[m]);
+        const auto f = objectives_.row(first[m]);
+        out.insert(out.end(), x.begin(), x.end());
+        out.insert(out.end(), f.begin(), f.end());
+    }
+    return count;
+}
+
+void NSGA2::immigrate(Span<const double> rows) {
+    const std::size_t width = dimension_ + n_obj_;
+    if (!initialized_ || rows.size() % width != 0) {
+        throw std::invalid_argument("Immigrants do not match the problem dimensions");
+    }
+    const std::size_t mu = population_.rows();
+    const std::size_t count = rows.size() / width;
+
+    merged_.resize(mu + count, dimension_);
+    merged_objectives_.resize(mu + count, n_obj_);
+    std::copy(population_.data(), population_.data() + population_.size(), merged_.data());
+    std::copy(objectives_.data(), objectives_.data() + objectives_.size(), merged_objectives_.data());
+    for (std::size_t m = 0; m < count; ++m) {
+        const double *row = rows.data() + m * width;
+        std::copy(row, row + dimension_, merged_.row(mu + m).data());
+        std::copy(row + dimension_, row + width, merged_objectives_.row(mu + m).data());
+    }
+    if (prescreener_) {
+        prescreener_->observe(merged_, merged_objectives_, mu);
+    }
+    survive(merged_, merged_objectives_);
+}
+
+void NSGA2::make_offspring(PopulationMatrix &offspring, std::size_t lambda) {
+    const Span<const double> lower(lower_.data(), lower_.size());
+    const Span<const double> upper(upper_.data(), upper_.size());
+    const Span<const std::size_t> parent_rank = rank();
+    const Span<const double> parent_crowding = crowding();
+
+    // an odd lambda leaves the second child of the last pair in the spare row past the end
+    offspring.resize(lambda + (lambda % 2), dimension_);
+    for (std::size_t i = 0; i < lambda; i += 2) {
+        const std::size_t a = binary_tournament(parent_rank, parent_crowding, rng_);
+        const std::size_t b = binary_tournament(parent_rank, parent_crowding, rng_);
+
+        sbx_crossover(population_.row(a), population_.row(b), offspring.row(i), offspring.row(i + 1),
+                      lower, upper, params_.distribution_index_crossover, params_.crossover_probability, rng_);
+        polynomial_mutation(offspring.row(i), lower, upper, params_.distribution_index_mutation,
+                            params_.mutation_probability, rng_);
+        polynomial_mutation(offspring.row(i + 1), lower, upper, params_.distribution_index_mutation,
+                            params_.mutation_probability, rng_);
+    }
+    offspring.resize(lambda, dimension_);
+}
+
+void NSGA2::merge_parents_and_offspring() {
+    const std::size_t mu = population_.rows();
+    const std::size_t lambda = offspring_.rows();
+
+    merged_.resize(mu + lambda, dimension_);
+    merged_objectives_.resize(mu + lambda, n_obj_);
+    std::copy(population_.data(), population_.data() + population_.size(), merged_.data());
+    std::copy(offspring_.data(), offspring_.data() + offspring_.size(), merged_.data() + population_.size());
+    std::copy(objectives_.data(), objectives_.data() + objectives_.size(), merged_objectives_.data());
+    std::copy(offspring_objectives_.data(), offspring_objectives_.data() + offspring_objectives_.size(),
+              merged_objectives_.data() + objectives_.size());
+}
+
+void NSGA2::survive(const PopulationMatrix &candidates, const ObjectiveMatrix &candidate_objectives) {
+    const std::size_t n_survive = std::min(params_.population_size, candidates.rows());
+
+    // ranks only the fronts that fill the survivors and truncates the split front by diversity
+    survivors_.resize(n_survive);
+    rank_.resize(n_survive);
+    crowding_.resize(n_survive);
+    ::survive(candidate_objectives.data(), candidate_objectives.rows(), n_obj_, n_survive, diversity_, nullptr,
+              survival_workspace_, survivors_.data(), rank_.data(), crowding_.data());
+
+    next_population_.resize(n_survive, dimension_);
+    next_objectives_.resize(n_survive, n_obj_);
+    for (std::size_t i = 0; i < n_survive; ++i) {
+        next_population_.copy_row_from(candidates, survivors_[i], i);
+        next_objectives_.copy_row_from(candidate_objectives, survivors_[i], i);
+    }
+
+    std::swap(population_, next_population_);
+    std::swap(objectives_, next_objectives_);
+}
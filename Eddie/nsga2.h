@@ -0,0 +1,115 @@
+#ifndef EDDIE_NSGA2_H
+#define EDDIE_NSGA2_H
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "checkpoint.h"
+#include "evaluator.h"
+#include "parameter.h"
+#include "population.h"
+#include "surrogate.h"
+#include "survival.h"
+
+class TelemetryReport;
+
+// Generational NSGA-II (Deb et al., 2002) driven by `OptimizationParameters`.
+//
+// Survival runs the fused rank / diversity / truncation pass of survival.h with the metric named
+// by `params.diversity`. Every buffer used by a generation (offspring, merged parents + offspring,
+// survival workspace) is sized in `initialize()` and reused afterwards, so `step()` performs no
+// heap allocation as long as the evaluator itself does not allocate.
+// With `prescreen_factor` > 1, variation breeds that many candidates per offspring and a
+// `SurrogatePrescreener` trained on every evaluated individual picks the ones to evaluate; its
+// surrogate grows with the evaluations, which is then the one allocation of `step()`.
+// Constraint handling is not implemented yet, so problems must be unconstrained.
+class NSGA2 {
+public:
+    NSGA2(const OptimizationParameters &params, const Problem &problem, Evaluator &evaluator);
+
+    // Samples the initial population with a Latin hypercube and ranks it.
+    void initialize();
+
+    // Runs one generation: variation, evaluation of the offspring and (mu + lambda) survival.
+    void step();
+
+    // Initializes if necessary and iterates until `max_generations` is reached. With a
+    // `checkpoint_path`, an existing checkpoint is resumed first and a new one is written
+    // asynchronously every `checkpoint_interval` generations and after the last one.
+    void run();
+
+    // Continues from a checkpoint written by `checkpoint()` for the same parameters; the run
+    // then proceeds exactly as the uninterrupted one would have. The surrogate of pre-screening
+    // is not checkpointed but retrained from the restored population, so with pre-screening the
+    // resumed run differs from the uninterrupted one.
+    void restore(const CheckpointView &checkpoint);
+
+    // Makes `run()` write a row to `report` after initialization and after every generation.
+    void set_telemetry(TelemetryReport *report) { telemetry_ = report; }
+
+    // Hands the current generation to `writer`; only copies, the file is written in the background.
+    void checkpoint(CheckpointWriter &writer) const;
+
+    // Appends up to `count` first-front individuals, those with the largest crowding first, to
+    // `out` as rows of the decision variables followed by the objectives; returns how many.
+    std::size_t emigrants(std::size_t count, std::vector<double> &out) const;
+
+    // Merges evaluated individuals in the row layout of `emigrants` into the population with a
+    // (mu + migrants) survival, so the population size is kept.
+    void immigrate(Span<const double> rows);
+
+    std::size_t generation() const { return generation_; }
+    const PopulationMatrix &population() const { return population_; }
+    const ObjectiveMatrix &objectives() const { return objectives_; }
+    Span<const std::size_t> rank() const { return Span<const std::size_t>(rank_.data(), rank_.size()); }
+    Span<const double> crowding() const { return Span<const double>(crowding_.data(), crowding_.size()); }
+
+private:
+    void reserve_buffers();
+    // Most rows one immigrate merges: the migrants of all islands this one receives from.
+    std::size_t max_immigrants() const;
+    void make_offspring(PopulationMatrix &offspring, std::size_t count);
+    void merge_parents_and_offspring();
+    void survive(const PopulationMatrix &candidates, const ObjectiveMatrix &candidate_objectives);
+
+    OptimizationParameters params_;
+    const Problem &problem_;
+    Evaluator &evaluator_;
+    std::mt19937 rng_;
+    Diversity diversity_;
+    TelemetryReport *telemetry_ = nullptr;
+
+    std::size_t dimension_ = 0;
+    std::size_t n_obj_ = 0;
+    std::size_t generation_ = 0;
+    bool initialized_ = false;
+
+    std::vector<double> lower_{};
+    std::vector<double> upper_{};
+
+    PopulationMatrix population_{};
+    ObjectiveMatrix objectives_{};
+    std::vector<std::size_t> rank_{};
+    std::vector<double> crowding_{};
+
+    std::unique_ptr<SurrogatePrescreener> prescreener_{};
+    PopulationMatrix candidates_{};
+
+    PopulationMatrix offspring_{};
+    ObjectiveMatrix offspring_objectives_{};
+    ConstraintMatrix constraints_{};
+
+    PopulationMatrix merged_{};
+    ObjectiveMatrix merged_objectives_{};
+
+    PopulationMatrix next_population_{};
+    ObjectiveMatrix next_objectives_{};
+
+    SurvivalWorkspace survival_workspace_{};
+    std::vector<std::size_t> survivors_{};
+    mutable std::vector<std::size_t> first_front_{};  // scratch of emigrants
+};
+
+#endif // EDDIE_NSGA2_H
@@ -0,0 +1,115 @@
+#include "operators.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+constexpr double sbx_epsilon = 1.0e-14;
+
+double unit_random(std::mt19937 &rng) {
+    return std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+}
+
+double sbx_spread(double beta, double u, double distribution_index) {
+    const double exponent = 1.0 / (distribution_index + 1.0);
+    const double alpha = 2.0 - std::pow(beta, -(distribution_index + 1.0));
+    if (u <= 1.0 / alpha) {
+        return std::pow(u * alpha, exponent);
+    }
+    return std::pow(1.0 / (2.0 - u * alpha), exponent);
+}
+}
+
+std::size_t binary_tournament(Span<const std::size_t> rank, Span<const double> crowding, std::mt19937 &rng) {
+    std::uniform_int_distribution<std::size_t> pick(0, rank.size() - 1);
+    const std::size_t a = pick(rng);
+    const std::size_t b = pick(rng);
+
+    if (rank[a] != rank[b]) {
+        return rank[a] < rank[b] ? a : b;
+    }
+    return crowding[b] > crowding[a] ? b : a;
+}
+
+void sbx_crossover(Span<const double> parent_a,
+                   Span<const double> parent_b,
+                   Span<double> child_a,
+                   Span<double> child_b,
+                   Span<const double> lower,
+                   Span<const double> upper,
+                   double distribution_index,
+                   double probability,
+                   std::mt19937 &rng) {
+    std::copy(parent_a.begin(), parent_a.end(), child_a.begin());
+    std::copy(parent_b.begin(), parent_b.end(), child_b.begin());
+
+    if (unit_random(rng) > probability) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < parent_a.size(); ++i) {
+        if (unit_random(rng) > 0.5 || std::fabs(parent_a[i] - parent_b[i]) <= sbx_epsilon) {
+            continue;
+        }
+
+        const double y1 = std::min(parent_a[i], parent_b[i]);
+        const double y2 = std::max(parent_a[i], parent_b[i]);
+        const double yl = lower[i];
+        const double yu = upper[i];
+        const double u = unit_random(rng);
+
+        const double beta_low = 1.0 + 2.0 * (y1 - yl) / (y2 - y1);
+        double c1 = 0.5 * ((y1 + y2) - sbx_spread(beta_low, u, distribution_index) * (y2 - y1));
+
+        const double beta_high = 1.0 + 2.0 * (yu - y2) / (y2 - y1);
+        double c2 = 0.5 * ((y1 + y2) + sbx_spread(beta_high, u, distribution_index) * (y2 - y1));
+
+        c1 = std::clamp(c1, yl, yu);
+        c2 = std::clamp(c2, yl, yu);
+        if (unit_random(rng) <= 0.5) {
+            std::swap(c1, c2);
+        }
+
+        child_a[i] = c1;
+        child_b[i] = c2;
+    }
+}
+
+void polynomial_mutation(Span<double> individual,
+                         Span<const double> lower,
+                         Span<const double> upper,
+                         double distribution_index,
+                         double probability,
+                         std::mt19937 &rng) {
+    const double exponent = 1.0 / (distribution_index + 1.0);
+
+    for (std::size_t i = 0; i < individual.size(); ++i) {
+        if (unit_random(rng) > probability) {
+            continue;
+        }
+
+        const double yl = lower[i];
+        const double yu = upper[i];
+        if (yu <= yl) {
+            continue;
+        }
+
+        const double y = individual[i];
+        const double range = yu - yl;
+        const double r = unit_random(rng);
+
+        double delta_q = 0.0;
+        if (r < 0.5) {
+            const double xy = 1.0 - (y - yl) / range;
+            const double val = 2.0 * r + (1.0 - 2.0 * r) * std::pow(xy, distribution_index + 1.0);
+            delta_q = std::pow(val, exponent) - 1.0;
+        } else {
+            const double xy = 1.0 - (yu - y) / range;
+            const double val = 2.0 * (1.0 - r) + 2.0 * (r - 0.5) * std::pow(xy, distribution_index + 1.0);
+            delta_q = 1.0 - std::pow(val, exponent);
+        }
+
+        individual[i] = std::clamp(y + delta_q * range, yl, yu);
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef EDDIE_OPERATORS_H
+#define EDDIE_OPERATORS_H
+
+#include <cstddef>
+#include <random>
+
+#include "population.h"
+
+// Binary tournament on (rank, crowding): lower rank wins, ties go to the larger crowding distance.
+std::size_t binary_tournament(Span<const std::size_t> rank, Span<const double> crowding, std::mt19937 &rng);
+
+// Simulated binary crossover (Deb & Agrawal, 1995) with bounded spread. Children are written in
+// place; with probability 1 - `probability` they are plain copies of the parents.
+void sbx_crossover(Span<const double> parent_a,
+                   Span<const double> parent_b,
+                   Span<double> child_a,
+                   Span<double> child_b,
+                   Span<const double> lower,
+                   Span<const double> upper,
+                   double distribution_index,
+                   double probability,
+                   std::mt19937 &rng);
+
+// Polynomial mutation (Deb & Goyal, 1996); each variable mutates with `probability`.
+void polynomial_mutation(Span<double> individual,
+                         Span<const double> lower,
+                         Span<const double> upper,
+                         double distribution_index,
+                         double probability,
+                         std::mt19937 &rng);
+
+#endif // EDDIE_OPERATORS_H
@@ -0,0 +1,51 @@
+#ifndef EDDIE_PARALLEL_H
+#define EDDIE_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Tile-parallel loops shared by the header-only kernels (ranking.h, decomposition.h).
+//
+// Header-only and free of other Eddie dependencies so the compiled pymoo modules can share it.
+
+// Number of threads to use for `work` units when every thread should get at least
+// `min_work_per_thread` of them; n_threads = 0 means all cores.
+inline std::size_t resolve_thread_count(std::size_t n_threads, std::size_t work, std::size_t min_work_per_thread) {
+    if (n_threads == 0) {
+        n_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    return std::max<std::size_t>(1, std::min(n_threads, work / std::max<std::size_t>(min_work_per_thread, 1)));
+}
+
+// Calls work(tile, thread) for every tile in [0, n_tiles), handing tiles out in increasing order
+// to whichever of the n_threads threads is free. The calling thread is thread 0.
+template <typename Work>
+void parallel_for_tiles(std::size_t n_tiles, std::size_t n_threads, Work work) {
+    if (n_threads <= 1) {
+        for (std::size_t tile = 0; tile < n_tiles; ++tile) {
+            work(tile, 0);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    const auto loop = [&next, n_tiles, &work](std::size_t thread) {
+        for (std::size_t tile = next++; tile < n_tiles; tile = next++) {
+            work(tile, thread);
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(n_threads - 1);
+    for (std::size_t t = 1; t < n_threads; ++t) {
+        workers.emplace_back(loop, t);
+    }
+    loop(0);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+#endif // EDDIE_PARALLEL_H
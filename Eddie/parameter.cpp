@@ -0,0 +1,307 @@
+#include "parameter.h"
+
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+#include "mapped_file.h"
+#include "telemetry.h"
+
+namespace {
+
+// Single forward pass over the mapped text. Tokens are string_views into the mapping; the only
+// allocations are the final values stored in OptimizationParameters.
+class ConfigParser {
+public:
+    ConfigParser(std::string_view text, const std::string &path)
+        : cursor_(text.data()), end_(text.data() + text.size()), path_(path) {}
+
+    void parse(OptimizationParameters &params) {
+        while (true) {
+            skip_blank_lines();
+            if (cursor_ == end_) {
+                return;
+            }
+
+            const std::string_view key = identifier();
+            skip_spaces();
+            expect('=');
+            skip_spaces();
+            assign(key, params);
+            end_of_line();
+        }
+    }
+
+private:
+    [[noreturn]] void fail(const std::string &message) const {
+        throw std::runtime_error(path_ + ":" + std::to_string(line_) + ": " + message);
+    }
+
+    static bool is_space(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    static bool is_identifier(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    void skip_spaces() {
+        while (cursor_ != end_ && is_space(*cursor_)) {
+            ++cursor_;
+        }
+    }
+
+    void skip_comment() {
+        if (cursor_ != end_ && *cursor_ == '#') {
+            while (cursor_ != end_ && *cursor_ != '\n') {
+                ++cursor_;
+            }
+        }
+    }
+
+    // Whitespace, comments and newlines; arrays may span lines.
+    void skip_blank_lines() {
+        while (true) {
+            skip_spaces();
+            skip_comment();
+            if (cursor_ == end_ || *cursor_ != '\n') {
+                return;
+            }
+            ++cursor_;
+            ++line_;
+        }
+    }
+
+    void end_of_line() {
+        skip_spaces();
+        skip_comment();
+        if (cursor_ != end_) {
+            if (*cursor_ != '\n') {
+                fail("unexpected characters after value");
+            }
+            ++cursor_;
+            ++line_;
+        }
+    }
+
+    void expect(char c) {
+        if (cursor_ == end_ || *cursor_ != c) {
+            fail(std::string("expected '") + c + "'");
+        }
+        ++cursor_;
+    }
+
+    std::string_view identifier() {
+        const char *begin = cursor_;
+        while (cursor_ != end_ && is_identifier(*cursor_)) {
+            ++cursor_;
+        }
+        if (cursor_ == begin) {
+            fail("expected a parameter name");
+        }
+        return std::string_view(begin, static_cast<std::size_t>(cursor_ - begin));
+    }
+
+    // A bare word (up to whitespace, ',', ']' or '#') or a double-quoted string without escapes.
+    std::string_view word() {
+        if (cursor_ != end_ && *cursor_ == '"') {
+            const char *begin = ++cursor_;
+            while (cursor_ != end_ && *cursor_ != '"' && *cursor_ != '\n') {
+                ++cursor_;
+            }
+            if (cursor_ == end_ || *cursor_ != '"') {
+                fail("unterminated string");
+            }
+            return std::string_view(begin, static_cast<std::size_t>(cursor_++ - begin));
+        }
+
+        const char *begin = cursor_;
+        while (cursor_ != end_ && !is_space(*cursor_) && *cursor_ != '\n' && *cursor_ != ',' && *cursor_ != ']' &&
+               *cursor_ != '#') {
+            ++cursor_;
+        }
+        if (cursor_ == begin) {
+            fail("expected a value");
+        }
+        return std::string_view(begin, static_cast<std::size_t>(cursor_ - begin));
+    }
+
+    double number() {
+        double value = 0.0;
+        const char *begin = cursor_ != end_ && *cursor_ == '+' ? cursor_ + 1 : cursor_;
+        const auto result = std::from_chars(begin, end_, value);
+        if (result.ec != std::errc() || result.ptr == begin) {
+            fail("expected a number");
+        }
+        cursor_ = result.ptr;
+        return value;
+    }
+
+    template <typename Integer>
+    Integer integer() {
+        Integer value = 0;
+        const auto result = std::from_chars(cursor_, end_, value);
+        if (result.ec != std::errc() || result.ptr == cursor_) {
+            fail("expected a non-negative integer");
+        }
+        cursor_ = result.ptr;
+        return value;
+    }
+
+    bool boolean() {
+        const std::string_view value = word();
+        if (value == "true" || value == "on" || value == "yes" || value == "1") {
+            return true;
+        }
+        if (value == "false" || value == "off" || value == "no" || value == "0") {
+            return false;
+        }
+        fail("expected true or false");
+    }
+
+    // `[a, b, c]`, optionally spread over several lines with a trailing comma.
+    template <typename ReadElement>
+    void array(ReadElement read_element) {
+        expect('[');
+        while (true) {
+            skip_blank_lines();
+            if (cursor_ != end_ && *cursor_ == ']') {
+                ++cursor_;
+                return;
+            }
+            read_element();
+            skip_blank_lines();
+            if (cursor_ != end_ && *cursor_ == ',') {
+                ++cursor_;
+            } else if (cursor_ == end_ || *cursor_ != ']') {
+                fail("expected ',' or ']' in array");
+            }
+        }
+    }
+
+    void numbers(std::vector<double> &values) {
+        values.clear();
+        array([&] { values.push_back(number()); });
+    }
+
+    void names(std::vector<std::string> &values) {
+        values.clear();
+        array([&] {
+            const std::string_view name = word();
+            values.emplace_back(name.data(), name.size());
+        });
+    }
+
+    void assign(std::string_view key, OptimizationParameters &params) {
+        if (key == "population_size") {
+            params.population_size = integer<std::size_t>();
+        } else if (key == "offspring_population_size") {
+            params.offspring_population_size = integer<std::size_t>();
+        } else if (key == "max_generations") {
+            params.max_generations = integer<std::size_t>();
+        } else if (key == "crossover_probability") {
+            params.crossover_probability = number();
+        } else if (key == "mutation_probability") {
+            params.mutation_probability = number();
+        } else if (key == "distribution_index_crossover") {
+            params.distribution_index_crossover = number();
+        } else if (key == "distribution_index_mutation") {
+            params.distribution_index_mutation = number();
+        } else if (key == "random_seed") {
+            params.random_seed = integer<unsigned int>();
+        } else if (key == "evaluation_threads") {
+            params.evaluation_threads = integer<std::size_t>();
+        } else if (key == "steady_state") {
+            params.steady_state = boolean();
+        } else if (key == "max_in_flight") {
+            params.max_in_flight = integer<std::size_t>();
+        } else if (key == "checkpoint_path") {
+            const std::string_view path = word();
+            params.checkpoint_path.assign(path.data(), path.size());
+        } else if (key == "checkpoint_interval") {
+            params.checkpoint_interval = integer<std::size_t>();
+        } else if (key == "diversity") {
+            const std::string_view name = word();
+            params.diversity.assign(name.data(), name.size());
+        } else if (key == "islands") {
+            params.islands = integer<std::size_t>();
+        } else if (key == "migration_interval") {
+            params.migration_interval = integer<std::size_t>();
+        } else if (key == "migrants") {
+            params.migrants = integer<std::size_t>();
+        } else if (key == "migration_topology") {
+            const std::string_view name = word();
+            params.migration_topology.assign(name.data(), name.size());
+        } else if (key == "evaluation_cache") {
+            params.evaluation_cache = boolean();
+        } else if (key == "cache_path") {
+            const std::string_view path = word();
+            params.cache_path.assign(path.data(), path.size());
+        } else if (key == "cache_resolution") {
+            params.cache_resolution = number();
+        } else if (key == "prescreen_factor") {
+            params.prescreen_factor = integer<std::size_t>();
+        } else if (key == "surrogate_points") {
+            params.surrogate_points = integer<std::size_t>();
+        } else if (key == "surrogate_length_scale") {
+            params.surrogate_length_scale = number();
+        } else if (key == "surrogate_exploration") {
+            params.surrogate_exploration = number();
+        } else if (key == "telemetry_path") {
+            const std::string_view path = word();
+            params.telemetry_path.assign(path.data(), path.size());
+        } else if (key == "problem") {
+            const std::string_view name = word();
+            params.problem.assign(name.data(), name.size());
+        } else if (key == "fluent_command") {
+            names(params.fluent_command);
+        } else if (key == "fluent_journal_template") {
+            const std::string_view path = word();
+            params.fluent_journal_template.assign(path.data(), path.size());
+        } else if (key == "fluent_work_dir") {
+            const std::string_view path = word();
+            params.fluent_work_dir.assign(path.data(), path.size());
+        } else if (key == "fluent_report") {
+            const std::string_view path = word();
+            params.fluent_report.assign(path.data(), path.size());
+        } else if (key == "fluent_report_columns") {
+            params.fluent_report_columns.clear();
+            array([&] { params.fluent_report_columns.push_back(integer<std::size_t>()); });
+        } else if (key == "variable_lower_bounds") {
+            numbers(params.variable_lower_bounds);
+        } else if (key == "variable_upper_bounds") {
+            numbers(params.variable_upper_bounds);
+        } else if (key == "objective_names") {
+            names(params.objective_names);
+        } else if (key == "variable_names") {
+            names(params.variable_names);
+        } else {
+            fail("unknown parameter '" + std::string(key) + "'");
+        }
+    }
+
+    const char *cursor_;
+    const char *end_;
+    const std::string &path_;
+    std::size_t line_ = 1;
+};
+
+} // namespace
+
+OptimizationParameters load_parameters_from_file(const std::string &path) {
+    EDDIE_TELEMETRY_SCOPE(io);
+    const MappedFile file(path);
+    OptimizationParameters params{};
+    ConfigParser(file.view(), path).parse(params);
+
+    // lists left out fall back to decision_bounds() defaults; the ones given must agree
+    std::size_t dimension = 0;
+    for (const std::size_t length : {params.variable_names.size(), params.variable_lower_bounds.size(),
+                                     params.variable_upper_bounds.size()}) {
+        if (length != 0 && dimension != 0 && length != dimension) {
+            throw std::runtime_error(path + ": variable_names, variable_lower_bounds and variable_upper_bounds "
+                                            "must have the same length");
+        }
+        dimension = length != 0 ? length : dimension;
+    }
+    return params;
+}
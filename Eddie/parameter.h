@@ -14,6 +14,30 @@ struct OptimizationParameters {
     double distribution_index_crossover = 15.0;
     double distribution_index_mutation = 20.0;
     unsigned int random_seed = 42U;
+    std::size_t evaluation_threads = 0;   // 0 uses every hardware thread
+    bool steady_state = false;            // asynchronous steady-state mode instead of generations
+    std::size_t max_in_flight = 4;        // concurrent evaluations (solver licenses) in steady-state mode
+    std::string checkpoint_path{};        // empty disables checkpoint/restart
+    std::size_t checkpoint_interval = 10; // generations between checkpoints; 0 writes only the last one
+    std::string diversity = "cd";         // survival metric: "cd" (crowding distance) or "pcd" (pruning)
+    std::size_t islands = 1;              // sub-populations of population_size each; > 1 runs the island model
+    std::size_t migration_interval = 10;  // generations between migrations
+    std::size_t migrants = 5;             // first-front individuals each island sends per migration
+    std::string migration_topology = "ring"; // "ring" (to the next island) or "complete" (to all others)
+    bool evaluation_cache = false;        // answer repeated decision vectors from a cache
+    std::string cache_path{};             // empty keeps the cache in memory; otherwise loaded and appended to
+    double cache_resolution = 1e-9;       // quantization step as a fraction of each variable's range
+    std::size_t prescreen_factor = 1;     // candidates bred per evaluated offspring; > 1 screens them with a surrogate
+    std::size_t surrogate_points = 500;   // evaluated individuals the surrogate holds at most
+    double surrogate_length_scale = 0.0;  // kernel length scale in normalized units; 0 picks sqrt(n_var) / 4
+    double surrogate_exploration = 1.0;   // candidates are ranked by predicted mean - exploration * sd
+    std::string telemetry_path{};         // per-generation .csv, .json(l) or .prom report; needs make TELEMETRY=1
+    std::string problem = "zdt4";         // "zdt4" (built-in benchmark) or "fluent" (external solver runs)
+    std::vector<std::string> fluent_command{"fluent", "3ddp", "-g", "-t1", "-i", "{journal}"}; // solver argv
+    std::string fluent_journal_template{}; // journal text with {placeholders}, rendered per case
+    std::string fluent_work_dir = "fluent_cases"; // one case_<n> directory per evaluation
+    std::string fluent_report = "report.out"; // report file the solver writes in its case directory
+    std::vector<std::size_t> fluent_report_columns{}; // report columns of the objectives; empty takes 1..n_obj
 
     std::vector<double> variable_lower_bounds{};
     std::vector<double> variable_upper_bounds{};
@@ -0,0 +1,287 @@
+#ifndef EDDIE_PARETO_ARCHIVE_H
+#define EDDIE_PARETO_ARCHIVE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "dominance.h"
+
+// Pareto ranking of a changing point set (minimization), updated one point at a time instead
+// of re-sorting. Every point keeps the front index it would get from a full non-dominated sort.
+//
+// Fronts satisfy the ENS invariant: if front k dominates a point, so does every front before it,
+// so the front of a new point is found by binary search over the fronts. Inserting a point
+// pushes the members it dominates one front down, which may cascade; removing one lets the
+// members only it held back move one front up. For two objectives every front is a balanced
+// tree ordered by the first objective (ties by the second), so dominance against a front is a single O(log n)
+// lookup; for more objectives fronts are unordered lists scanned linearly.
+//
+// Header-only and free of other Eddie dependencies (besides dominance.h) so the compiled pymoo
+// module can share it.
+class ParetoArchive {
+public:
+    using Id = std::size_t;
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    explicit ParetoArchive(std::size_t n_obj) : n_obj_(n_obj) {
+        if (n_obj_ == 0) {
+            throw std::invalid_argument("Pareto archive requires at least one objective");
+        }
+    }
+
+    // Adds a point with `n_obj` objectives and returns its id. Ids of removed points are reused.
+    // NaN objectives are rejected: they have no place in the dominance order and would break the
+    // ordering of the two-objective trees. Infinities (failed evaluations) are fine.
+    Id insert(const double *f) {
+        for (std::size_t k = 0; k < n_obj_; ++k) {
+            if (f[k] != f[k]) {
+                throw std::invalid_argument("Pareto archive objectives must not be NaN");
+            }
+        }
+        Id id;
+        if (!free_ids_.empty()) {
+            id = free_ids_.back();
+            free_ids_.pop_back();
+        } else {
+            id = rank_.size();
+            rank_.push_back(npos);
+            position_.push_back(0);
+            stamp_.push_back(0);
+            objectives_.resize(objectives_.size() + n_obj_);
+        }
+        std::copy(f, f + n_obj_, objectives_.begin() + static_cast<std::ptrdiff_t>(id * n_obj_));
+        ++size_;
+
+        std::size_t k = locate(objectives(id));
+        moved_.assign(1, id);
+        while (!moved_.empty()) {
+            if (k == fronts_.size()) {
+                fronts_.emplace_back();
+            }
+
+            // members of front k dominated by the arrivals drop to front k + 1
+            next_.clear();
+            ++epoch_;
+            for (const Id m : moved_) {
+                collect_dominated(k, objectives(m), next_);
+            }
+            for (const Id q : next_) {
+                erase(k, q);
+            }
+            for (const Id m : moved_) {
+                put(k, m);
+            }
+            moved_.swap(next_);
+            ++k;
+        }
+        return id;
+    }
+
+    void remove(Id id) {
+        const std::size_t k = rank(id);
+        erase(k, id);
+        rank_[id] = npos;
+        free_ids_.push_back(id);
+        --size_;
+
+        // members of the next front dominated by a departed point may move up one front, if
+        // nothing else in the front above still dominates them
+        moved_.assign(1, id);
+        for (std::size_t j = k; !moved_.empty() && j + 1 < fronts_.size(); ++j) {
+            next_.clear();
+            ++epoch_;
+            for (const Id r : moved_) {
+                collect_dominated(j + 1, objectives(r), next_);
+            }
+            next_.erase(std::remove_if(next_.begin(), next_.end(),
+                                       [this, j](Id c) { return front_dominates(j, objectives(c)); }),
+                        next_.end());
+            for (const Id c : next_) {
+                erase(j + 1, c);
+                put(j, c);
+            }
+            moved_.swap(next_);
+        }
+
+        while (!fronts_.empty() && front_size(fronts_.size() - 1) == 0) {
+            fronts_.pop_back();
+        }
+    }
+
+    void clear() {
+        fronts_.clear();
+        rank_.clear();
+        position_.clear();
+        stamp_.clear();
+        objectives_.clear();
+        free_ids_.clear();
+        size_ = 0;
+    }
+
+    bool contains(Id id) const { return id < rank_.size() && rank_[id] != npos; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::size_t n_obj() const { return n_obj_; }
+    std::size_t n_fronts() const { return fronts_.size(); }
+
+    std::size_t rank(Id id) const {
+        if (!contains(id)) {
+            throw std::out_of_range("Point is not in the Pareto archive");
+        }
+        return rank_[id];
+    }
+
+    const double *objectives(Id id) const { return objectives_.data() + id * n_obj_; }
+
+    std::size_t front_size(std::size_t k) const {
+        return n_obj_ == 2 ? fronts_[k].tree.size() : fronts_[k].members.size();
+    }
+
+    // Ids in front k; for two objectives in ascending order of the first objective.
+    void front(std::size_t k, std::vector<Id> &out) const {
+        out.clear();
+        if (n_obj_ == 2) {
+            for (const auto &key : fronts_[k].tree) {
+                out.push_back(key.id);
+            }
+        } else {
+            out.assign(fronts_[k].members.begin(), fronts_[k].members.end());
+        }
+    }
+
+    std::vector<Id> front(std::size_t k) const {
+        std::vector<Id> out;
+        front(k, out);
+        return out;
+    }
+
+private:
+    struct Key {
+        double f0;
+        double f1;
+        Id id;
+
+        bool operator<(const Key &other) const {
+            if (f0 != other.f0) {
+                return f0 < other.f0;
+            }
+            if (f1 != other.f1) {
+                return f1 < other.f1;
+            }
+            return id < other.id;
+        }
+    };
+
+    struct Front {
+        std::set<Key> tree{};         // two objectives
+        std::vector<Id> members{};    // more objectives
+    };
+
+    std::size_t locate(const double *f) const {
+        std::size_t lo = 0;
+        std::size_t hi = fronts_.size();
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            if (front_dominates(mid, f)) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    // Whether any member of front k dominates `f`.
+    bool front_dominates(std::size_t k, const double *f) const {
+        if (n_obj_ == 2) {
+            // within a front f1 falls as f0 grows, so the best candidate is the last member with f0 <= f[0]
+            const auto &tree = fronts_[k].tree;
+            auto it = tree.upper_bound(Key{f[0], std::numeric_limits<double>::infinity(), npos});
+            if (it == tree.begin()) {
+                return false;
+            }
+            --it;
+            return it->f1 <= f[1] && (it->f0 < f[0] || it->f1 < f[1]);
+        }
+
+        for (const Id member : fronts_[k].members) {
+            if (dominance_relation(objectives(member), f, n_obj_) == 1) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Appends the members of front k dominated by `f` to `out`, skipping ids already stamped
+    // with the current epoch.
+    void collect_dominated(std::size_t k, const double *f, std::vector<Id> &out) {
+        const auto take = [this, &out](Id id) {
+            if (stamp_[id] != epoch_) {
+                stamp_[id] = epoch_;
+                out.push_back(id);
+            }
+        };
+
+        if (n_obj_ == 2) {
+            // dominated members have f0 >= f[0] and f1 >= f[1]: a contiguous run in the tree
+            const auto &tree = fronts_[k].tree;
+            for (auto it = tree.lower_bound(Key{f[0], -std::numeric_limits<double>::infinity(), 0});
+                 it != tree.end() && it->f1 >= f[1]; ++it) {
+                if (it->f0 != f[0] || it->f1 != f[1]) {
+                    take(it->id);
+                }
+            }
+            return;
+        }
+
+        for (const Id member : fronts_[k].members) {
+            if (dominance_relation(f, objectives(member), n_obj_) == 1) {
+                take(member);
+            }
+        }
+    }
+
+    void put(std::size_t k, Id id) {
+        rank_[id] = k;
+        if (n_obj_ == 2) {
+            const double *f = objectives(id);
+            fronts_[k].tree.insert(Key{f[0], f[1], id});
+        } else {
+            position_[id] = fronts_[k].members.size();
+            fronts_[k].members.push_back(id);
+        }
+    }
+
+    void erase(std::size_t k, Id id) {
+        if (n_obj_ == 2) {
+            const double *f = objectives(id);
+            fronts_[k].tree.erase(Key{f[0], f[1], id});
+        } else {
+            auto &members = fronts_[k].members;
+            const Id last = members.back();
+            members[position_[id]] = last;
+            position_[last] = position_[id];
+            members.pop_back();
+        }
+    }
+
+    std::size_t n_obj_;
+    std::size_t size_ = 0;
+    std::vector<Front> fronts_{};
+    std::vector<std::size_t> rank_{};
+    std::vector<std::size_t> position_{};
+    std::vector<std::size_t> stamp_{};
+    std::size_t epoch_ = 0;
+    std::vector<double> objectives_{};
+    std::vector<Id> free_ids_{};
+
+    // cascade scratch, kept to avoid reallocating on every update
+    std::vector<Id> moved_{};
+    std::vector<Id> next_{};
+};
+
+#endif // EDDIE_PARETO_ARCHIVE_H
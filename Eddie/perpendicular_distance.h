@@ -0,0 +1,73 @@
+#ifndef EDDIE_PERPENDICULAR_DISTANCE_H
+#define EDDIE_PERPENDICULAR_DISTANCE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "parallel.h"
+#include "simd_kernels.h"
+
+// Perpendicular distance of every point to every line through the origin, as used by the
+// reference-direction niching of NSGA-III and C-TAEA. With s = p . l / |l| the scalar projection,
+//
+//   d(p, l) = |s * l / |l| - p|.
+//
+// The dot products P L^T are computed as a blocked matrix product: the lines are packed
+// objective-major in tiles of 64 and a 3 x 8 block of dot products is accumulated in registers
+// while streaming over the objectives. The residual is then summed directly against a second tile
+// of unit lines. The shortcut d^2 = |p|^2 - s^2 would save that pass, but it cancels exactly for
+// the points close to a line, which decide the niche.
+// Tiles of points are spread over threads and every thread writes its own output rows.
+//
+// The loop over a tile of points runs through the kernel table of simd_kernels.h, in the variant
+// for the host CPU. Besides that table (the Eddie core library) it only depends on parallel.h, so
+// the compiled pymoo modules can share it (pymoo/functions/compiled/calc_perpendicular_distance.pyx).
+
+namespace perpendicular_distance_detail {
+
+constexpr std::size_t line_tile = simd_detail::tile_width;
+constexpr std::size_t point_tile = 64;
+
+// Point-line pairs per thread below which starting another thread costs more than it saves.
+constexpr std::size_t min_pairs_per_thread = std::size_t{1} << 16;
+
+} // namespace perpendicular_distance_detail
+
+// out[i * n_lines + j] = perpendicular distance of row i of P (n_points x n_dim, row-major) to the
+// line spanned by row j of L (n_lines x n_dim, row-major).
+inline void perpendicular_distance(const double *P, std::size_t n_points, const double *L, std::size_t n_lines,
+                                   std::size_t n_dim, double *out, std::size_t n_threads = 1) {
+    namespace detail = perpendicular_distance_detail;
+    using detail::line_tile;
+
+    const std::size_t n_line_tiles = (n_lines + line_tile - 1) / line_tile;
+    std::vector<double> tiles(n_line_tiles * n_dim * line_tile, 0.0);
+    std::vector<double> unit_tiles(tiles.size(), 0.0);
+    // padding columns get unit norms, so they stay finite and are simply not copied out
+    std::vector<double> line_norm(n_line_tiles * line_tile, 1.0);
+    for (std::size_t j = 0; j < n_lines; ++j) {
+        double norm = 0.0;
+        for (std::size_t k = 0; k < n_dim; ++k) {
+            const double l = L[j * n_dim + k];
+            tiles[((j / line_tile) * n_dim + k) * line_tile + j % line_tile] = l;
+            norm += l * l;
+        }
+        line_norm[j] = std::sqrt(norm);
+        for (std::size_t k = 0; k < n_dim; ++k) {
+            unit_tiles[((j / line_tile) * n_dim + k) * line_tile + j % line_tile] = L[j * n_dim + k] / line_norm[j];
+        }
+    }
+
+    const std::size_t n_point_tiles = (n_points + detail::point_tile - 1) / detail::point_tile;
+    n_threads = resolve_thread_count(n_threads, n_points * n_lines, detail::min_pairs_per_thread);
+    const PerpendicularRowsKernel rows = simd_kernels().perpendicular_rows;
+    parallel_for_tiles(n_point_tiles, n_threads, [&](std::size_t tile, std::size_t) {
+        const std::size_t begin = tile * detail::point_tile;
+        const std::size_t end = std::min(begin + detail::point_tile, n_points);
+        rows(P, n_dim, begin, end, tiles.data(), unit_tiles.data(), n_line_tiles, line_norm.data(), n_lines, out);
+    });
+}
+
+#endif // EDDIE_PERPENDICULAR_DISTANCE_H
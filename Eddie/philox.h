@@ -0,0 +1,72 @@
+#ifndef EDDIE_PHILOX_H
+#define EDDIE_PHILOX_H
+
+#include <array>
+#include <cstdint>
+
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"). A counter-based
+// generator: the output is a pure function of a 128-bit counter and a 64-bit key, so any element
+// of a random stream can be produced independently on any thread. Header-only and free of other
+// Eddie dependencies so the compiled pymoo kernels can share it.
+struct Philox4x32 {
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key = std::array<std::uint32_t, 2>;
+
+    static Counter generate(Counter counter, Key key) {
+        for (int round = 0; round < 10; ++round) {
+            const std::uint64_t product0 = static_cast<std::uint64_t>(0xD2511F53U) * counter[0];
+            const std::uint64_t product1 = static_cast<std::uint64_t>(0xCD9E8D57U) * counter[2];
+            counter = Counter{static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                              static_cast<std::uint32_t>(product1),
+                              static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                              static_cast<std::uint32_t>(product0)};
+            key[0] += 0x9E3779B9U;
+            key[1] += 0xBB67AE85U;
+        }
+        return counter;
+    }
+
+    // Counter laid out as (index, stream), key as the 64-bit seed.
+    static Counter generate(std::uint64_t seed, std::uint64_t stream, std::uint64_t index) {
+        return generate(Counter{static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32),
+                                static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)},
+                        Key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)});
+    }
+};
+
+// Uniform double in [0, 1) built from the top 53 bits of two 32-bit words.
+inline double philox_unit(std::uint32_t hi, std::uint32_t lo) {
+    const std::uint64_t bits = (static_cast<std::uint64_t>(hi) << 32 | lo) >> 11;
+    return static_cast<double>(bits) * (1.0 / 9007199254740992.0);
+}
+
+inline double philox_unit(std::uint64_t seed, std::uint64_t stream, std::uint64_t index) {
+    const auto words = Philox4x32::generate(seed, stream, index);
+    return philox_unit(words[0], words[1]);
+}
+
+// Uniform doubles u(index) of one (seed, stream), two per Philox block; consecutive indices share
+// a block, so sequential reads cost half a block each while indices can still be skipped freely.
+class PhiloxUniformStream {
+public:
+    PhiloxUniformStream(std::uint64_t seed, std::uint64_t stream) : seed_(seed), stream_(stream) {}
+
+    double operator()(std::uint64_t index) {
+        const std::uint64_t block = index >> 1;
+        if (!has_block_ || block != block_) {
+            words_ = Philox4x32::generate(seed_, stream_, block);
+            block_ = block;
+            has_block_ = true;
+        }
+        return (index & 1U) ? philox_unit(words_[2], words_[3]) : philox_unit(words_[0], words_[1]);
+    }
+
+private:
+    std::uint64_t seed_;
+    std::uint64_t stream_;
+    std::uint64_t block_ = 0;
+    bool has_block_ = false;
+    Philox4x32::Counter words_{};
+};
+
+#endif // EDDIE_PHILOX_H
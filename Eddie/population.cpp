@@ -0,0 +1,100 @@
+#include "population.h"
+
+#include <algorithm>
+#include <new>
+
+namespace {
+constexpr std::size_t transpose_block = 32;
+
+double *allocate_aligned(std::size_t elements) {
+    if (elements == 0) {
+        return nullptr;
+    }
+    return static_cast<double *>(
+        ::operator new(elements * sizeof(double), std::align_val_t(PopulationMatrix::alignment)));
+}
+}
+
+void PopulationMatrix::AlignedDeleter::operator()(double *ptr) const {
+    ::operator delete(ptr, std::align_val_t(PopulationMatrix::alignment));
+}
+
+PopulationMatrix::PopulationMatrix(std::size_t rows, std::size_t cols, double value) {
+    resize(rows, cols);
+    fill(value);
+}
+
+PopulationMatrix::PopulationMatrix(const PopulationMatrix &other) {
+    resize(other.rows_, other.cols_);
+    std::copy(other.data(), other.data() + other.size(), data());
+}
+
+PopulationMatrix &PopulationMatrix::operator=(const PopulationMatrix &other) {
+    if (this != &other) {
+        resize(other.rows_, other.cols_);
+        std::copy(other.data(), other.data() + other.size(), data());
+    }
+    return *this;
+}
+
+PopulationMatrix::PopulationMatrix(PopulationMatrix &&other) noexcept
+    : data_(std::move(other.data_)), rows_(other.rows_), cols_(other.cols_), capacity_(other.capacity_) {
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.capacity_ = 0;
+}
+
+PopulationMatrix &PopulationMatrix::operator=(PopulationMatrix &&other) noexcept {
+    if (this != &other) {
+        data_ = std::move(other.data_);
+        rows_ = other.rows_;
+        cols_ = other.cols_;
+        capacity_ = other.capacity_;
+        other.rows_ = 0;
+        other.cols_ = 0;
+        other.capacity_ = 0;
+    }
+    return *this;
+}
+
+void PopulationMatrix::resize(std::size_t rows, std::size_t cols) {
+    reserve(rows * cols);
+    rows_ = rows;
+    cols_ = cols;
+}
+
+void PopulationMatrix::reserve(std::size_t elements) {
+    if (elements <= capacity_) {
+        return;
+    }
+    std::unique_ptr<double[], AlignedDeleter> buffer(allocate_aligned(elements));
+    std::copy(data(), data() + size(), buffer.get());
+    data_ = std::move(buffer);
+    capacity_ = elements;
+}
+
+void PopulationMatrix::fill(double value) {
+    std::fill(data(), data() + size(), value);
+}
+
+void PopulationMatrix::copy_row_from(const PopulationMatrix &src, std::size_t src_row, std::size_t dst_row) {
+    const auto source = src.row(src_row);
+    std::copy(source.begin(), source.end(), row(dst_row).begin());
+}
+
+void PopulationMatrix::transpose_into(PopulationMatrix &out) const {
+    out.resize(cols_, rows_);
+
+    // blocked so that both the reads and the strided writes stay within a few cache lines
+    for (std::size_t ib = 0; ib < rows_; ib += transpose_block) {
+        const std::size_t i_end = std::min(ib + transpose_block, rows_);
+        for (std::size_t jb = 0; jb < cols_; jb += transpose_block) {
+            const std::size_t j_end = std::min(jb + transpose_block, cols_);
+            for (std::size_t i = ib; i < i_end; ++i) {
+                for (std::size_t j = jb; j < j_end; ++j) {
+                    out(j, i) = (*this)(i, j);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef EDDIE_POPULATION_H
+#define EDDIE_POPULATION_H
+
+#include <cstddef>
+#include <memory>
+
+// Non-owning view over a contiguous range (a minimal stand-in for C++20 std::span).
+template <typename T>
+class Span {
+public:
+    Span() = default;
+    Span(T *data, std::size_t size) : data_(data), size_(size) {}
+
+    T *data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T &operator[](std::size_t i) const { return data_[i]; }
+    T &front() const { return data_[0]; }
+    T &back() const { return data_[size_ - 1]; }
+
+    T *begin() const { return data_; }
+    T *end() const { return data_ + size_; }
+
+    operator Span<const T>() const { return Span<const T>(data_, size_); }
+
+private:
+    T *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Non-owning view over equally spaced elements, used for columns of a row-major matrix.
+template <typename T>
+class StridedSpan {
+public:
+    StridedSpan() = default;
+    StridedSpan(T *data, std::size_t size, std::size_t stride) : data_(data), size_(size), stride_(stride) {}
+
+    T *data() const { return data_; }
+    std::size_t size() const { return size_; }
+    std::size_t stride() const { return stride_; }
+    bool empty() const { return size_ == 0; }
+
+    T &operator[](std::size_t i) const { return data_[i * stride_]; }
+
+private:
+    T *data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t stride_ = 0;
+};
+
+// Dense row-major matrix of doubles stored in a single cache-line aligned buffer.
+// Each row is one individual (or one objective vector); rows are packed without padding
+// so the whole matrix is a single contiguous block.
+class PopulationMatrix {
+public:
+    static constexpr std::size_t alignment = 64;
+
+    PopulationMatrix() = default;
+    PopulationMatrix(std::size_t rows, std::size_t cols, double value = 0.0);
+
+    PopulationMatrix(const PopulationMatrix &other);
+    PopulationMatrix &operator=(const PopulationMatrix &other);
+    PopulationMatrix(PopulationMatrix &&other) noexcept;
+    PopulationMatrix &operator=(PopulationMatrix &&other) noexcept;
+    ~PopulationMatrix() = default;
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    std::size_t size() const { return rows_ * cols_; }
+    std::size_t capacity() const { return capacity_; }
+    bool empty() const { return size() == 0; }
+
+    double *data() { return data_.get(); }
+    const double *data() const { return data_.get(); }
+
+    double &operator()(std::size_t row, std::size_t col) { return data_[row * cols_ + col]; }
+    double operator()(std::size_t row, std::size_t col) const { return data_[row * cols_ + col]; }
+
+    Span<double> row(std::size_t i) { return Span<double>(data_.get() + i * cols_, cols_); }
+    Span<const double> row(std::size_t i) const { return Span<const double>(data_.get() + i * cols_, cols_); }
+
+    StridedSpan<double> column(std::size_t j) { return StridedSpan<double>(data_.get() + j, rows_, cols_); }
+    StridedSpan<const double> column(std::size_t j) const {
+        return StridedSpan<const double>(data_.get() + j, rows_, cols_);
+    }
+
+    // Changes the shape. The buffer is only reallocated when the new size exceeds the
+    // current capacity, so shrinking and regrowing within a run never touches the heap.
+    // Existing values are not preserved in any meaningful layout.
+    void resize(std::size_t rows, std::size_t cols);
+    void reserve(std::size_t elements);
+    void fill(double value);
+
+    // Copies row `src_row` of `src` into row `dst_row` of this matrix (same column count).
+    void copy_row_from(const PopulationMatrix &src, std::size_t src_row, std::size_t dst_row);
+
+    // Writes the column-major view (a cols x rows matrix) into `out`, reusing its buffer.
+    void transpose_into(PopulationMatrix &out) const;
+
+private:
+    struct AlignedDeleter {
+        void operator()(double *ptr) const;
+    };
+
+    std::unique_ptr<double[], AlignedDeleter> data_{};
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+using ObjectiveMatrix = PopulationMatrix;
+using ConstraintMatrix = PopulationMatrix;
+
+#endif // EDDIE_POPULATION_H
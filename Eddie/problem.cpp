@@ -1,5 +1,6 @@
 #include "problem.h"
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
@@ -7,9 +8,92 @@ namespace {
 constexpr double pi() {
     return 3.14159265358979323846;
 }
+
+constexpr std::size_t zdt4_lanes = 8;
+
+// cos(4 * pi * x) = cos(2 * pi * t) with t = 2x. t is reduced to r in [-1/2, 1/2] (adding and
+// subtracting 1.5 * 2^52 rounds to the nearest integer without a libm call), folded onto
+// [0, 1/4] by symmetry, and the Taylor series is evaluated up to y^16 on y in [0, pi / 2],
+// where the truncation error is below 6e-13. Valid for |x| < 2^50.
+inline double cos_4pi_fast(double x) {
+    constexpr double round_magic = 6755399441055744.0;
+    const double t = 2.0 * x;
+    const double r = t - ((t + round_magic) - round_magic);
+    double a = std::fabs(r);
+    const double sign = a > 0.25 ? -1.0 : 1.0;
+    a = a > 0.25 ? 0.5 - a : a;
+
+    const double y = 2.0 * pi() * a;
+    const double y2 = y * y;
+    double p = 1.0 / 20922789888000.0;          //  1/16!
+    p = p * y2 - 1.0 / 87178291200.0;           // -1/14!
+    p = p * y2 + 1.0 / 479001600.0;             //  1/12!
+    p = p * y2 - 1.0 / 3628800.0;               // -1/10!
+    p = p * y2 + 1.0 / 40320.0;                 //  1/8!
+    p = p * y2 - 1.0 / 720.0;                   // -1/6!
+    p = p * y2 + 1.0 / 24.0;                    //  1/4!
+    p = p * y2 - 0.5;                           // -1/2!
+    p = p * y2 + 1.0;
+    return sign * p;
+}
+
+template <CosineMode Mode>
+inline double cos_4pi(double x) {
+    if (Mode == CosineMode::fast) {
+        return cos_4pi_fast(x);
+    }
+    return std::cos(4.0 * pi() * x);
+}
+
+// Evaluates `n_rows` consecutive individuals starting at `x` (row-major, `n_var` columns) into
+// `f` (row-major, two columns). The inner loop runs across up to `zdt4_lanes` individuals for
+// the same variable, which is what the compiler vectorizes. N != 0 fixes the dimension at
+// compile time so the variable loop unrolls.
+template <std::size_t N, CosineMode Mode>
+void zdt4_rows(const double *x, std::size_t n_var, std::size_t n_rows, double *f) {
+    const std::size_t n = N != 0 ? N : n_var;
+
+    for (std::size_t r0 = 0; r0 < n_rows; r0 += zdt4_lanes) {
+        const std::size_t lanes = std::min(zdt4_lanes, n_rows - r0);
+        const double *block = x + r0 * n;
+
+        double g[zdt4_lanes];
+        for (std::size_t l = 0; l < lanes; ++l) {
+            g[l] = 1.0 + 10.0 * static_cast<double>(n - 1);
+        }
+        for (std::size_t i = 1; i < n; ++i) {
+            for (std::size_t l = 0; l < lanes; ++l) {
+                const double xi = block[l * n + i];
+                g[l] += xi * xi - 10.0 * cos_4pi<Mode>(xi);
+            }
+        }
+        for (std::size_t l = 0; l < lanes; ++l) {
+            const double f1 = block[l * n];
+            const double h = 1.0 - std::sqrt(f1 / g[l]);
+            f[(r0 + l) * 2] = f1;
+            f[(r0 + l) * 2 + 1] = g[l] * h;
+        }
+    }
 }
 
-std::vector<double> evaluate_zdt4(const Individual &decision_vector) {
+template <CosineMode Mode>
+void zdt4_dispatch(const double *x, std::size_t n_var, std::size_t n_rows, double *f) {
+    switch (n_var) {
+    case 2: zdt4_rows<2, Mode>(x, n_var, n_rows, f); break;
+    case 3: zdt4_rows<3, Mode>(x, n_var, n_rows, f); break;
+    case 4: zdt4_rows<4, Mode>(x, n_var, n_rows, f); break;
+    case 5: zdt4_rows<5, Mode>(x, n_var, n_rows, f); break;
+    case 6: zdt4_rows<6, Mode>(x, n_var, n_rows, f); break;
+    case 7: zdt4_rows<7, Mode>(x, n_var, n_rows, f); break;
+    case 8: zdt4_rows<8, Mode>(x, n_var, n_rows, f); break;
+    case 9: zdt4_rows<9, Mode>(x, n_var, n_rows, f); break;
+    case 10: zdt4_rows<10, Mode>(x, n_var, n_rows, f); break;
+    default: zdt4_rows<0, Mode>(x, n_var, n_rows, f); break;
+    }
+}
+}
+
+std::array<double, 2> evaluate_zdt4(Span<const double> decision_vector) {
     if (decision_vector.size() < 2) {
         throw std::invalid_argument("ZDT4 requires at least two decision variables");
     }
@@ -30,13 +114,72 @@ std::vector<double> evaluate_zdt4(const Individual &decision_vector) {
     return {f1, f2};
 }
 
-std::vector<std::vector<double>> evaluate_zdt4_population(const Population &population) {
-    std::vector<std::vector<double>> objectives;
-    objectives.reserve(population.size());
+template <std::size_t N>
+std::array<double, 2> evaluate_zdt4(const std::array<double, N> &decision_vector) {
+    static_assert(N >= 2, "ZDT4 requires at least two decision variables");
+    std::array<double, 2> objectives{};
+    zdt4_rows<N, CosineMode::exact>(decision_vector.data(), N, 1, objectives.data());
+    return objectives;
+}
+
+template std::array<double, 2> evaluate_zdt4<2>(const std::array<double, 2> &);
+template std::array<double, 2> evaluate_zdt4<3>(const std::array<double, 3> &);
+template std::array<double, 2> evaluate_zdt4<4>(const std::array<double, 4> &);
+template std::array<double, 2> evaluate_zdt4<5>(const std::array<double, 5> &);
+template std::array<double, 2> evaluate_zdt4<6>(const std::array<double, 6> &);
+template std::array<double, 2> evaluate_zdt4<7>(const std::array<double, 7> &);
+template std::array<double, 2> evaluate_zdt4<8>(const std::array<double, 8> &);
+template std::array<double, 2> evaluate_zdt4<9>(const std::array<double, 9> &);
+template std::array<double, 2> evaluate_zdt4<10>(const std::array<double, 10> &);
 
-    for (const auto &individual : population) {
-        objectives.push_back(evaluate_zdt4(individual));
+void evaluate_zdt4_batch(const PopulationMatrix &population, std::size_t begin, std::size_t end,
+                         ObjectiveMatrix &objectives, CosineMode mode) {
+    if (population.cols() < 2) {
+        throw std::invalid_argument("ZDT4 requires at least two decision variables");
+    }
+    if (begin >= end) {
+        return;
     }
 
+    const double *x = population.row(begin).data();
+    double *f = objectives.row(begin).data();
+    if (mode == CosineMode::fast) {
+        zdt4_dispatch<CosineMode::fast>(x, population.cols(), end - begin, f);
+    } else {
+        zdt4_dispatch<CosineMode::exact>(x, population.cols(), end - begin, f);
+    }
+}
+
+void evaluate_zdt4_batch(const PopulationMatrix &population, ObjectiveMatrix &objectives, CosineMode mode) {
+    objectives.resize(population.rows(), 2);
+    evaluate_zdt4_batch(population, 0, population.rows(), objectives, mode);
+}
+
+void evaluate_zdt4_population(const PopulationMatrix &population, ObjectiveMatrix &objectives) {
+    evaluate_zdt4_batch(population, objectives, CosineMode::exact);
+}
+
+ObjectiveMatrix evaluate_zdt4_population(const PopulationMatrix &population) {
+    ObjectiveMatrix objectives;
+    evaluate_zdt4_population(population, objectives);
     return objectives;
 }
+
+ZDT4Problem::ZDT4Problem(std::size_t n_var, CosineMode mode) : n_var_(n_var), mode_(mode) {
+    if (n_var_ < 2) {
+        throw std::invalid_argument("ZDT4 requires at least two decision variables");
+    }
+}
+
+void ZDT4Problem::evaluate_individual(Span<const double> x, Span<double> f, Span<double> /*g*/) const {
+    if (mode_ == CosineMode::fast) {
+        zdt4_dispatch<CosineMode::fast>(x.data(), x.size(), 1, f.data());
+    } else {
+        zdt4_dispatch<CosineMode::exact>(x.data(), x.size(), 1, f.data());
+    }
+}
+
+void ZDT4Problem::evaluate_rows(const PopulationMatrix &x, std::size_t begin, std::size_t end, ObjectiveMatrix &f,
+                                ConstraintMatrix & /*g*/) const {
+    evaluate_zdt4_batch(x, begin, end, f, mode_);
+}
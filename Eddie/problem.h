@@ -1,12 +1,52 @@
 #ifndef EDDIE_PROBLEM_H
 #define EDDIE_PROBLEM_H
 
-#include <vector>
+#include <array>
+#include <cstddef>
 
-#include "initpop.h"
+#include "evaluator.h"
+#include "population.h"
 
-std::vector<double> evaluate_zdt4(const Individual &decision_vector);
+// How cos(4 * pi * x) is computed in the ZDT4 kernels. `exact` calls std::cos and matches
+// `evaluate_zdt4` bit for bit; `fast` uses a branch-free polynomial that vectorizes, with an
+// absolute error below 1e-12 per term on the ZDT4 domain |x| <= 5, i.e. |g_fast - g| < 1e-11 * n_var.
+enum class CosineMode { exact, fast };
 
-std::vector<std::vector<double>> evaluate_zdt4_population(const Population &population);
+std::array<double, 2> evaluate_zdt4(Span<const double> decision_vector);
+
+// ZDT4 for a compile-time dimension N; the variable loop is fully unrolled.
+// Instantiated in problem.cpp for N = 2 to 10.
+template <std::size_t N>
+std::array<double, 2> evaluate_zdt4(const std::array<double, N> &decision_vector);
+
+// Batch ZDT4 over rows [begin, end) of `population`, several individuals per SIMD lane.
+// Dimensions 2 to 10 dispatch to unrolled kernels. `objectives` must already have the shape
+// population.rows() x 2.
+void evaluate_zdt4_batch(const PopulationMatrix &population, std::size_t begin, std::size_t end,
+                         ObjectiveMatrix &objectives, CosineMode mode = CosineMode::exact);
+
+void evaluate_zdt4_batch(const PopulationMatrix &population, ObjectiveMatrix &objectives,
+                         CosineMode mode = CosineMode::exact);
+
+// Writes one objective row per individual into `objectives`, reusing its buffer.
+void evaluate_zdt4_population(const PopulationMatrix &population, ObjectiveMatrix &objectives);
+
+ObjectiveMatrix evaluate_zdt4_population(const PopulationMatrix &population);
+
+class ZDT4Problem : public Problem {
+public:
+    explicit ZDT4Problem(std::size_t n_var, CosineMode mode = CosineMode::exact);
+
+    std::size_t n_var() const override { return n_var_; }
+    std::size_t n_obj() const override { return 2; }
+
+    void evaluate_individual(Span<const double> x, Span<double> f, Span<double> g) const override;
+    void evaluate_rows(const PopulationMatrix &x, std::size_t begin, std::size_t end, ObjectiveMatrix &f,
+                       ConstraintMatrix &g) const override;
+
+private:
+    std::size_t n_var_;
+    CosineMode mode_;
+};
 
 #endif // EDDIE_PROBLEM_H
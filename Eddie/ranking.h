@@ -0,0 +1,788 @@
+#ifndef EDDIE_RANKING_H
+#define EDDIE_RANKING_H
+
+// Fast non-dominated sort (Deb et al., 2002) on a packed dominance bit matrix.
+//
+// Header-only so the compiled pymoo kernels can use it directly
+// (pymoo/functions/compiled/non_dominated_sorting.pyx). The dominance relation is stored as
+// one bit per ordered pair, i.e. n * n / 8 bytes instead of the n * n ints of a dense matrix,
+// and is built in cache tiles over a column-major copy of F so that the objective comparisons
+// of one point against a block of 64 others vectorize.
+//
+// When only the leading fronts are needed (`n_stop_if_ranked` / `max_fronts` below n, no
+// epsilon), the matrix is skipped: an efficient non-dominated sort places the points in
+// lexicographic order and stops filling fronts at the survival cut (FrontCut), so points behind
+// the split front are never compared against more than the kept fronts.
+//
+// The pairwise comparisons can be spread over `n_threads` threads (0 = all cores). Threads take
+// whole 64-row tiles, every bit word has exactly one writer and the dominator counts are kept
+// per thread and summed once, so the result does not depend on the thread count.
+//
+// `dominance_degree_non_dominated_sort` builds the same bit matrix the dominance-degree way
+// (Zhou et al., DDA-NS): per objective, the points are visited in sorted order and every row is
+// ANDed with the packed set of points that are no better in that objective.
+//
+// Two and three objectives without epsilon skip all of the above: every entry point hands them
+// to `sweep_non_dominated_sort`, which needs O(n log n) comparisons instead of O(n²). The other
+// objective counts run kernels instantiated for their count (see dominance.h).
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "dominance.h"
+#include "fronts.h"
+#include "parallel.h"
+#include "telemetry.h"
+
+// Row-major n x n bit matrix; bit (i, j) is set when point i dominates point j.
+class DominanceBitMatrix {
+public:
+    static constexpr std::size_t word_bits = 64;
+
+    void reset(std::size_t n) {
+        n_ = n;
+        words_per_row_ = (n + word_bits - 1) / word_bits;
+        words_.assign(n_ * words_per_row_, 0U);
+    }
+
+    std::size_t size() const { return n_; }
+    std::size_t words_per_row() const { return words_per_row_; }
+
+    std::uint64_t *row(std::size_t i) { return words_.data() + i * words_per_row_; }
+    const std::uint64_t *row(std::size_t i) const { return words_.data() + i * words_per_row_; }
+
+    void set(std::size_t i, std::size_t j) { row(i)[j / word_bits] |= std::uint64_t{1} << (j % word_bits); }
+    bool test(std::size_t i, std::size_t j) const { return (row(i)[j / word_bits] >> (j % word_bits)) & 1U; }
+
+private:
+    std::vector<std::uint64_t> words_{};
+    std::size_t n_ = 0;
+    std::size_t words_per_row_ = 0;
+};
+
+struct FastSortWorkspace {
+    DominanceBitMatrix dominates{};
+    std::vector<double> objectives_by_column{};
+    std::vector<std::size_t> n_dominated{};
+    std::vector<std::size_t> thread_n_dominated{};  // counters of threads 1.., n per thread
+    std::vector<unsigned char> is_dominated{};
+    std::vector<std::size_t> current_front{};
+    std::vector<std::size_t> next_front{};
+
+    // partial (efficient) sort
+    std::vector<std::size_t> order{};
+    std::vector<std::size_t> previous_in_front{};
+    std::vector<std::size_t> front_tail{};
+    std::vector<std::size_t> front_size{};
+    std::vector<std::vector<std::size_t>> staircases{};  // three-objective sweep, one per front
+};
+
+namespace ranking_detail {
+
+constexpr std::size_t row_tile = 64;
+
+// Pairwise comparisons per thread below which starting another thread costs more than it saves.
+constexpr std::size_t min_pairs_per_thread = std::size_t{1} << 22;
+
+inline void copy_by_column(const double *F, std::size_t n, std::size_t n_obj, std::vector<double> &by_column) {
+    by_column.resize(n * n_obj);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t k = 0; k < n_obj; ++k) {
+            by_column[k * n + i] = F[i * n_obj + k];
+        }
+    }
+}
+
+inline int count_trailing_zeros(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int n = 0;
+    while ((word & 1U) == 0U) {
+        word >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline int popcount(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int n = 0;
+    for (; word != 0U; word &= word - 1U) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// In-place transpose of a 64 x 64 bit block (bit t of a[r] <-> bit r of a[t]).
+inline void transpose_block(std::uint64_t a[64]) {
+    std::uint64_t mask = 0x00000000FFFFFFFFULL;
+    for (std::size_t width = 32; width != 0; width >>= 1, mask ^= mask << width) {
+        for (std::size_t r = 0; r < 64; r = (r + width + 1) & ~width) {
+            const std::uint64_t t = ((a[r] >> width) ^ a[r + width]) & mask;
+            a[r] ^= t << width;
+            a[r + width] ^= t;
+        }
+    }
+}
+
+// Compares point i against the points [j0, j0 + len) of the column-major objectives and
+// returns bit masks (bit t <-> point j0 + t) of the points i dominates and that dominate i.
+template <int M>
+inline void compare_block(const double *by_column, std::size_t n, std::size_t n_obj, std::size_t i,
+                          std::size_t j0, std::size_t len, double epsilon,
+                          std::uint64_t &i_dominates, std::uint64_t &dominates_i) {
+    unsigned char better[DominanceBitMatrix::word_bits] = {};
+    unsigned char worse[DominanceBitMatrix::word_bits] = {};
+
+    const std::size_t m = dominance_detail::objective_count<M>(n_obj);
+    for (std::size_t k = 0; k < m; ++k) {
+        const double *column = by_column + k * n;
+        const double fi = column[i];
+        const double *fj = column + j0;
+        for (std::size_t t = 0; t < len; ++t) {
+            better[t] |= static_cast<unsigned char>(fi + epsilon < fj[t]);
+            worse[t] |= static_cast<unsigned char>(fi > fj[t] + epsilon);
+        }
+    }
+
+    i_dominates = 0U;
+    dominates_i = 0U;
+    for (std::size_t t = 0; t < len; ++t) {
+        i_dominates |= static_cast<std::uint64_t>(better[t] & (worse[t] ^ 1U)) << t;
+        dominates_i |= static_cast<std::uint64_t>(worse[t] & (better[t] ^ 1U)) << t;
+    }
+}
+
+// Lexicographic order of the rows of F (identical points in no particular order).
+template <int M>
+inline void lexicographic_order(const double *F, std::size_t n, std::size_t n_obj, std::vector<std::size_t> &order) {
+    const std::size_t m = dominance_detail::objective_count<M>(n_obj);
+    order.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [F, m](std::size_t a, std::size_t b) {
+        const double *fa = F + a * m;
+        const double *fb = F + b * m;
+        for (std::size_t k = 0; k < m; ++k) {
+            if (fa[k] != fb[k]) {
+                return fa[k] < fb[k];
+            }
+        }
+        return false;
+    });
+}
+
+// Fills `fronts` from per-point ranks of fronts of the given sizes, members in `order`. Fronts
+// from n_fronts on are dropped (their points become unranked); `size` is used as scratch.
+inline void scatter_fronts(const std::vector<std::size_t> &order, std::vector<std::size_t> &size,
+                           std::size_t n_fronts, FrontSet &fronts) {
+    fronts.offsets.resize(n_fronts + 1);
+    fronts.offsets[0] = 0;
+    for (std::size_t k = 0; k < n_fronts; ++k) {
+        fronts.offsets[k + 1] = fronts.offsets[k] + size[k];
+    }
+    fronts.members.resize(fronts.offsets[n_fronts]);
+    std::copy(fronts.offsets.begin(), fronts.offsets.end() - 1, size.begin());
+    for (const std::size_t p : order) {
+        if (fronts.rank[p] >= n_fronts) {
+            fronts.rank[p] = FrontSet::unranked;
+            continue;
+        }
+        fronts.members[size[fronts.rank[p]]++] = p;
+    }
+}
+
+// Whether front k of the sweep dominates the point fp. The newest member of a two-objective
+// front has its lowest f2 and, coming earlier in lexicographic order, an f1 no higher than fp's,
+// so it dominates fp whenever any member does. A three-objective front keeps the staircase of
+// its members' (f2, f3) values (f2 ascending, f3 strictly descending, dominated steps removed);
+// the step with the largest f2 <= fp's has the lowest f3 among all candidates.
+template <int M, typename Workspace>
+inline bool sweep_front_dominates(const double *F, std::size_t k, const double *fp, const Workspace &workspace) {
+    if constexpr (M == 2) {
+        const double *ft = F + workspace.front_tail[k] * 2;
+        return ft[1] <= fp[1] && (ft[0] < fp[0] || ft[1] < fp[1]);
+    } else {
+        const auto &stair = workspace.staircases[k];
+        const auto step = std::upper_bound(stair.begin(), stair.end(), fp[1],
+                                           [F](double f2, std::size_t s) { return f2 < F[s * 3 + 1]; });
+        if (step == stair.begin()) {
+            return false;
+        }
+        const double *fs = F + *(step - 1) * 3;
+        // an identical point does not dominate, and then no other member can
+        return fs[2] <= fp[2] && !(fs[0] == fp[0] && fs[1] == fp[1] && fs[2] == fp[2]);
+    }
+}
+
+// Adds point p (not dominated by the front) to the staircase of a three-objective front.
+inline void sweep_add_step(const double *F, std::vector<std::size_t> &stair, std::size_t p) {
+    const double *fp = F + p * 3;
+    const auto first = std::lower_bound(stair.begin(), stair.end(), fp[1],
+                                        [F](std::size_t s, double f2) { return F[s * 3 + 1] < f2; });
+    if (first != stair.end() && F[*first * 3 + 1] == fp[1] && F[*first * 3 + 2] <= fp[2]) {
+        return; // the step is a copy of p
+    }
+    auto last = first;
+    while (last != stair.end() && F[*last * 3 + 2] >= fp[2]) {
+        ++last;
+    }
+    if (last != first) {
+        *first = p;
+        stair.erase(first + 1, last);
+    } else {
+        stair.insert(first, p);
+    }
+}
+
+inline std::vector<std::vector<int>> to_nested(const FrontSet &fronts) {
+    std::vector<std::vector<int>> result(fronts.size());
+    for (std::size_t k = 0; k < fronts.size(); ++k) {
+        const auto front = fronts.front(k);
+        result[k].assign(front.begin(), front.end());
+    }
+    return result;
+}
+
+} // namespace ranking_detail
+
+// Fills `workspace.dominates` and `workspace.n_dominated` for the row-major n x n_obj matrix F.
+inline void build_dominance_matrix(const double *F, std::size_t n, std::size_t n_obj, double epsilon,
+                                   FastSortWorkspace &workspace, std::size_t n_threads = 1) {
+    constexpr std::size_t word_bits = DominanceBitMatrix::word_bits;
+    // a tile of rows then owns one column word of the lower triangle, so no word has two writers
+    static_assert(ranking_detail::row_tile == word_bits, "row tiles must match the bit words");
+
+    auto &by_column = workspace.objectives_by_column;
+    ranking_detail::copy_by_column(F, n, n_obj, by_column);
+
+    auto &bits = workspace.dominates;
+    bits.reset(n);
+    workspace.n_dominated.assign(n, 0U);
+
+    n_threads = resolve_thread_count(n_threads, n * n / 2, ranking_detail::min_pairs_per_thread);
+    workspace.thread_n_dominated.assign((n_threads - 1) * n, 0U);
+
+    // upper triangle only, in tiles of 64 rows so each column block is reused from cache
+    const std::size_t n_tiles = bits.words_per_row();
+    with_objective_count(n_obj, [&](auto objectives) {
+        constexpr int M = decltype(objectives)::value;
+        parallel_for_tiles(n_tiles, n_threads, [&](std::size_t tile, std::size_t thread) {
+            std::size_t *n_dominated =
+                thread == 0 ? workspace.n_dominated.data() : workspace.thread_n_dominated.data() + (thread - 1) * n;
+            const std::size_t ib = tile * ranking_detail::row_tile;
+            const std::size_t i_end = std::min(ib + ranking_detail::row_tile, n);
+            // the pairs (i, j > i) of the tile's rows
+            EDDIE_TELEMETRY_ADD(dominance_comparisons, (i_end - ib) * (2 * n - ib - i_end - 1) / 2);
+            for (std::size_t word = tile; word < bits.words_per_row(); ++word) {
+                const std::size_t j0 = word * word_bits;
+                const std::size_t len = std::min(word_bits, n - j0);
+
+                for (std::size_t i = ib; i < i_end; ++i) {
+                    if (j0 + len <= i + 1) {
+                        continue;
+                    }
+
+                    std::uint64_t i_dominates = 0U;
+                    std::uint64_t dominates_i = 0U;
+                    ranking_detail::compare_block<M>(by_column.data(), n, n_obj, i, j0, len, epsilon, i_dominates,
+                                                     dominates_i);
+
+                    // keep pairs (i, j) with j > i
+                    if (i >= j0) {
+                        const std::uint64_t keep = ~((std::uint64_t{2} << (i - j0)) - 1U);
+                        i_dominates &= keep;
+                        dominates_i &= keep;
+                    }
+
+                    bits.row(i)[word] |= i_dominates;
+                    for (std::uint64_t w = i_dominates; w != 0U; w &= w - 1U) {
+                        ++n_dominated[j0 + static_cast<std::size_t>(ranking_detail::count_trailing_zeros(w))];
+                    }
+                    for (std::uint64_t w = dominates_i; w != 0U; w &= w - 1U) {
+                        bits.set(j0 + static_cast<std::size_t>(ranking_detail::count_trailing_zeros(w)), i);
+                        ++n_dominated[i];
+                    }
+                }
+            }
+        });
+    });
+
+    for (std::size_t t = 0; t + 1 < n_threads; ++t) {
+        const std::size_t *counts = workspace.thread_n_dominated.data() + t * n;
+        for (std::size_t i = 0; i < n; ++i) {
+            workspace.n_dominated[i] += counts[i];
+        }
+    }
+}
+
+// Peels fronts off `workspace.dominates` / `workspace.n_dominated`. Stops once
+// `n_stop_if_ranked` points are ranked or `max_fronts` fronts were produced; points left over
+// keep rank FrontSet::unranked.
+inline void peel_fronts(std::size_t n, FrontSet &fronts, FastSortWorkspace &workspace,
+                        std::size_t n_stop_if_ranked, std::size_t max_fronts) {
+    constexpr std::size_t word_bits = DominanceBitMatrix::word_bits;
+
+    auto &current = workspace.current_front;
+    auto &next = workspace.next_front;
+    current.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (workspace.n_dominated[i] == 0) {
+            current.push_back(i);
+        }
+    }
+
+    fronts.offsets.push_back(0);
+    std::size_t n_ranked = 0;
+    while (!current.empty()) {
+        const std::size_t k = fronts.size();
+        for (const std::size_t i : current) {
+            fronts.members.push_back(i);
+            fronts.rank[i] = k;
+        }
+        fronts.offsets.push_back(fronts.members.size());
+        n_ranked += current.size();
+
+        if (n_ranked >= n || n_ranked >= n_stop_if_ranked || fronts.size() >= max_fronts) {
+            break;
+        }
+
+        next.clear();
+        for (const std::size_t i : current) {
+            const std::uint64_t *row = workspace.dominates.row(i);
+            for (std::size_t word = 0; word < workspace.dominates.words_per_row(); ++word) {
+                for (std::uint64_t w = row[word]; w != 0U; w &= w - 1U) {
+                    const std::size_t j =
+                        word * word_bits + static_cast<std::size_t>(ranking_detail::count_trailing_zeros(w));
+                    if (--workspace.n_dominated[j] == 0) {
+                        next.push_back(j);
+                    }
+                }
+            }
+        }
+        current.swap(next);
+    }
+}
+
+// Ranks of the sweep sort below in `rank` (FrontSet::unranked behind the cut); leaves the
+// lexicographic order in `workspace.order` and the front sizes in `workspace.front_size`, and
+// returns the number of fronts before the cut.
+template <int M, typename Workspace>
+inline std::size_t sweep_ranks(const double *F, std::size_t n, std::vector<std::size_t> &rank, Workspace &workspace,
+                               std::size_t n_stop_if_ranked = FrontCut::unlimited,
+                               std::size_t max_fronts = FrontCut::unlimited) {
+    static_assert(M == 2 || M == 3, "the sweep sorts two or three objectives");
+
+    rank.assign(n, FrontSet::unranked);
+    auto &order = workspace.order;
+    auto &tail = workspace.front_tail;
+    auto &size = workspace.front_size;
+    auto &staircases = workspace.staircases;
+    ranking_detail::lexicographic_order<M>(F, n, M, order);
+    tail.clear();
+    size.clear();
+    FrontCut cut(n_stop_if_ranked, max_fronts);
+    [[maybe_unused]] std::size_t n_compared = 0;
+
+    for (const std::size_t p : order) {
+        const double *fp = F + p * M;
+        // fronts before `low` dominate p, fronts from `high` on do not
+        std::size_t low = 0;
+        std::size_t high = std::min(tail.size(), cut.limit());
+        while (low < high) {
+            const std::size_t middle = low + (high - low) / 2;
+            ++n_compared;
+            if (ranking_detail::sweep_front_dominates<M>(F, middle, fp, workspace)) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        const std::size_t k = low;
+        if (!cut.keeps(k)) {
+            continue;
+        }
+
+        if (k == tail.size()) {
+            tail.push_back(p);
+            size.push_back(0);
+            if constexpr (M == 3) {
+                // staircases of earlier sorts are kept with their capacity
+                if (staircases.size() < tail.size()) {
+                    staircases.emplace_back();
+                }
+                staircases[k].clear();
+            }
+        }
+        tail[k] = p;
+        if constexpr (M == 3) {
+            ranking_detail::sweep_add_step(F, staircases[k], p);
+        }
+        ++size[k];
+        rank[p] = k;
+        cut.add(size.data(), size.size());
+    }
+
+    EDDIE_TELEMETRY_ADD(dominance_comparisons, n_compared);
+    return std::min(size.size(), cut.limit());
+}
+
+// Non-dominated sort of two or three objectives (M, no epsilon) in O(n log n) comparisons.
+// Points are visited in lexicographic order, so only points already placed can dominate the
+// next one. If a front dominates a point, so does every earlier front (the ENS invariant), hence
+// a binary search over the fronts finds its front with one O(1) (M = 2) or O(log n) (M = 3)
+// front test per step, see sweep_front_dominates. Adding a step to a three-objective staircase
+// shifts the vector behind it, which is linear in the staircase length in the worst case but a
+// memmove. Fronts and cut as in efficient_non_dominated_sort; members in lexicographic order.
+// `Workspace` provides `order`, `front_tail`, `front_size` and `staircases` (FastSortWorkspace,
+// SortWorkspace); nothing is allocated once they have grown to the input.
+template <int M, typename Workspace>
+inline void sweep_non_dominated_sort(const double *F, std::size_t n, FrontSet &fronts, Workspace &workspace,
+                                     std::size_t n_stop_if_ranked = FrontCut::unlimited,
+                                     std::size_t max_fronts = FrontCut::unlimited) {
+    fronts.members.clear();
+    fronts.offsets.clear();
+    if (n == 0) {
+        fronts.rank.clear();
+        return;
+    }
+    const std::size_t n_fronts = sweep_ranks<M>(F, n, fronts.rank, workspace, n_stop_if_ranked, max_fronts);
+    ranking_detail::scatter_fronts(workspace.order, workspace.front_size, n_fronts, fronts);
+}
+
+// Efficient non-dominated sort with sequential search (ENS-SS) that only builds the fronts
+// before the survival cut: the fronts holding the first `n_stop_if_ranked` points, at most
+// `max_fronts` of them. Points behind the cut keep rank FrontSet::unranked. Members are listed
+// in lexicographic order. Two and three objectives are sorted by the sweep instead.
+inline void efficient_non_dominated_sort(const double *F, std::size_t n, std::size_t n_obj, FrontSet &fronts,
+                                         FastSortWorkspace &workspace,
+                                         std::size_t n_stop_if_ranked = FrontCut::unlimited,
+                                         std::size_t max_fronts = FrontCut::unlimited) {
+    constexpr std::size_t no_point = static_cast<std::size_t>(-1);
+
+    if (n_obj == 2) {
+        sweep_non_dominated_sort<2>(F, n, fronts, workspace, n_stop_if_ranked, max_fronts);
+        return;
+    }
+    if (n_obj == 3) {
+        sweep_non_dominated_sort<3>(F, n, fronts, workspace, n_stop_if_ranked, max_fronts);
+        return;
+    }
+
+    fronts.members.clear();
+    fronts.offsets.clear();
+    fronts.rank.assign(n, FrontSet::unranked);
+    if (n == 0) {
+        return;
+    }
+
+    // fronts are linked lists running backwards from their tails, newest (likeliest dominator) first
+    auto &order = workspace.order;
+    auto &previous = workspace.previous_in_front;
+    auto &tail = workspace.front_tail;
+    auto &size = workspace.front_size;
+    previous.assign(n, no_point);
+    tail.clear();
+    size.clear();
+    FrontCut cut(n_stop_if_ranked, max_fronts);
+    [[maybe_unused]] std::size_t n_compared = 0;  // reported once, not per comparison
+
+    with_objective_count(n_obj, [&](auto objectives) {
+        constexpr int M = decltype(objectives)::value;
+        ranking_detail::lexicographic_order<M>(F, n, n_obj, order);
+        for (const std::size_t p : order) {
+            const double *fp = F + p * n_obj;
+            const std::size_t n_searched = std::min(tail.size(), cut.limit());
+            std::size_t k = 0;
+            for (; k < n_searched; ++k) {
+                std::size_t q = tail[k];
+                while (q != no_point && (++n_compared, !dominates_fixed<M>(F + q * n_obj, fp, n_obj))) {
+                    q = previous[q];
+                }
+                if (q == no_point) {
+                    break;
+                }
+            }
+            if (!cut.keeps(k)) {
+                continue;
+            }
+
+            if (k == tail.size()) {
+                tail.push_back(no_point);
+                size.push_back(0);
+            }
+            previous[p] = tail[k];
+            tail[k] = p;
+            ++size[k];
+            fronts.rank[p] = k;
+            cut.add(size.data(), size.size());
+        }
+    });
+
+    EDDIE_TELEMETRY_ADD(dominance_comparisons, n_compared);
+    ranking_detail::scatter_fronts(order, size, std::min(size.size(), cut.limit()), fronts);
+}
+
+// Fast non-dominated sort of the row-major n x n_obj matrix F (see peel_fronts for the limits).
+// Without epsilon, partial sorts and sorts of two or three objectives go through
+// efficient_non_dominated_sort instead, which gives the same fronts without building the matrix.
+inline void fast_non_dominated_sort(const double *F, std::size_t n, std::size_t n_obj, FrontSet &fronts,
+                                    FastSortWorkspace &workspace, double epsilon = 0.0,
+                                    std::size_t n_stop_if_ranked = static_cast<std::size_t>(-1),
+                                    std::size_t max_fronts = static_cast<std::size_t>(-1),
+                                    std::size_t n_threads = 1) {
+    if (epsilon == 0.0 && (n_obj == 2 || n_obj == 3 || n_stop_if_ranked < n || max_fronts < n)) {
+        efficient_non_dominated_sort(F, n, n_obj, fronts, workspace, n_stop_if_ranked, max_fronts);
+        return;
+    }
+
+    fronts.members.clear();
+    fronts.offsets.clear();
+    fronts.rank.assign(n, FrontSet::unranked);
+    if (n == 0) {
+        return;
+    }
+
+    build_dominance_matrix(F, n, n_obj, epsilon, workspace, n_threads);
+    peel_fronts(n, fronts, workspace, n_stop_if_ranked, max_fronts);
+}
+
+// Indices (ascending) of the points of F not dominated by any other point. Every point stops
+// at the first block of 64 that contains a dominator, so no matrix is built. Two and three
+// objectives without epsilon take the first front of the sweep sort.
+inline void find_non_dominated(const double *F, std::size_t n, std::size_t n_obj, double epsilon,
+                               std::vector<std::size_t> &non_dominated, FastSortWorkspace &workspace,
+                               std::size_t n_threads = 1) {
+    constexpr std::size_t word_bits = DominanceBitMatrix::word_bits;
+
+    non_dominated.clear();
+    if (n == 0) {
+        return;
+    }
+
+    if (epsilon == 0.0 && (n_obj == 2 || n_obj == 3)) {
+        auto &rank = workspace.previous_in_front;
+        if (n_obj == 2) {
+            sweep_ranks<2>(F, n, rank, workspace, FrontCut::unlimited, 1);
+        } else {
+            sweep_ranks<3>(F, n, rank, workspace, FrontCut::unlimited, 1);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (rank[i] == 0) {
+                non_dominated.push_back(i);
+            }
+        }
+        return;
+    }
+
+    auto &by_column = workspace.objectives_by_column;
+    ranking_detail::copy_by_column(F, n, n_obj, by_column);
+    auto &is_dominated = workspace.is_dominated;
+    is_dominated.assign(n, 0U);
+
+    const std::size_t n_tiles = (n + ranking_detail::row_tile - 1) / ranking_detail::row_tile;
+    n_threads = resolve_thread_count(n_threads, n * n, ranking_detail::min_pairs_per_thread);
+    with_objective_count(n_obj, [&](auto objectives) {
+        constexpr int M = decltype(objectives)::value;
+        parallel_for_tiles(n_tiles, n_threads, [&](std::size_t tile, std::size_t) {
+            const std::size_t i_end = std::min((tile + 1) * ranking_detail::row_tile, n);
+            for (std::size_t i = tile * ranking_detail::row_tile; i < i_end; ++i) {
+                for (std::size_t j0 = 0; j0 < n; j0 += word_bits) {
+                    std::uint64_t i_dominates = 0U;
+                    std::uint64_t dominates_i = 0U;
+                    ranking_detail::compare_block<M>(by_column.data(), n, n_obj, i, j0, std::min(word_bits, n - j0),
+                                                     epsilon, i_dominates, dominates_i);
+                    EDDIE_TELEMETRY_ADD(dominance_comparisons, std::min(word_bits, n - j0));
+                    if (dominates_i != 0U) {
+                        is_dominated[i] = 1U;
+                        break;
+                    }
+                }
+            }
+        });
+    });
+
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!is_dominated[i]) {
+            non_dominated.push_back(i);
+        }
+    }
+}
+
+struct DominanceDegreeWorkspace {
+    FastSortWorkspace sort{};
+    std::vector<std::size_t> order{};        // n_obj sorted index lists, then the lexicographic order
+    std::vector<unsigned char> tied{};       // tied[k * n + p]: sorted position p + 1 has the same value
+    std::vector<std::uint64_t> no_better{};  // running slab of points no better than the current one
+};
+
+// Fills `workspace.sort.dominates` / `n_dominated` for the row-major n x n_obj matrix F using
+// packed comparison rows. Rows start as all ones, and for every objective row i is ANDed with
+// the set of points whose value is >= F(i, k), grown while walking the sorted order from the
+// worst value down. What remains is weak dominance; pairs of identical points (including the
+// diagonal) are then cleared. The matrix is processed in column slabs small enough that all
+// objectives' passes over a slab stay in L2 cache.
+inline void build_dominance_degree_matrix(const double *F, std::size_t n, std::size_t n_obj,
+                                          DominanceDegreeWorkspace &workspace, std::size_t slab_bytes = 512 * 1024) {
+    constexpr std::size_t word_bits = DominanceBitMatrix::word_bits;
+
+    auto &bits = workspace.sort.dominates;
+    bits.reset(n);
+    const std::size_t words = bits.words_per_row();
+
+    auto &order = workspace.order;
+    auto &tied = workspace.tied;
+    order.resize((n_obj + 1) * n);
+    tied.assign(n_obj * n, 0U);
+    for (std::size_t k = 0; k < n_obj; ++k) {
+        std::size_t *idx = order.data() + k * n;
+        for (std::size_t i = 0; i < n; ++i) {
+            idx[i] = i;
+        }
+        std::sort(idx, idx + n, [F, n_obj, k](std::size_t a, std::size_t b) {
+            return F[a * n_obj + k] < F[b * n_obj + k];
+        });
+        for (std::size_t p = 0; p + 1 < n; ++p) {
+            tied[k * n + p] = F[idx[p] * n_obj + k] == F[idx[p + 1] * n_obj + k];
+        }
+    }
+
+    std::fill(bits.row(0), bits.row(0) + n * words, ~std::uint64_t{0});
+
+    const std::size_t slab_words = std::max<std::size_t>(1, std::min(words, slab_bytes / (sizeof(std::uint64_t) * n)));
+    auto &no_better = workspace.no_better;
+    no_better.resize(slab_words);
+    for (std::size_t w0 = 0; w0 < words; w0 += slab_words) {
+        const std::size_t w1 = std::min(words, w0 + slab_words);
+        const std::size_t j_begin = w0 * word_bits;
+        const std::size_t j_end = std::min(n, w1 * word_bits);
+
+        for (std::size_t k = 0; k < n_obj; ++k) {
+            const std::size_t *idx = order.data() + k * n;
+            const unsigned char *same = tied.data() + k * n;
+            std::fill(no_better.begin(), no_better.end(), 0U);
+
+            // walk groups of equal values from the worst down; a group sees itself and everything worse
+            for (std::size_t last = n; last > 0;) {
+                std::size_t first = last - 1;
+                while (first > 0 && same[first - 1]) {
+                    --first;
+                }
+                for (std::size_t p = first; p < last; ++p) {
+                    const std::size_t j = idx[p];
+                    if (j >= j_begin && j < j_end) {
+                        no_better[j / word_bits - w0] |= std::uint64_t{1} << (j % word_bits);
+                    }
+                }
+                for (std::size_t p = first; p < last; ++p) {
+                    std::uint64_t *row = bits.row(idx[p]) + w0;
+                    for (std::size_t w = 0; w < w1 - w0; ++w) {
+                        row[w] &= no_better[w];
+                    }
+                }
+                last = first;
+            }
+        }
+    }
+
+    // weak dominance both ways means identical objective vectors, which do not dominate each other
+    std::size_t *lexicographic = order.data() + n_obj * n;
+    for (std::size_t i = 0; i < n; ++i) {
+        lexicographic[i] = i;
+    }
+    std::sort(lexicographic, lexicographic + n, [F, n_obj](std::size_t a, std::size_t b) {
+        return std::lexicographical_compare(F + a * n_obj, F + (a + 1) * n_obj, F + b * n_obj, F + (b + 1) * n_obj);
+    });
+    for (std::size_t first = 0; first < n;) {
+        std::size_t last = first + 1;
+        while (last < n && std::equal(F + lexicographic[first] * n_obj, F + (lexicographic[first] + 1) * n_obj,
+                                      F + lexicographic[last] * n_obj)) {
+            ++last;
+        }
+        for (std::size_t a = first; a < last; ++a) {
+            for (std::size_t b = first; b < last; ++b) {
+                const std::size_t j = lexicographic[b];
+                bits.row(lexicographic[a])[j / word_bits] &= ~(std::uint64_t{1} << (j % word_bits));
+            }
+        }
+        first = last;
+    }
+
+    // column popcounts through 64 x 64 transposes give the number of dominators per point
+    auto &n_dominated = workspace.sort.n_dominated;
+    n_dominated.assign(n, 0U);
+    std::uint64_t block[word_bits];
+    for (std::size_t word = 0; word < words; ++word) {
+        for (std::size_t ib = 0; ib < n; ib += word_bits) {
+            const std::size_t rows = std::min(word_bits, n - ib);
+            for (std::size_t r = 0; r < word_bits; ++r) {
+                block[r] = r < rows ? bits.row(ib + r)[word] : 0U;
+            }
+            ranking_detail::transpose_block(block);
+            const std::size_t j0 = word * word_bits;
+            for (std::size_t t = 0; t < word_bits && j0 + t < n; ++t) {
+                n_dominated[j0 + t] += static_cast<std::size_t>(ranking_detail::popcount(block[t]));
+            }
+        }
+    }
+}
+
+// Dominance-degree non-dominated sort on the packed matrix; same fronts as the other sorts.
+// Two and three objectives are sorted by the sweep instead.
+inline void dominance_degree_non_dominated_sort(const double *F, std::size_t n, std::size_t n_obj, FrontSet &fronts,
+                                                DominanceDegreeWorkspace &workspace,
+                                                std::size_t n_stop_if_ranked = static_cast<std::size_t>(-1),
+                                                std::size_t max_fronts = static_cast<std::size_t>(-1)) {
+    if (n_obj == 2 || n_obj == 3) {
+        efficient_non_dominated_sort(F, n, n_obj, fronts, workspace.sort, n_stop_if_ranked, max_fronts);
+        return;
+    }
+    fronts.members.clear();
+    fronts.offsets.clear();
+    fronts.rank.assign(n, FrontSet::unranked);
+    if (n == 0) {
+        return;
+    }
+
+    build_dominance_degree_matrix(F, n, n_obj, workspace);
+    peel_fronts(n, fronts, workspace.sort, n_stop_if_ranked, max_fronts);
+}
+
+// Convenience entry point for the Cython layer: returns the fronts as nested index lists.
+inline std::vector<std::vector<int>> fast_non_dominated_sort_fronts(const double *F, std::size_t n,
+                                                                    std::size_t n_obj, double epsilon,
+                                                                    std::size_t n_stop_if_ranked,
+                                                                    std::size_t max_fronts,
+                                                                    std::size_t n_threads) {
+    FrontSet fronts;
+    FastSortWorkspace workspace;
+    fast_non_dominated_sort(F, n, n_obj, fronts, workspace, epsilon, n_stop_if_ranked, max_fronts, n_threads);
+
+    return ranking_detail::to_nested(fronts);
+}
+
+inline std::vector<int> find_non_dominated_indices(const double *F, std::size_t n, std::size_t n_obj,
+                                                   double epsilon, std::size_t n_threads) {
+    std::vector<std::size_t> non_dominated;
+    FastSortWorkspace workspace;
+    find_non_dominated(F, n, n_obj, epsilon, non_dominated, workspace, n_threads);
+    return std::vector<int>(non_dominated.begin(), non_dominated.end());
+}
+
+inline std::vector<std::vector<int>> dominance_degree_non_dominated_sort_fronts(const double *F, std::size_t n,
+                                                                                std::size_t n_obj) {
+    FrontSet fronts;
+    DominanceDegreeWorkspace workspace;
+    dominance_degree_non_dominated_sort(F, n, n_obj, fronts, workspace);
+    return ranking_detail::to_nested(fronts);
+}
+
+#endif // EDDIE_RANKING_H
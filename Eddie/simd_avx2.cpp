@@ -0,0 +1,12 @@
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(__AVX2__)
+#error "simd_avx2.cpp must be compiled with -mavx2 (/arch:AVX2)"
+#endif
+
+#define EDDIE_SIMD_NAMESPACE simd_avx2
+#include "simd_kernels.inc"
+
+const SimdKernels &simd_kernels_avx2() {
+    static const SimdKernels kernels{SimdLevel::avx2, simd_avx2::perpendicular_rows, simd_avx2::pbi_tile,
+                                     simd_avx2::tchebycheff_tile, simd_avx2::asf_tile};
+    return kernels;
+}
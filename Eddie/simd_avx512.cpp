@@ -0,0 +1,12 @@
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(__AVX512F__)
+#error "simd_avx512.cpp must be compiled with -mavx512f (/arch:AVX512)"
+#endif
+
+#define EDDIE_SIMD_NAMESPACE simd_avx512
+#include "simd_kernels.inc"
+
+const SimdKernels &simd_kernels_avx512() {
+    static const SimdKernels kernels{SimdLevel::avx512, simd_avx512::perpendicular_rows, simd_avx512::pbi_tile,
+                                     simd_avx512::tchebycheff_tile, simd_avx512::asf_tile};
+    return kernels;
+}
@@ -0,0 +1,20 @@
+#include "simd_kernels.h"
+
+const SimdKernels &simd_kernels(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::avx512:
+        return simd_kernels_avx512();
+    case SimdLevel::avx2:
+        return simd_kernels_avx2();
+    case SimdLevel::sse4:
+        return simd_kernels_sse4();
+    case SimdLevel::scalar:
+        break;
+    }
+    return simd_kernels_scalar();
+}
+
+const SimdKernels &simd_kernels() {
+    static const SimdKernels &kernels = simd_kernels(active_simd_level());
+    return kernels;
+}
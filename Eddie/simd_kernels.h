@@ -0,0 +1,65 @@
+#ifndef EDDIE_SIMD_KERNELS_H
+#define EDDIE_SIMD_KERNELS_H
+
+#include <cstddef>
+
+#include "cpu_features.h"
+
+// Inner loops of the tiled kernels, compiled once per SimdLevel and chosen at run time.
+//
+// The bodies live in simd_kernels.inc, which simd_scalar.cpp, simd_sse4.cpp, simd_avx2.cpp and
+// simd_avx512.cpp include into their own namespace with their own target flags. They vectorize
+// across the 64 columns of a packed tile and keep the order of every floating-point operation
+// per output element, and the variants are built without FMA contraction, so all levels return
+// bit-identical results: nodes with different CPUs in one run (islands over MPI, a resumed
+// checkpoint) still agree. `simd_kernels()` returns the table of `active_simd_level()`.
+//
+// The callers keep the packing and the threading (perpendicular_distance.h, decomposition.h);
+// they are header-only but need this table, i.e. the Eddie core library (`make -C Eddie core`,
+// or the eddie_core library of setup.py for the compiled pymoo modules).
+
+namespace simd_detail {
+
+// Columns of a packed tile: objective k of column c is at tile[k * tile_width + c].
+constexpr std::size_t tile_width = 64;
+
+// Point rows whose dot products with one tile of lines are accumulated together.
+constexpr std::size_t block_rows = 3;
+constexpr std::size_t block_cols = 8;
+
+} // namespace simd_detail
+
+// Perpendicular distances of the points [begin, end) of P (row-major, n_dim columns) to the
+// n_lines lines of L, given L and L / |L| packed into n_line_tiles tiles each and the line norms
+// (padded to whole tiles with ones). Writes the rows [begin, end) of the row-major
+// n_points x n_lines `out`.
+using PerpendicularRowsKernel = void (*)(const double *P, std::size_t n_dim, std::size_t begin, std::size_t end,
+                                         const double *tiles, const double *unit_tiles, std::size_t n_line_tiles,
+                                         const double *line_norm, std::size_t n_lines, double *out);
+
+// values[c] = g(f | w_c) for one shifted point f (n_obj values) and the 64 weights of the tile w
+// with norms `norm`; theta is only read by PBI.
+using DecompositionTileKernel = void (*)(const double *f, const double *w, const double *norm, std::size_t n_obj,
+                                         double theta, double *values);
+
+struct SimdKernels {
+    SimdLevel level;
+    PerpendicularRowsKernel perpendicular_rows;
+    DecompositionTileKernel pbi_tile;
+    DecompositionTileKernel tchebycheff_tile;
+    DecompositionTileKernel asf_tile;
+};
+
+// The table of one level. Every level exists in every build; on other architectures than x86-64
+// the higher ones are compiled without target flags and never selected.
+const SimdKernels &simd_kernels_scalar();
+const SimdKernels &simd_kernels_sse4();
+const SimdKernels &simd_kernels_avx2();
+const SimdKernels &simd_kernels_avx512();
+
+const SimdKernels &simd_kernels(SimdLevel level);
+
+// The table of active_simd_level(), resolved on the first call.
+const SimdKernels &simd_kernels();
+
+#endif // EDDIE_SIMD_KERNELS_H
@@ -0,0 +1,10 @@
+// The baseline of the target (SSE2 on x86-64), also the only level used on other architectures.
+
+#define EDDIE_SIMD_NAMESPACE simd_scalar
+#include "simd_kernels.inc"
+
+const SimdKernels &simd_kernels_scalar() {
+    static const SimdKernels kernels{SimdLevel::scalar, simd_scalar::perpendicular_rows, simd_scalar::pbi_tile,
+                                     simd_scalar::tchebycheff_tile, simd_scalar::asf_tile};
+    return kernels;
+}
@@ -0,0 +1,12 @@
+#if defined(__x86_64__) && !defined(__SSE4_2__)
+#error "simd_sse4.cpp must be compiled with -msse4.2"
+#endif
+
+#define EDDIE_SIMD_NAMESPACE simd_sse4
+#include "simd_kernels.inc"
+
+const SimdKernels &simd_kernels_sse4() {
+    static const SimdKernels kernels{SimdLevel::sse4, simd_sse4::perpendicular_rows, simd_sse4::pbi_tile,
+                                     simd_sse4::tchebycheff_tile, simd_sse4::asf_tile};
+    return kernels;
+}
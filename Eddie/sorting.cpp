@@ -0,0 +1,106 @@
+#include "sorting.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "dominance.h"
+#include "ranking.h"
+
+namespace {
+constexpr std::size_t no_point = static_cast<std::size_t>(-1);
+}
+
+void SortWorkspace::reserve(std::size_t n_points) {
+    order.reserve(n_points);
+    previous_in_front.reserve(n_points);
+    front_tail.reserve(n_points);
+    front_size.reserve(n_points);
+}
+
+void non_dominated_sort(const ObjectiveMatrix &objectives, FrontSet &fronts, SortWorkspace &workspace,
+                        std::size_t n_stop_if_ranked) {
+    const std::size_t n_points = objectives.rows();
+    const std::size_t n_obj = objectives.cols();
+
+    fronts.members.clear();
+    fronts.offsets.clear();
+    fronts.rank.assign(n_points, FrontSet::unranked);
+    if (n_points == 0) {
+        return;
+    }
+    if (n_obj == 2) {
+        sweep_non_dominated_sort<2>(objectives.row(0).data(), n_points, fronts, workspace, n_stop_if_ranked);
+        return;
+    }
+    if (n_obj == 3) {
+        sweep_non_dominated_sort<3>(objectives.row(0).data(), n_points, fronts, workspace, n_stop_if_ranked);
+        return;
+    }
+
+    auto &order = workspace.order;
+    order.resize(n_points);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::sort(order.begin(), order.end(), [&objectives, n_obj](std::size_t a, std::size_t b) {
+        const double *fa = objectives.row(a).data();
+        const double *fb = objectives.row(b).data();
+        return std::lexicographical_compare(fa, fa + n_obj, fb, fb + n_obj);
+    });
+
+    // each front is a singly linked list running backwards from its tail, so that the most
+    // recently inserted (and most likely dominating) members are examined first
+    workspace.previous_in_front.assign(n_points, no_point);
+    workspace.front_tail.clear();
+    workspace.front_size.clear();
+    FrontCut cut(n_stop_if_ranked);
+
+    for (const std::size_t p : order) {
+        const double *fp = objectives.row(p).data();
+        const std::size_t n_searched = std::min(workspace.front_tail.size(), cut.limit());
+        std::size_t k = 0;
+        for (; k < n_searched; ++k) {
+            bool dominated = false;
+            for (std::size_t q = workspace.front_tail[k]; q != no_point; q = workspace.previous_in_front[q]) {
+                // earlier points in lexicographic order can never be dominated by p
+                if (dominance_relation(objectives.row(q).data(), fp, n_obj) == 1) {
+                    dominated = true;
+                    break;
+                }
+            }
+            if (!dominated) {
+                break;
+            }
+        }
+        if (!cut.keeps(k)) {
+            continue;
+        }
+
+        if (k == workspace.front_tail.size()) {
+            workspace.front_tail.push_back(no_point);
+            workspace.front_size.push_back(0);
+        }
+        workspace.previous_in_front[p] = workspace.front_tail[k];
+        workspace.front_tail[k] = p;
+        ++workspace.front_size[k];
+        fronts.rank[p] = k;
+        cut.add(workspace.front_size.data(), workspace.front_size.size());
+    }
+
+    // fronts behind the cut may have been started before it moved up
+    const std::size_t n_fronts = std::min(workspace.front_size.size(), cut.limit());
+    fronts.offsets.resize(n_fronts + 1);
+    fronts.offsets[0] = 0;
+    for (std::size_t k = 0; k < n_fronts; ++k) {
+        fronts.offsets[k + 1] = fronts.offsets[k] + workspace.front_size[k];
+    }
+
+    // scatter in lexicographic order, reusing front_size as the per-front write cursor
+    fronts.members.resize(fronts.offsets[n_fronts]);
+    std::copy(fronts.offsets.begin(), fronts.offsets.end() - 1, workspace.front_size.begin());
+    for (const std::size_t p : order) {
+        if (fronts.rank[p] >= n_fronts) {
+            fronts.rank[p] = FrontSet::unranked;
+            continue;
+        }
+        fronts.members[workspace.front_size[fronts.rank[p]]++] = p;
+    }
+}
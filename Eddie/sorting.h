@@ -0,0 +1,30 @@
+#ifndef EDDIE_SORTING_H
+#define EDDIE_SORTING_H
+
+#include <cstddef>
+#include <vector>
+
+#include "fronts.h"
+#include "population.h"
+
+// Scratch buffers for the non-dominated sort. Reserve once for the largest expected point count.
+struct SortWorkspace {
+    std::vector<std::size_t> order{};
+    std::vector<std::size_t> previous_in_front{};
+    std::vector<std::size_t> front_tail{};
+    std::vector<std::size_t> front_size{};
+    std::vector<std::vector<std::size_t>> staircases{};  // three objectives, one per front
+
+    void reserve(std::size_t n_points);
+};
+
+// Efficient non-dominated sort with sequential search (ENS-SS): points are visited in
+// lexicographic order and placed into the first front that holds no dominating member. Two and
+// three objectives use the O(n log n) sweep of ranking.h.
+// With `n_stop_if_ranked`, only the fronts up to the one that reaches that many points are
+// built (see FrontCut); the remaining points keep rank FrontSet::unranked.
+// Does not allocate once `fronts` and `workspace` are reserved for `objectives.rows()` points.
+void non_dominated_sort(const ObjectiveMatrix &objectives, FrontSet &fronts, SortWorkspace &workspace,
+                        std::size_t n_stop_if_ranked = FrontCut::unlimited);
+
+#endif // EDDIE_SORTING_H
@@ -0,0 +1,197 @@
+#include "steady_state.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "crowding.h"
+#include "initpop.h"
+#include "operators.h"
+#include "telemetry.h"
+#include "telemetry_report.h"
+
+double SteadyStateStats::utilization() const {
+    const double available = wall_seconds * static_cast<double>(slots);
+    return available > 0.0 ? busy_seconds / available : 0.0;
+}
+
+double SteadyStateStats::evaluations_per_slot_hour() const {
+    const double slot_hours = wall_seconds * static_cast<double>(slots) / 3600.0;
+    return slot_hours > 0.0 ? static_cast<double>(evaluations) / slot_hours : 0.0;
+}
+
+SteadyStateNSGA2::SteadyStateNSGA2(const OptimizationParameters &params, const Problem &problem)
+    : params_(params),
+      problem_(problem),
+      rng_(params.random_seed),
+      ranking_(problem.n_obj()),
+      archive_(problem.n_var(), problem.n_obj()) {
+    if (params_.population_size < 2) {
+        throw std::invalid_argument("Steady-state NSGA-II requires a population of at least two");
+    }
+    if (params_.max_in_flight == 0) {
+        throw std::invalid_argument("Steady-state NSGA-II requires at least one evaluation slot");
+    }
+    if (problem_.n_constr() != 0) {
+        throw std::invalid_argument("Steady-state NSGA-II does not support constrained problems yet");
+    }
+    if (decision_dimension(params_) != problem_.n_var()) {
+        throw std::invalid_argument("Number of design variables does not match the problem");
+    }
+
+    decision_bounds(params_, lower_, upper_);
+    budget_ = params_.population_size + params_.max_generations * params_.offspring_population_size;
+
+    const std::size_t capacity = params_.population_size + 1;
+    population_.resize(0, problem_.n_var());
+    population_.reserve(capacity * problem_.n_var());
+    objectives_.resize(0, problem_.n_obj());
+    objectives_.reserve(capacity * problem_.n_obj());
+    row_ids_.reserve(capacity);
+    fronts_.reserve(capacity);
+    front_cursor_.reserve(capacity + 1);
+    crowding_.reserve(capacity);
+    crowding_scratch_.reserve(capacity);
+    children_.resize(2, problem_.n_var());
+}
+
+void SteadyStateNSGA2::run() {
+    EvaluationJobQueue queue(problem_, params_.max_in_flight);
+    const auto start = std::chrono::steady_clock::now();
+
+    // the initial design is queued at once; offspring start as soon as the queue runs dry
+    const auto initial = latin_hypercube_population(params_, rng_);
+    for (std::size_t i = 0; i < initial.rows() && submitted_ < budget_; ++i) {
+        queue.submit(initial.row(i));
+        ++submitted_;
+    }
+
+    // telemetry rows every offspring_population_size results after the initial design
+    const std::size_t mu = params_.population_size;
+    const std::size_t lambda = params_.offspring_population_size;
+    EvaluationResult result;
+    while (queue.wait_result(result)) {
+        accept(result);
+        refill(queue);
+
+        const std::size_t returned = stats_.evaluations + stats_.failed_evaluations;
+        if (telemetry_ != nullptr && returned >= mu && (lambda == 0 || (returned - mu) % lambda == 0)) {
+            telemetry_->record(lambda == 0 ? 0 : (returned - mu) / lambda);
+        }
+    }
+
+    stats_.slots = queue.slots();
+    stats_.busy_seconds = queue.busy_seconds();
+    stats_.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void SteadyStateNSGA2::accept(const EvaluationResult &result) {
+    if (result.error) {
+        ++stats_.failed_evaluations;
+        return;
+    }
+    ++stats_.evaluations;
+
+    const Span<const double> x(result.x.data(), result.x.size());
+    const Span<const double> f(result.f.data(), result.f.size());
+    archive_.insert(x, f);
+
+    const std::size_t row = population_.rows();
+    population_.resize(row + 1, problem_.n_var());
+    objectives_.resize(row + 1, problem_.n_obj());
+    std::copy(x.begin(), x.end(), population_.row(row).begin());
+    std::copy(f.begin(), f.end(), objectives_.row(row).begin());
+    {
+        EDDIE_TELEMETRY_SCOPE(ranking);
+        row_ids_.push_back(ranking_.insert(f.data()));
+    }
+
+    update_ranking();
+    if (population_.rows() > params_.population_size) {
+        remove_worst();
+        update_ranking();
+    }
+}
+
+void SteadyStateNSGA2::refill(EvaluationJobQueue &queue) {
+    if (population_.rows() < 2) {
+        return;
+    }
+    while (submitted_ < budget_ && queue.pending() == 0 && queue.outstanding() < queue.slots()) {
+        submit_offspring(queue);
+    }
+}
+
+void SteadyStateNSGA2::update_ranking() {
+    EDDIE_TELEMETRY_SCOPE(crowding);
+    // ranks are already up to date; only the compressed front lists are rebuilt, ordered by row
+    const std::size_t n = population_.rows();
+    const std::size_t n_fronts = ranking_.n_fronts();
+    fronts_.rank.resize(n);
+    fronts_.offsets.assign(n_fronts + 1, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        fronts_.rank[i] = ranking_.rank(row_ids_[i]);
+        ++fronts_.offsets[fronts_.rank[i] + 1];
+    }
+    for (std::size_t k = 0; k < n_fronts; ++k) {
+        fronts_.offsets[k + 1] += fronts_.offsets[k];
+    }
+    fronts_.members.resize(n);
+    front_cursor_.assign(fronts_.offsets.begin(), fronts_.offsets.end() - 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        fronts_.members[front_cursor_[fronts_.rank[i]]++] = i;
+    }
+
+    crowding_.resize(objectives_.rows());
+    const Span<double> distance(crowding_.data(), crowding_.size());
+    for (std::size_t k = 0; k < fronts_.size(); ++k) {
+        crowding_distance(objectives_, fronts_.front(k), distance, crowding_scratch_);
+    }
+}
+
+void SteadyStateNSGA2::remove_worst() {
+    const auto last_front = fronts_.front(fronts_.size() - 1);
+    const std::size_t worst = *std::min_element(last_front.begin(), last_front.end(),
+                                                [this](std::size_t a, std::size_t b) {
+                                                    return crowding_[a] < crowding_[b];
+                                                });
+
+    const std::size_t last = population_.rows() - 1;
+    {
+        EDDIE_TELEMETRY_SCOPE(ranking);
+        ranking_.remove(row_ids_[worst]);
+    }
+    if (worst != last) {
+        population_.copy_row_from(population_, last, worst);
+        objectives_.copy_row_from(objectives_, last, worst);
+        row_ids_[worst] = row_ids_[last];
+    }
+    row_ids_.pop_back();
+    population_.resize(last, problem_.n_var());
+    objectives_.resize(last, problem_.n_obj());
+}
+
+void SteadyStateNSGA2::submit_offspring(EvaluationJobQueue &queue) {
+    // SBX yields two children; the second one is kept for the next free slot
+    if (!has_spare_child_) {
+        EDDIE_TELEMETRY_SCOPE(variation);
+        const Span<const double> lower(lower_.data(), lower_.size());
+        const Span<const double> upper(upper_.data(), upper_.size());
+        const std::size_t a = binary_tournament(rank(), crowding(), rng_);
+        const std::size_t b = binary_tournament(rank(), crowding(), rng_);
+
+        sbx_crossover(population_.row(a), population_.row(b), children_.row(0), children_.row(1), lower, upper,
+                      params_.distribution_index_crossover, params_.crossover_probability, rng_);
+        for (std::size_t c = 0; c < 2; ++c) {
+            polynomial_mutation(children_.row(c), lower, upper, params_.distribution_index_mutation,
+                                params_.mutation_probability, rng_);
+        }
+
+        queue.submit(children_.row(0));
+        has_spare_child_ = true;
+    } else {
+        queue.submit(children_.row(1));
+        has_spare_child_ = false;
+    }
+    ++submitted_;
+}
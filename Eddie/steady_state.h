@@ -0,0 +1,91 @@
+#ifndef EDDIE_STEADY_STATE_H
+#define EDDIE_STEADY_STATE_H
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "archive.h"
+#include "evaluator.h"
+#include "fronts.h"
+#include "job_queue.h"
+#include "parameter.h"
+#include "pareto_archive.h"
+#include "population.h"
+
+class TelemetryReport;
+
+struct SteadyStateStats {
+    std::size_t evaluations = 0;
+    std::size_t failed_evaluations = 0;
+    std::size_t slots = 0;
+    double wall_seconds = 0.0;
+    double busy_seconds = 0.0;
+
+    // Fraction of the available slot time spent inside evaluations.
+    double utilization() const;
+
+    // Completed evaluations per slot (license) hour of wall time.
+    double evaluations_per_slot_hour() const;
+};
+
+// Asynchronous steady-state NSGA-II for expensive evaluations with widely varying run times.
+//
+// Up to `max_in_flight` evaluations run at once. Every finished evaluation is merged into the
+// population immediately with (mu + 1) survival (the most crowded member of the last front is
+// dropped) and into an unbounded non-dominated archive, and a new offspring is submitted right
+// away, so no slot waits for the slowest case of a generation. Ranks are kept up to date by a
+// `ParetoArchive` instead of re-sorting the population after every result. The evaluation
+// budget equals the generational one: population_size + max_generations * offspring_population_size.
+class SteadyStateNSGA2 {
+public:
+    SteadyStateNSGA2(const OptimizationParameters &params, const Problem &problem);
+
+    void run();
+
+    // Makes `run()` write a telemetry row after the initial design and then after every
+    // offspring_population_size returned evaluations (one generation's worth).
+    void set_telemetry(TelemetryReport *report) { telemetry_ = report; }
+
+    std::size_t evaluation_budget() const { return budget_; }
+    const PopulationMatrix &population() const { return population_; }
+    const ObjectiveMatrix &objectives() const { return objectives_; }
+    Span<const std::size_t> rank() const { return Span<const std::size_t>(fronts_.rank.data(), fronts_.rank.size()); }
+    Span<const double> crowding() const { return Span<const double>(crowding_.data(), crowding_.size()); }
+    const NonDominatedArchive &archive() const { return archive_; }
+    const SteadyStateStats &stats() const { return stats_; }
+
+private:
+    void accept(const EvaluationResult &result);
+    void refill(EvaluationJobQueue &queue);
+    void update_ranking();
+    void remove_worst();
+    void submit_offspring(EvaluationJobQueue &queue);
+
+    OptimizationParameters params_;
+    const Problem &problem_;
+    std::mt19937 rng_;
+    std::size_t budget_ = 0;
+    std::size_t submitted_ = 0;
+    TelemetryReport *telemetry_ = nullptr;
+
+    std::vector<double> lower_{};
+    std::vector<double> upper_{};
+
+    PopulationMatrix population_{};
+    ObjectiveMatrix objectives_{};
+    ParetoArchive ranking_;
+    std::vector<ParetoArchive::Id> row_ids_{};
+    FrontSet fronts_{};
+    std::vector<std::size_t> front_cursor_{};
+    std::vector<double> crowding_{};
+    std::vector<std::size_t> crowding_scratch_{};
+
+    PopulationMatrix children_{};
+    bool has_spare_child_ = false;
+
+    NonDominatedArchive archive_;
+    SteadyStateStats stats_{};
+};
+
+#endif // EDDIE_STEADY_STATE_H
@@ -0,0 +1,62 @@
+#ifndef EDDIE_STOCHASTIC_RANKING_H
+#define EDDIE_STOCHASTIC_RANKING_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "parallel.h"
+#include "philox.h"
+
+// Stochastic ranking (Runarsson and Yao, 2000): a bubble sort of `order` in which adjacent
+// individuals are compared by objective f with probability pr, or when both are feasible
+// (phi == 0), and by constraint violation phi otherwise. At most n sweeps are made and the sort
+// stops after the first sweep without a swap.
+//
+// The coin of comparison j in sweep s is u(s * n + j) of the Philox stream (seed, stream), so a
+// ranking is a pure function of its inputs and the seed, and comparisons between two feasible
+// individuals skip their draw without shifting the others. `stochastic_ranking_batch` ranks
+// independent populations (e.g. one per island) on n_threads threads, ranking r on stream r.
+//
+// Header-only and free of other Eddie dependencies (besides parallel.h and philox.h) so the
+// compiled pymoo module can share it (pymoo/functions/compiled/stochastic_ranking.pyx).
+
+// `order` holds a permutation of [0, n) on entry (the initial ranking) and the ranking on exit.
+template <typename Index>
+void stochastic_ranking(const double *f, const double *phi, std::size_t n, double pr, std::uint64_t seed,
+                        std::uint64_t stream, Index *order) {
+    PhiloxUniformStream uniform(seed, stream);
+    for (std::size_t sweep = 0; sweep < n; ++sweep) {
+        const std::uint64_t offset = static_cast<std::uint64_t>(sweep) * n;
+        bool swapped = false;
+        for (std::size_t j = 0; j + 1 < n; ++j) {
+            const Index a = order[j];
+            const Index b = order[j + 1];
+            const bool by_objective = (phi[a] == 0.0 && phi[b] == 0.0) || uniform(offset + j) < pr;
+            if (by_objective ? f[a] > f[b] : phi[a] > phi[b]) {
+                order[j] = b;
+                order[j + 1] = a;
+                swapped = true;
+            }
+        }
+        if (!swapped) {
+            break;
+        }
+    }
+}
+
+// Ranks the rows of the row-major n_rankings x n matrices f and phi, each into the matching row
+// of `order`. Row 0 is ranked exactly like `stochastic_ranking` with stream 0.
+template <typename Index>
+void stochastic_ranking_batch(const double *f, const double *phi, std::size_t n_rankings, std::size_t n, double pr,
+                              std::uint64_t seed, Index *order, std::size_t n_threads = 1) {
+    // a full sort makes up to n * n comparisons
+    constexpr std::size_t min_comparisons_per_thread = std::size_t{1} << 20;
+    n_threads = resolve_thread_count(n_threads, n_rankings * n * n, min_comparisons_per_thread);
+    n_threads = std::min(n_threads, n_rankings);
+    parallel_for_tiles(n_rankings, n_threads, [&](std::size_t r, std::size_t) {
+        stochastic_ranking(f + r * n, phi + r * n, n, pr, seed, r, order + r * n);
+    });
+}
+
+#endif // EDDIE_STOCHASTIC_RANKING_H
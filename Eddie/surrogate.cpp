@@ -0,0 +1,335 @@
+#include "surrogate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "parallel.h"
+
+namespace {
+
+// rows of a `predict` batch handed to a thread at a time
+constexpr std::size_t prediction_tile = 16;
+
+// b = L⁻¹ b for n x Width row-major b; the fixed width lets the column loop unroll into vectors
+template <std::size_t Width>
+void forward_solve_tile(const double *factor, std::size_t stride, std::size_t n, double *b) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const double *row = factor + i * stride;
+        double acc[Width];
+        std::copy(b + i * Width, b + (i + 1) * Width, acc);
+        for (std::size_t j = 0; j < i; ++j) {
+            const double l = row[j];
+            const double *bj = b + j * Width;
+            for (std::size_t c = 0; c < Width; ++c) {
+                acc[c] -= l * bj[c];
+            }
+        }
+        for (std::size_t c = 0; c < Width; ++c) {
+            b[i * Width + c] = acc[c] / row[i];
+        }
+    }
+}
+
+} // namespace
+
+KrigingSurrogate::KrigingSurrogate(std::vector<double> lower, std::vector<double> upper, std::size_t n_obj,
+                                   std::size_t capacity, double length_scale, double nugget)
+    : lower_(std::move(lower)), n_obj_(n_obj), capacity_(capacity), length_scale_(length_scale), nugget_(nugget) {
+    if (lower_.empty() || upper.size() != lower_.size() || n_obj_ == 0) {
+        throw std::invalid_argument("Surrogate bounds do not match the problem dimensions");
+    }
+    if (capacity_ < 2) {
+        throw std::invalid_argument("The surrogate must hold at least two points");
+    }
+    if (!(nugget_ > 0.0) || !std::isfinite(length_scale_)) {
+        throw std::invalid_argument("The surrogate needs a positive nugget and a finite length scale");
+    }
+    if (length_scale_ <= 0.0) {
+        length_scale_ = std::sqrt(static_cast<double>(lower_.size())) / 4.0;
+    }
+
+    scale_.resize(lower_.size());
+    for (std::size_t j = 0; j < lower_.size(); ++j) {
+        const double range = upper[j] - lower_[j];
+        scale_[j] = range > 0.0 ? 1.0 / range : 0.0;
+    }
+
+    points_.resize(capacity_ * n_var());
+    values_.resize(capacity_ * n_obj_);
+    factor_.resize(capacity_ * capacity_);
+    weights_.resize(capacity_ * n_obj_);
+    mean_.assign(n_obj_, 0.0);
+    variance_.assign(n_obj_, 0.0);
+    scratch_.resize(capacity_ * (n_obj_ + 1));
+}
+
+void KrigingSurrogate::normalize(Span<const double> x, double *out) const {
+    for (std::size_t j = 0; j < n_var(); ++j) {
+        out[j] = (x[j] - lower_[j]) * scale_[j];
+    }
+}
+
+double KrigingSurrogate::kernel(const double *a, const double *b) const {
+    double distance = 0.0;
+    for (std::size_t j = 0; j < n_var(); ++j) {
+        const double d = a[j] - b[j];
+        distance += d * d;
+    }
+    return std::exp(-distance / (2.0 * length_scale_ * length_scale_));
+}
+
+void KrigingSurrogate::forward_solve(double *b, std::size_t width) const {
+    if (width == 1) {
+        // a single right-hand side: one dot product per row, accumulated in a register
+        for (std::size_t i = 0; i < size_; ++i) {
+            const double *row = factor_.data() + i * capacity_;
+            double sum = b[i];
+            for (std::size_t j = 0; j < i; ++j) {
+                sum -= row[j] * b[j];
+            }
+            b[i] = sum / row[i];
+        }
+        return;
+    }
+    if (width == prediction_tile) {
+        forward_solve_tile<prediction_tile>(factor_.data(), capacity_, size_, b);
+        return;
+    }
+    for (std::size_t i = 0; i < size_; ++i) {
+        const double *row = factor_.data() + i * capacity_;
+        double *bi = b + i * width;
+        for (std::size_t j = 0; j < i; ++j) {
+            const double *bj = b + j * width;
+            for (std::size_t c = 0; c < width; ++c) {
+                bi[c] -= row[j] * bj[c];
+            }
+        }
+        for (std::size_t c = 0; c < width; ++c) {
+            bi[c] /= row[i];
+        }
+    }
+}
+
+bool KrigingSurrogate::add(Span<const double> x, Span<const double> f) {
+    if (x.size() != n_var() || f.size() != n_obj_) {
+        throw std::invalid_argument("Surrogate sample does not match the problem dimensions");
+    }
+    if (size_ == capacity_) {
+        rebuild(capacity_ / 2);
+    }
+    double *z = points_.data() + size_ * n_var();
+    normalize(x, z);
+    return append(z, f.data());
+}
+
+bool KrigingSurrogate::append(const double *z, const double *f) {
+    // new row of L: l = L⁻¹ k(X, z) and the pivot sqrt(k(z, z) + nugget − |l|²)
+    double *row = factor_.data() + size_ * capacity_;
+    for (std::size_t i = 0; i < size_; ++i) {
+        row[i] = kernel(points_.data() + i * n_var(), z);
+    }
+    forward_solve(row, 1);
+    double pivot = 1.0 + nugget_;
+    for (std::size_t i = 0; i < size_; ++i) {
+        pivot -= row[i] * row[i];
+    }
+    // the exact pivot is at least the nugget; far below it, z duplicates a held point
+    if (!(pivot > 0.5 * nugget_)) {
+        return false;
+    }
+    row[size_] = std::sqrt(pivot);
+
+    double *point = points_.data() + size_ * n_var();
+    if (point != z) {
+        std::copy(z, z + n_var(), point);
+    }
+    std::copy(f, f + n_obj_, values_.data() + size_ * n_obj_);
+    ++size_;
+    fitted_ = false;
+    return true;
+}
+
+void KrigingSurrogate::rebuild(std::size_t keep) {
+    // keeps the newest points and refactors them one row at a time
+    const std::size_t first = size_ - keep;
+    std::copy(points_.begin() + static_cast<std::ptrdiff_t>(first * n_var()),
+              points_.begin() + static_cast<std::ptrdiff_t>(size_ * n_var()), points_.begin());
+    std::copy(values_.begin() + static_cast<std::ptrdiff_t>(first * n_obj_),
+              values_.begin() + static_cast<std::ptrdiff_t>(size_ * n_obj_), values_.begin());
+
+    // fewer points only raise the pivots, so none of the kept ones is rejected as a duplicate
+    size_ = 0;
+    for (std::size_t i = 0; i < keep; ++i) {
+        append(points_.data() + i * n_var(), values_.data() + i * n_obj_);
+    }
+}
+
+void KrigingSurrogate::fit() {
+    const std::size_t n = size_;
+    const std::size_t width = n_obj_ + 1;
+    fitted_ = true;
+    if (n == 0) {
+        return;
+    }
+
+    // K⁻¹ [Y 1] with two triangular solves, the second also by rows of L
+    double *b = scratch_.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        std::copy(values_.data() + i * n_obj_, values_.data() + (i + 1) * n_obj_, b + i * width);
+        b[i * width + n_obj_] = 1.0;
+    }
+    forward_solve(b, width);
+    for (std::size_t i = n; i-- > 0;) {
+        const double *row = factor_.data() + i * capacity_;
+        double *bi = b + i * width;
+        for (std::size_t c = 0; c < width; ++c) {
+            bi[c] /= row[i];
+        }
+        for (std::size_t j = 0; j < i; ++j) {
+            double *bj = b + j * width;
+            for (std::size_t c = 0; c < width; ++c) {
+                bj[c] -= row[j] * bi[c];
+            }
+        }
+    }
+
+    // generalized least-squares mean 1ᵀK⁻¹y / 1ᵀK⁻¹1, then weights K⁻¹(y − mean) and the
+    // maximum-likelihood process variance (y − mean)ᵀ K⁻¹ (y − mean) / n
+    double ones = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        ones += b[i * width + n_obj_];
+    }
+    for (std::size_t m = 0; m < n_obj_; ++m) {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += b[i * width + m];
+        }
+        mean_[m] = sum / ones;
+
+        double quadratic = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double weight = b[i * width + m] - mean_[m] * b[i * width + n_obj_];
+            weights_[i * n_obj_ + m] = weight;
+            quadratic += (values_[i * n_obj_ + m] - mean_[m]) * weight;
+        }
+        variance_[m] = std::max(quadratic / static_cast<double>(n), 0.0);
+    }
+}
+
+void KrigingSurrogate::predict(const double *x, std::size_t rows, double *mean, double *sd,
+                               std::size_t n_threads) const {
+    if (!fitted_) {
+        throw std::logic_error("KrigingSurrogate::predict called before fit");
+    }
+    if (size_ == 0) {
+        std::fill(mean, mean + rows * n_obj_, 0.0);
+        std::fill(sd, sd + rows * n_obj_, std::numeric_limits<double>::infinity());
+        return;
+    }
+
+    const std::size_t n = size_;
+    const std::size_t n_tiles = (rows + prediction_tile - 1) / prediction_tile;
+    // every point costs a kernel row and its share of a tile's triangular solve, O(n²) in total
+    n_threads = resolve_thread_count(n_threads, n_tiles, 1);
+    const std::size_t buffer_size = n * prediction_tile + prediction_tile * n_var();
+    std::vector<double> buffers(n_threads * buffer_size);
+
+    parallel_for_tiles(n_tiles, n_threads, [&](std::size_t tile, std::size_t thread) {
+        // k(X, z) of the tile's points as the columns of an n x prediction_tile block
+        double *k = buffers.data() + thread * buffer_size;
+        double *z = k + n * prediction_tile;
+        const std::size_t begin = tile * prediction_tile;
+        const std::size_t width = std::min(rows, begin + prediction_tile) - begin;
+        for (std::size_t c = 0; c < width; ++c) {
+            normalize(Span<const double>(x + (begin + c) * n_var(), n_var()), z + c * n_var());
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const double *point = points_.data() + i * n_var();
+            for (std::size_t c = 0; c < width; ++c) {
+                k[i * width + c] = kernel(point, z + c * n_var());
+            }
+        }
+
+        for (std::size_t c = 0; c < width; ++c) {
+            std::copy(mean_.begin(), mean_.end(), mean + (begin + c) * n_obj_);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const double *w = weights_.data() + i * n_obj_;
+            for (std::size_t c = 0; c < width; ++c) {
+                double *mu = mean + (begin + c) * n_obj_;
+                for (std::size_t m = 0; m < n_obj_; ++m) {
+                    mu[m] += k[i * width + c] * w[m];
+                }
+            }
+        }
+
+        // posterior variance factor 1 − kᵀK⁻¹k = 1 − |L⁻¹k|²
+        forward_solve(k, width);
+        double explained[prediction_tile] = {};
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t c = 0; c < width; ++c) {
+                explained[c] += k[i * width + c] * k[i * width + c];
+            }
+        }
+        for (std::size_t c = 0; c < width; ++c) {
+            const double remaining = std::max(1.0 - explained[c], 0.0);
+            for (std::size_t m = 0; m < n_obj_; ++m) {
+                sd[(begin + c) * n_obj_ + m] = std::sqrt(variance_[m] * remaining);
+            }
+        }
+    });
+}
+
+SurrogatePrescreener::SurrogatePrescreener(const OptimizationParameters &params, std::vector<double> lower,
+                                           std::vector<double> upper, std::size_t n_obj)
+    : model_(std::move(lower), std::move(upper), n_obj, params.surrogate_points, params.surrogate_length_scale),
+      diversity_(parse_diversity(params.diversity)), exploration_(params.surrogate_exploration),
+      n_threads_(params.evaluation_threads) {
+    if (!(exploration_ >= 0.0) || !std::isfinite(exploration_)) {
+        throw std::invalid_argument("surrogate_exploration must be finite and non-negative");
+    }
+    const std::size_t pool = params.prescreen_factor * params.offspring_population_size;
+    workspace_.reserve(pool, n_obj);
+}
+
+void SurrogatePrescreener::observe(const PopulationMatrix &x, const ObjectiveMatrix &f, std::size_t first) {
+    for (std::size_t i = first; i < x.rows(); ++i) {
+        model_.add(x.row(i), f.row(i));
+    }
+    model_.fit();
+}
+
+void SurrogatePrescreener::select(const PopulationMatrix &candidates, std::size_t n_select,
+                                  PopulationMatrix &selected) {
+    const std::size_t n = candidates.rows();
+    const std::size_t n_obj = model_.n_obj();
+    n_select = std::min(n_select, n);
+
+    chosen_.resize(n_select);
+    if (model_.size() == 0) {
+        for (std::size_t i = 0; i < n_select; ++i) {
+            chosen_[i] = i;
+        }
+    } else {
+        mean_.resize(n * n_obj);
+        sd_.resize(n * n_obj);
+        model_.predict(candidates.data(), n, mean_.data(), sd_.data(), n_threads_);
+        for (std::size_t i = 0; i < mean_.size(); ++i) {
+            mean_[i] -= exploration_ * sd_[i];
+        }
+
+        rank_.resize(n_select);
+        crowding_.resize(n_select);
+        ::survive(mean_.data(), n, n_obj, n_select, diversity_, nullptr, workspace_, chosen_.data(), rank_.data(),
+                  crowding_.data());
+        std::sort(chosen_.begin(), chosen_.end());
+    }
+
+    selected.resize(n_select, candidates.cols());
+    for (std::size_t i = 0; i < n_select; ++i) {
+        selected.copy_row_from(candidates, chosen_[i], i);
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef EDDIE_SURROGATE_H
+#define EDDIE_SURROGATE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "parameter.h"
+#include "population.h"
+#include "survival.h"
+
+// Ordinary Kriging (a Gaussian process with a constant mean) of every objective over the
+// bounds-normalized decision space, with one squared-exponential kernel
+// k(a, b) = exp(-|a - b|² / (2 length_scale²)) shared by all objectives and `nugget` added to
+// its diagonal.
+//
+// The kernel matrix is kept as its Cholesky factor L. `add` extends L by one row, which costs
+// O(n²) instead of the O(n³) of a refactorization; `fit` then re-solves the weights of all
+// objectives against L in O(n² n_obj). Once `capacity` points are held, the oldest half is
+// dropped and L rebuilt from the rest, so the model follows the search.
+class KrigingSurrogate {
+public:
+    // length_scale <= 0 picks sqrt(n_var) / 4, a quarter of the unit cube's diagonal.
+    KrigingSurrogate(std::vector<double> lower, std::vector<double> upper, std::size_t n_obj, std::size_t capacity,
+                     double length_scale = 0.0, double nugget = 1e-6);
+
+    std::size_t n_var() const { return lower_.size(); }
+    std::size_t n_obj() const { return n_obj_; }
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    double length_scale() const { return length_scale_; }
+
+    // Adds an evaluated point; false if it is already interpolated to within the nugget (a
+    // near-duplicate of a held point), in which case the model is unchanged.
+    bool add(Span<const double> x, Span<const double> f);
+
+    // Solves for the constant means, weights and process variances of the current points.
+    // Must be called after `add` and before `predict`.
+    void fit();
+
+    // Mean and standard deviation (rows x n_obj, row-major) of the objectives at the rows of x
+    // (rows x n_var) on n_threads threads (0 = all cores). Without points the prediction is 0 ± inf.
+    void predict(const double *x, std::size_t rows, double *mean, double *sd, std::size_t n_threads = 1) const;
+
+private:
+    void normalize(Span<const double> x, double *out) const;
+    double kernel(const double *a, const double *b) const;
+    bool append(const double *z, const double *f);
+    // b = L⁻¹ b for the size() x width row-major b, one row operation at a time so both L and
+    // b are read by rows and the column loop vectorizes
+    void forward_solve(double *b, std::size_t width) const;
+    void rebuild(std::size_t keep);
+
+    std::vector<double> lower_;
+    std::vector<double> scale_{};  // 1 / range, 0 for fixed variables
+    std::size_t n_obj_;
+    std::size_t capacity_;
+    double length_scale_;
+    double nugget_;
+
+    std::size_t size_ = 0;
+    bool fitted_ = false;
+    std::vector<double> points_{};     // capacity x n_var, normalized
+    std::vector<double> values_{};     // capacity x n_obj
+    std::vector<double> factor_{};     // capacity x capacity, lower triangle of L
+    std::vector<double> weights_{};    // capacity x n_obj, K⁻¹ (y - mean)
+    std::vector<double> mean_{};       // n_obj
+    std::vector<double> variance_{};   // n_obj, process variance
+    std::vector<double> scratch_{};    // capacity x (n_obj + 1)
+};
+
+// Pre-screening stage between variation and evaluation: variation produces `prescreen_factor`
+// times the offspring that are evaluated, the surrogate predicts all of them, and the
+// `offspring_population_size` best by (mu + lambda) survival on the optimistic prediction
+// mean − surrogate_exploration sd go on to the real evaluator. Every evaluated individual is
+// fed back to the surrogate.
+class SurrogatePrescreener {
+public:
+    SurrogatePrescreener(const OptimizationParameters &params, std::vector<double> lower, std::vector<double> upper,
+                         std::size_t n_obj);
+
+    // Trains the surrogate on rows [first, x.rows()) of x and f.
+    void observe(const PopulationMatrix &x, const ObjectiveMatrix &f, std::size_t first = 0);
+
+    // Copies the n_select most promising rows of `candidates` to `selected`, in candidate order.
+    void select(const PopulationMatrix &candidates, std::size_t n_select, PopulationMatrix &selected);
+
+    const KrigingSurrogate &model() const { return model_; }
+
+private:
+    KrigingSurrogate model_;
+    Diversity diversity_;
+    double exploration_;
+    std::size_t n_threads_;
+
+    std::vector<double> mean_{};
+    std::vector<double> sd_{};
+    SurvivalWorkspace workspace_{};
+    std::vector<std::size_t> chosen_{};
+    std::vector<std::size_t> rank_{};
+    std::vector<double> crowding_{};
+};
+
+#endif // EDDIE_SURROGATE_H
@@ -0,0 +1,369 @@
+#ifndef EDDIE_SURVIVAL_H
+#define EDDIE_SURVIVAL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fronts.h"
+#include "ranking.h"
+#include "telemetry.h"
+
+// (mu + lambda) survival of NSGA-II in one pass: non-dominated ranking up to the split front,
+// the diversity metric of every front that survives and the truncation of the split front.
+//
+// The fronts come from the partial sort of ranking.h, and every front is handed to the metric
+// as its member list plus the per-objective ordering of those members (the `I` of pymoo's
+// calc_pcd), computed once per front. The metrics follow pymoo's definitions (up to the order
+// in which the objectives are summed):
+//
+//   crowding_distance          calc_crowding_distance: sum over the objectives of the normalized
+//                              gaps to both neighbours divided by n_obj, boundaries +infinity
+//   pruning_crowding_distance  calc_pcd behind the duplicate filter of RankAndCrowding:
+//                              duplicates get 0, the others are pruned one at a time on the
+//                              split front with the neighbours of every removed point updated
+//
+// The split front keeps its largest values; ties go to the smaller tie key (the candidate index
+// without keys), so a random permutation as keys gives the randomized tie-break of pymoo.
+//
+// Header-only so the compiled pymoo module can share it (pymoo/functions/compiled/survival.pyx).
+
+enum class Diversity { crowding_distance, pruning_crowding_distance };
+
+inline Diversity parse_diversity(const std::string &name) {
+    if (name == "cd") {
+        return Diversity::crowding_distance;
+    }
+    if (name == "pcd" || name == "pruning-cd") {
+        return Diversity::pruning_crowding_distance;
+    }
+    throw std::invalid_argument("Unknown diversity metric: " + name);
+}
+
+// Buffers of `survive`; they keep their capacity between calls.
+struct SurvivalWorkspace {
+    FrontSet fronts{};
+    FastSortWorkspace sort{};
+    std::vector<std::size_t> members{};   // points of the current front (after removing duplicates)
+    std::vector<std::size_t> sorted{};    // per objective, positions in `members` by ascending value
+    std::vector<std::size_t> previous{};  // per objective, linked list over `sorted` for pruning
+    std::vector<std::size_t> next{};
+    std::vector<double> normalized{};
+    std::vector<double> values{};         // metric of every member of the front
+    std::vector<unsigned char> is_extreme{};
+    std::vector<unsigned char> is_duplicate{};
+    std::vector<unsigned char> removed{};
+    std::vector<std::pair<double, std::size_t>> heap{};  // (-value, position), largest first
+    std::vector<std::size_t> order{};
+
+    void reserve(std::size_t n_points, std::size_t n_obj) {
+        fronts.reserve(n_points);
+        for (auto *buffer : {&sort.order, &sort.previous_in_front, &sort.front_tail, &sort.front_size, &members,
+                             &order}) {
+            buffer->reserve(n_points);
+        }
+        for (auto *buffer : {&sorted, &previous, &next}) {
+            buffer->reserve(n_points * n_obj);
+        }
+        normalized.reserve(n_points * n_obj);
+        values.reserve(n_points);
+        is_extreme.reserve(n_points);
+        is_duplicate.reserve(n_points);
+        removed.reserve(n_points);
+        heap.reserve(n_points * (2 * n_obj + 1));  // every removal pushes at most 2 n_obj updates
+    }
+};
+
+namespace survival_detail {
+
+constexpr double infinity = std::numeric_limits<double>::infinity();
+constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+// workspace.sorted[m * size + r] = position in `members` of the r-th smallest value of objective m
+// (stable, like numpy's mergesort). Ties are broken by position instead of using std::stable_sort,
+// which would allocate a merge buffer on every call.
+inline void sort_by_objective(const double *F, std::size_t n_obj, const std::vector<std::size_t> &members,
+                              std::vector<std::size_t> &sorted) {
+    const std::size_t size = members.size();
+    sorted.resize(n_obj * size);
+    for (std::size_t m = 0; m < n_obj; ++m) {
+        std::size_t *column = sorted.data() + m * size;
+        for (std::size_t r = 0; r < size; ++r) {
+            column[r] = r;
+        }
+        std::sort(column, column + size, [&](std::size_t a, std::size_t b) {
+            const double fa = F[members[a] * n_obj + m];
+            const double fb = F[members[b] * n_obj + m];
+            return fa < fb || (!(fb < fa) && a < b);
+        });
+    }
+}
+
+// calc_crowding_distance over `members`; values[r] belongs to members[r].
+inline void crowding_distance(const double *F, std::size_t n_obj, SurvivalWorkspace &workspace) {
+    const auto &members = workspace.members;
+    const std::size_t size = members.size();
+    auto &values = workspace.values;
+    values.assign(size, 0.0);
+    if (size <= 2) {
+        std::fill(values.begin(), values.end(), infinity);
+        return;
+    }
+
+    sort_by_objective(F, n_obj, members, workspace.sorted);
+    for (std::size_t m = 0; m < n_obj; ++m) {
+        const std::size_t *column = workspace.sorted.data() + m * size;
+        const auto f = [&](std::size_t r) { return F[members[column[r]] * n_obj + m]; };
+
+        // a constant objective contributes nothing, not even at the boundaries
+        const double norm = f(size - 1) - f(0);
+        if (norm == 0.0) {
+            continue;
+        }
+        values[column[0]] = infinity;
+        values[column[size - 1]] = infinity;
+        for (std::size_t r = 1; r + 1 < size; ++r) {
+            values[column[r]] += (f(r) - f(r - 1)) / norm + (f(r + 1) - f(r)) / norm;
+        }
+    }
+    for (double &value : values) {
+        value /= static_cast<double>(n_obj);
+    }
+}
+
+// calc_pcd of the points in `members` (free of duplicates) with n_remove removals.
+inline void pruning_crowding_distance(const double *F, std::size_t n_obj, std::size_t n_remove,
+                                      SurvivalWorkspace &workspace) {
+    const auto &members = workspace.members;
+    const std::size_t size = members.size();
+    const double n_obj_d = static_cast<double>(n_obj);
+    auto &values = workspace.values;
+    values.assign(size, infinity);
+    if (size == 0) {
+        return;
+    }
+    n_remove = size > n_obj ? std::min(n_remove, size - n_obj) : 0;
+
+    sort_by_objective(F, n_obj, members, workspace.sorted);
+    const std::size_t *sorted = workspace.sorted.data();
+
+    // the extremes (first smallest and first largest of every objective) stay at +infinity; the
+    // objectives are normalized by their range
+    auto &is_extreme = workspace.is_extreme;
+    is_extreme.assign(size, 0U);
+    auto &normalized = workspace.normalized;
+    normalized.resize(size * n_obj);
+    for (std::size_t m = 0; m < n_obj; ++m) {
+        std::size_t lo = 0;
+        std::size_t hi = 0;
+        for (std::size_t r = 1; r < size; ++r) {
+            const double f = F[members[r] * n_obj + m];
+            lo = f < F[members[lo] * n_obj + m] ? r : lo;
+            hi = f > F[members[hi] * n_obj + m] ? r : hi;
+        }
+        is_extreme[lo] = is_extreme[hi] = 1U;
+
+        const double f_min = F[members[lo] * n_obj + m];
+        double range = F[members[hi] * n_obj + m] - f_min;
+        range = range == 0.0 ? 1.0 : range;
+        for (std::size_t r = 0; r < size; ++r) {
+            normalized[r * n_obj + m] = (F[members[r] * n_obj + m] - f_min) / range;
+        }
+    }
+
+    // neighbours along every objective as doubly linked lists, so that removals are O(n_obj)
+    auto &previous = workspace.previous;
+    auto &next = workspace.next;
+    previous.resize(size * n_obj);
+    next.resize(size * n_obj);
+    for (std::size_t m = 0; m < n_obj; ++m) {
+        const std::size_t *column = sorted + m * size;
+        for (std::size_t r = 0; r < size; ++r) {
+            previous[column[r] * n_obj + m] = r > 0 ? column[r - 1] : none;
+            next[column[r] * n_obj + m] = r + 1 < size ? column[r + 1] : none;
+        }
+    }
+
+    // a point without a neighbour on one side (only possible on ties with an extreme) is unbounded
+    const auto update = [&](std::size_t i) {
+        double value = 0.0;
+        for (std::size_t m = 0; m < n_obj; ++m) {
+            const std::size_t l = previous[i * n_obj + m];
+            const std::size_t u = next[i * n_obj + m];
+            value += l != none && u != none ? (normalized[u * n_obj + m] - normalized[l * n_obj + m]) / n_obj_d
+                                            : infinity;
+        }
+        values[i] = value;
+    };
+    for (std::size_t i = 0; i < size; ++i) {
+        if (!is_extreme[i]) {
+            update(i);
+        }
+    }
+
+    // smallest value first, ties to the largest position; entries outdated by an update are skipped
+    auto &heap = workspace.heap;
+    heap.clear();
+    for (std::size_t i = 0; i < size; ++i) {
+        heap.emplace_back(-values[i], i);
+    }
+    std::make_heap(heap.begin(), heap.end());
+    auto &removed = workspace.removed;
+    removed.assign(size, 0U);
+
+    // the last removal is left to the truncation, which keeps the largest values
+    for (std::size_t n_removed = 0; n_removed + 1 < n_remove && !heap.empty();) {
+        std::pop_heap(heap.begin(), heap.end());
+        const auto [key, k] = heap.back();
+        heap.pop_back();
+        if (removed[k] || (-key != values[k] && values[k] == values[k])) {
+            continue;
+        }
+        removed[k] = 1U;
+        ++n_removed;
+
+        for (std::size_t m = 0; m < n_obj; ++m) {
+            const std::size_t l = previous[k * n_obj + m];
+            const std::size_t u = next[k * n_obj + m];
+            if (l != none) {
+                next[l * n_obj + m] = u;
+            }
+            if (u != none) {
+                previous[u * n_obj + m] = l;
+            }
+        }
+        for (std::size_t m = 0; m < n_obj; ++m) {
+            for (const std::size_t i : {previous[k * n_obj + m], next[k * n_obj + m]}) {
+                if (i != none && !is_extreme[i] && !removed[i]) {
+                    update(i);
+                    heap.emplace_back(-values[i], i);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+        }
+    }
+}
+
+// Positions (ascending) in `front` of the points equal to an earlier point of the front.
+inline void mark_duplicates(const double *F, std::size_t n_obj, Span<const std::size_t> front,
+                            std::vector<unsigned char> &is_duplicate, std::vector<std::size_t> &order) {
+    const std::size_t size = front.size();
+    order.resize(size);
+    for (std::size_t r = 0; r < size; ++r) {
+        order[r] = r;
+    }
+    const auto row = [&](std::size_t r) { return F + front[r] * n_obj; };
+    // ties by position, the order of a stable sort without its merge buffer
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        if (std::lexicographical_compare(row(a), row(a) + n_obj, row(b), row(b) + n_obj)) {
+            return true;
+        }
+        return !std::lexicographical_compare(row(b), row(b) + n_obj, row(a), row(a) + n_obj) && a < b;
+    });
+    is_duplicate.assign(size, 0U);
+    for (std::size_t r = 1; r < size; ++r) {
+        if (std::equal(row(order[r]), row(order[r]) + n_obj, row(order[r - 1]))) {
+            is_duplicate[order[r]] = 1U;  // the first occurrence comes first
+        }
+    }
+}
+
+} // namespace survival_detail
+
+// Selects `n_survive` of the n rows of the row-major n x n_obj matrix F. survivors[i] is the row
+// of the i-th survivor, rank[i] its front and crowding[i] its diversity value: whole fronts in
+// the order of the sort, then the kept members of the split front by decreasing value.
+// `tie_keys` (n values or nullptr) break ties in the truncation.
+//
+// Without `truncate` the split front is written whole, in the order of the sort and with the
+// values computed for its truncation, so that the caller can truncate it (pymoo does, to draw
+// its random tie-break for the split front only). The outputs then need room for n rows.
+// Returns the number of rows written.
+inline std::size_t survive(const double *F, std::size_t n, std::size_t n_obj, std::size_t n_survive,
+                           Diversity diversity, const std::size_t *tie_keys, SurvivalWorkspace &workspace,
+                           std::size_t *survivors, std::size_t *rank, double *crowding, std::size_t n_threads = 1,
+                           bool truncate = true) {
+    namespace detail = survival_detail;
+    n_survive = std::min(n_survive, n);
+    if (n_survive == 0) {
+        return 0;
+    }
+
+    auto &fronts = workspace.fronts;
+    {
+        EDDIE_TELEMETRY_SCOPE(ranking);
+        fast_non_dominated_sort(F, n, n_obj, fronts, workspace.sort, 0.0, n_survive, static_cast<std::size_t>(-1),
+                                n_threads);
+    }
+
+    // diversity and truncation of every surviving front
+    EDDIE_TELEMETRY_SCOPE(crowding);
+
+    auto &is_duplicate = workspace.is_duplicate;
+    std::size_t n_taken = 0;
+    for (std::size_t k = 0; k < fronts.size() && n_taken < n_survive; ++k) {
+        const auto front = fronts.front(k);
+        const std::size_t n_remove = n_taken + front.size() > n_survive ? n_taken + front.size() - n_survive : 0;
+
+        // values[r] is the metric of front[r]
+        auto &values = workspace.values;
+        if (diversity == Diversity::crowding_distance) {
+            workspace.members.assign(front.begin(), front.end());
+            detail::crowding_distance(F, n_obj, workspace);
+        } else if (front.size() <= 2) {
+            values.assign(front.size(), detail::infinity);
+        } else {
+            detail::mark_duplicates(F, n_obj, front, is_duplicate, workspace.order);
+            workspace.members.clear();
+            for (std::size_t r = 0; r < front.size(); ++r) {
+                if (!is_duplicate[r]) {
+                    workspace.members.push_back(front[r]);
+                }
+            }
+            detail::pruning_crowding_distance(F, n_obj, n_remove, workspace);
+
+            // spread the values of the unique points back over the front, duplicates get 0
+            std::size_t u = workspace.members.size();
+            values.resize(front.size());
+            for (std::size_t r = front.size(); r-- > 0;) {
+                values[r] = is_duplicate[r] ? 0.0 : values[--u];
+            }
+        }
+
+        if (n_remove == 0 || !truncate) {
+            for (std::size_t r = 0; r < front.size(); ++r, ++n_taken) {
+                survivors[n_taken] = front[r];
+                rank[n_taken] = k;
+                crowding[n_taken] = values[r];
+            }
+            continue;
+        }
+
+        // split front: the largest values (NaN last), ties by key
+        auto &order = workspace.order;
+        order.resize(front.size());
+        for (std::size_t r = 0; r < front.size(); ++r) {
+            order[r] = r;
+        }
+        const auto key = [&](std::size_t r) { return tie_keys != nullptr ? tie_keys[front[r]] : front[r]; };
+        const std::size_t n_keep = front.size() - n_remove;
+        std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(n_keep), order.end(),
+                          [&](std::size_t a, std::size_t b) {
+                              const double va = values[a] == values[a] ? values[a] : -detail::infinity;
+                              const double vb = values[b] == values[b] ? values[b] : -detail::infinity;
+                              return va > vb || (va == vb && key(a) < key(b));
+                          });
+        for (std::size_t i = 0; i < n_keep; ++i, ++n_taken) {
+            survivors[n_taken] = front[order[i]];
+            rank[n_taken] = k;
+            crowding[n_taken] = values[order[i]];
+        }
+    }
+    return n_taken;
+}
+
+#endif // EDDIE_SURVIVAL_H
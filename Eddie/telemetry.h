@@ -0,0 +1,175 @@
+#ifndef EDDIE_TELEMETRY_H
+#define EDDIE_TELEMETRY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Built-in counters and scoped phase timers, compiled in by `make TELEMETRY=1`
+// (EDDIE_WITH_TELEMETRY). Without it the macros below expand to nothing and no code or state is
+// left behind, so the hot paths can be instrumented unconditionally.
+//
+//   EDDIE_TELEMETRY_SCOPE(phase)          adds the time until the end of the scope to phase_ns
+//   EDDIE_TELEMETRY_ADD(counter, value)   adds value to a counter of the calling thread
+//   EDDIE_TELEMETRY_QUEUE_DEPTH(depth)    records an evaluation queue depth (the maximum is kept)
+//
+// Every thread counts into its own slots, read by `telemetry_snapshot` without stopping it, so
+// an increment costs one thread-local add. Counts of threads that have exited are kept.
+//
+// Header-only and free of other Eddie dependencies so the kernels shared with the compiled pymoo
+// modules (ranking.h, survival.h, dominance.h) can be instrumented.
+
+enum class TelemetryCounter : std::size_t {
+    initialization_ns,
+    variation_ns,
+    prescreening_ns,
+    evaluation_ns,
+    ranking_ns,
+    crowding_ns,
+    migration_ns,
+    io_ns,
+    dominance_comparisons,
+    evaluations,
+    count
+};
+
+constexpr std::size_t telemetry_counter_count = static_cast<std::size_t>(TelemetryCounter::count);
+
+// Column names of the counters, in enum order.
+constexpr const char *telemetry_counter_names[telemetry_counter_count] = {
+    "initialization_ns", "variation_ns", "prescreening_ns", "evaluation_ns", "ranking_ns",
+    "crowding_ns",       "migration_ns", "io_ns",           "dominance_comparisons", "evaluations"};
+
+// Totals since the start of the process, except `queue_depth`: the deepest evaluation queue seen
+// since the previous snapshot.
+struct TelemetrySnapshot {
+    std::array<std::uint64_t, telemetry_counter_count> counters{};
+    std::uint64_t allocations = 0;
+    std::uint64_t queue_depth = 0;
+
+    std::uint64_t operator[](TelemetryCounter counter) const { return counters[static_cast<std::size_t>(counter)]; }
+};
+
+#ifdef EDDIE_WITH_TELEMETRY
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace telemetry_detail {
+
+struct ThreadCounters;
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadCounters *> live{};
+    std::array<std::uint64_t, telemetry_counter_count> retired{};
+};
+
+inline Registry &registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Written by the owning thread only (a relaxed load and store, no locked instruction), read by
+// snapshots from any thread.
+struct ThreadCounters {
+    std::array<std::atomic<std::uint64_t>, telemetry_counter_count> values{};
+
+    ThreadCounters() {
+        auto &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.live.push_back(this);
+    }
+
+    ~ThreadCounters() {
+        auto &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (std::size_t i = 0; i < telemetry_counter_count; ++i) {
+            r.retired[i] += values[i].load(std::memory_order_relaxed);
+        }
+        r.live.erase(std::find(r.live.begin(), r.live.end(), this));
+    }
+
+    void add(TelemetryCounter counter, std::uint64_t value) {
+        auto &slot = values[static_cast<std::size_t>(counter)];
+        slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+};
+
+inline ThreadCounters &local() {
+    thread_local ThreadCounters counters;
+    return counters;
+}
+
+// Process-wide, also bumped from operator new (telemetry_report.cpp), which must not touch the
+// thread-local registry.
+inline std::atomic<std::uint64_t> allocations{0};
+inline std::atomic<std::uint64_t> queue_depth{0};
+
+} // namespace telemetry_detail
+
+inline void telemetry_add(TelemetryCounter counter, std::uint64_t value) {
+    telemetry_detail::local().add(counter, value);
+}
+
+inline void telemetry_queue_depth(std::uint64_t depth) {
+    auto &deepest = telemetry_detail::queue_depth;
+    std::uint64_t seen = deepest.load(std::memory_order_relaxed);
+    while (seen < depth && !deepest.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+    }
+}
+
+inline TelemetrySnapshot telemetry_snapshot() {
+    auto &r = telemetry_detail::registry();
+    TelemetrySnapshot snapshot;
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        snapshot.counters = r.retired;
+        for (const auto *thread : r.live) {
+            for (std::size_t i = 0; i < telemetry_counter_count; ++i) {
+                snapshot.counters[i] += thread->values[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    snapshot.allocations = telemetry_detail::allocations.load(std::memory_order_relaxed);
+    snapshot.queue_depth = telemetry_detail::queue_depth.exchange(0, std::memory_order_relaxed);
+    return snapshot;
+}
+
+class ScopedTelemetryTimer {
+public:
+    explicit ScopedTelemetryTimer(TelemetryCounter counter)
+        : counter_(counter), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTelemetryTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        telemetry_add(counter_, static_cast<std::uint64_t>(
+                                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    ScopedTelemetryTimer(const ScopedTelemetryTimer &) = delete;
+    ScopedTelemetryTimer &operator=(const ScopedTelemetryTimer &) = delete;
+
+private:
+    TelemetryCounter counter_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#define EDDIE_TELEMETRY_CONCAT_(a, b) a##b
+#define EDDIE_TELEMETRY_CONCAT(a, b) EDDIE_TELEMETRY_CONCAT_(a, b)
+#define EDDIE_TELEMETRY_SCOPE(phase) \
+    const ScopedTelemetryTimer EDDIE_TELEMETRY_CONCAT(eddie_telemetry_scope_, __LINE__)(TelemetryCounter::phase##_ns)
+#define EDDIE_TELEMETRY_ADD(counter, value) telemetry_add(TelemetryCounter::counter, (value))
+#define EDDIE_TELEMETRY_QUEUE_DEPTH(depth) telemetry_queue_depth(depth)
+
+#else
+
+#define EDDIE_TELEMETRY_SCOPE(phase) static_cast<void>(0)
+#define EDDIE_TELEMETRY_ADD(counter, value) static_cast<void>(0)
+#define EDDIE_TELEMETRY_QUEUE_DEPTH(depth) static_cast<void>(0)
+
+#endif // EDDIE_WITH_TELEMETRY
+
+#endif // EDDIE_TELEMETRY_H
@@ -0,0 +1,225 @@
+#include "telemetry_report.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+bool ends_with(const std::string &text, const std::string &suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+TelemetryReport::Format format_of(const std::string &path) {
+    if (ends_with(path, ".csv")) {
+        return TelemetryReport::Format::csv;
+    }
+    if (ends_with(path, ".json") || ends_with(path, ".jsonl")) {
+        return TelemetryReport::Format::json;
+    }
+    if (ends_with(path, ".prom")) {
+        return TelemetryReport::Format::prometheus;
+    }
+    throw std::invalid_argument("telemetry_path must end in .csv, .json, .jsonl or .prom: " + path);
+}
+
+bool is_time(std::size_t counter) { return counter <= static_cast<std::size_t>(TelemetryCounter::io_ns); }
+
+// "evaluation_ns" -> "evaluation"
+std::string phase_name(std::size_t counter) {
+    const std::string name = telemetry_counter_names[counter];
+    return name.substr(0, name.size() - 3);
+}
+
+std::string column_name(std::size_t counter) {
+    return is_time(counter) ? phase_name(counter) + "_ms" : telemetry_counter_names[counter];
+}
+
+double milliseconds(std::uint64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+TelemetrySnapshot difference(const TelemetrySnapshot &now, const TelemetrySnapshot &before) {
+    TelemetrySnapshot delta;
+    for (std::size_t i = 0; i < telemetry_counter_count; ++i) {
+        delta.counters[i] = now.counters[i] - before.counters[i];
+    }
+    delta.allocations = now.allocations - before.allocations;
+    delta.queue_depth = now.queue_depth;
+    return delta;
+}
+
+TelemetrySnapshot take_snapshot() {
+#ifdef EDDIE_WITH_TELEMETRY
+    return telemetry_snapshot();
+#else
+    return {};
+#endif
+}
+
+} // namespace
+
+TelemetryReport::TelemetryReport(std::string path) : path_(std::move(path)), format_(format_of(path_)) {
+    if (!compiled_in()) {
+        throw std::invalid_argument("telemetry_path requires a build with make TELEMETRY=1");
+    }
+    if (format_ != Format::prometheus) {
+        out_.open(path_, std::ios::out | std::ios::trunc);
+        if (!out_) {
+            throw std::runtime_error("Unable to open telemetry report " + path_);
+        }
+    }
+    if (format_ == Format::csv) {
+        out_ << "generation,wall_ms";
+        for (std::size_t i = 0; i < telemetry_counter_count; ++i) {
+            out_ << ',' << column_name(i);
+        }
+        out_ << ",allocations,queue_depth\n";
+    }
+    previous_ = take_snapshot();
+    last_ = std::chrono::steady_clock::now();
+}
+
+void TelemetryReport::record(std::size_t generation) {
+    const auto now = std::chrono::steady_clock::now();
+    const double wall_ms = std::chrono::duration<double, std::milli>(now - last_).count();
+    const TelemetrySnapshot total = take_snapshot();
+    const TelemetrySnapshot delta = difference(total, previous_);
+
+    switch (format_) {
+    case Format::csv:
+        write_csv(generation, wall_ms, delta);
+        break;
+    case Format::json:
+        write_json(generation, wall_ms, delta);
+        break;
+    case Format::prometheus:
+        write_prometheus(generation, wall_ms, delta, total);
+        break;
+    }
+    previous_ = total;
+    last_ = now;
+}
+
+void TelemetryReport::write_csv(std::size_t generation, double wall_ms, const TelemetrySnapshot &delta) {
+    out_ << generation << ',' << wall_ms;
+    for (std::size_t i = 0; i < telemetry_counter_count; ++i) {
+        out_ << ',';
+        if (is_time(i)) {
+            out_ << milliseconds(delta.counters[i]);
+        } else {
+            out_ << delta.counters[i];
+        }
+    }
+    // flushed per row so a stalled run still shows its last generations
+    out_ << ',' << delta.allocations << ',' << delta.queue_depth << std::endl;
+}
+
+void TelemetryReport::write_json(std::size_t generation, double wall_ms, const TelemetrySnapshot &delta) {
+    out_ << "{\"generation\":" << generation << ",\"wall_ms\":" << wall_ms;
+    for (std::size_t i = 0; i < telemetry_counter_count; ++i) {
+        out_ << ",\"" << column_name(i) << "\":";
+        if (is_time(i)) {
+            out_ << milliseconds(delta.counters[i]);
+        } else {
+            out_ << delta.counters[i];
+        }
+    }
+    out_ << ",\"allocations\":" << delta.allocations << ",\"queue_depth\":" << delta.queue_depth << '}'
+         << std::endl;
+}
+
+void TelemetryReport::write_prometheus(std::size_t generation, double wall_ms, const TelemetrySnapshot &delta,
+                                       const TelemetrySnapshot &total) {
+    const std::string tmp = path_ + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::out | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Unable to write telemetry report " + tmp);
+        }
+        out << "# HELP eddie_generation Last completed generation.\n"
+            << "# TYPE eddie_generation gauge\n"
+            << "eddie_generation " << generation << '\n'
+            << "# HELP eddie_generation_seconds Wall time of the last generation.\n"
+            << "# TYPE eddie_generation_seconds gauge\n"
+            << "eddie_generation_seconds " << wall_ms / 1e3 << '\n'
+            << "# HELP eddie_evaluation_queue_depth Deepest evaluation queue during the last generation.\n"
+            << "# TYPE eddie_evaluation_queue_depth gauge\n"
+            << "eddie_evaluation_queue_depth " << delta.queue_depth << '\n'
+            << "# HELP eddie_phase_seconds_total Time spent per phase, summed over threads.\n"
+            << "# TYPE eddie_phase_seconds_total counter\n";
+        for (std::size_t i = 0; i < telemetry_counter_count && is_time(i); ++i) {
+            out << "eddie_phase_seconds_total{phase=\"" << phase_name(i) << "\"} "
+                << static_cast<double>(total.counters[i]) / 1e9 << '\n';
+        }
+        for (std::size_t i = 0; i < telemetry_counter_count; ++i) {
+            if (!is_time(i)) {
+                out << "# TYPE eddie_" << telemetry_counter_names[i] << "_total counter\n"
+                    << "eddie_" << telemetry_counter_names[i] << "_total " << total.counters[i] << '\n';
+            }
+        }
+        out << "# TYPE eddie_allocations_total counter\n"
+            << "eddie_allocations_total " << total.allocations << '\n';
+        if (!out.flush()) {
+            throw std::runtime_error("Unable to write telemetry report " + tmp);
+        }
+    }
+    if (std::rename(tmp.c_str(), path_.c_str()) != 0) {
+        throw std::runtime_error("Unable to replace telemetry report " + path_);
+    }
+}
+
+std::string telemetry_path_for_process(const std::string &path, std::size_t process) {
+    const std::size_t slash = path.find_last_of('/');
+    const std::size_t dot = path.find_last_of('.');
+    const std::string suffix = "." + std::to_string(process);
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return path + suffix;
+    }
+    return path.substr(0, dot) + suffix + path.substr(dot);
+}
+
+#ifdef EDDIE_WITH_TELEMETRY
+
+// Counting replacements of the global allocation functions; the array and nothrow forms of the
+// standard library forward to these.
+void *operator new(std::size_t size) {
+    telemetry_detail::allocations.fetch_add(1, std::memory_order_relaxed);
+    size = size == 0 ? 1 : size;
+    while (true) {
+        if (void *memory = std::malloc(size)) {
+            return memory;
+        }
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    telemetry_detail::allocations.fetch_add(1, std::memory_order_relaxed);
+    const auto align = static_cast<std::size_t>(alignment);
+    // aligned_alloc wants a multiple of the alignment
+    size = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+    while (true) {
+        if (void *memory = std::aligned_alloc(align, size)) {
+            return memory;
+        }
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void *memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+#endif // EDDIE_WITH_TELEMETRY
@@ -0,0 +1,63 @@
+#ifndef EDDIE_TELEMETRY_REPORT_H
+#define EDDIE_TELEMETRY_REPORT_H
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+#include "telemetry.h"
+
+// Writes the telemetry of telemetry.h once per generation to `path`, in the format given by its
+// extension:
+//
+//   .csv          one row per generation
+//   .json/.jsonl  one JSON object per line
+//   .prom         Prometheus text exposition of the totals and of the last generation, replaced
+//                 atomically (write to <path>.tmp, rename) for node_exporter's textfile collector
+//
+// A row holds the generation, its wall time and the changes of every counter since the previous
+// row: phase times in milliseconds (summed over the threads that ran the phase), dominance
+// comparisons, evaluations, allocations (operator new calls of the whole process) and the
+// deepest evaluation queue seen. Requires a build with `make TELEMETRY=1`.
+class TelemetryReport {
+public:
+    enum class Format { csv, json, prometheus };
+
+    // Throws std::invalid_argument for an unknown extension or a build without telemetry,
+    // std::runtime_error if the file cannot be opened.
+    explicit TelemetryReport(std::string path);
+
+    TelemetryReport(const TelemetryReport &) = delete;
+    TelemetryReport &operator=(const TelemetryReport &) = delete;
+
+    static constexpr bool compiled_in() {
+#ifdef EDDIE_WITH_TELEMETRY
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    Format format() const { return format_; }
+
+    // Appends (or for Prometheus, publishes) the row of `generation`.
+    void record(std::size_t generation);
+
+private:
+    void write_csv(std::size_t generation, double wall_ms, const TelemetrySnapshot &delta);
+    void write_json(std::size_t generation, double wall_ms, const TelemetrySnapshot &delta);
+    void write_prometheus(std::size_t generation, double wall_ms, const TelemetrySnapshot &delta,
+                          const TelemetrySnapshot &total);
+
+    std::string path_;
+    Format format_;
+    std::ofstream out_{};
+    TelemetrySnapshot previous_{};
+    std::chrono::steady_clock::time_point last_{};
+};
+
+// "run.csv" -> "run.3.csv": one report per MPI rank.
+std::string telemetry_path_for_process(const std::string &path, std::size_t process);
+
+#endif // EDDIE_TELEMETRY_REPORT_H
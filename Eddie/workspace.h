@@ -0,0 +1,34 @@
+#ifndef EDDIE_WORKSPACE_H
+#define EDDIE_WORKSPACE_H
+
+#include "arena.h"
+#include "decomposition.h"
+#include "fronts.h"
+#include "ranking.h"
+#include "survival.h"
+
+// Scratch memory that a caller keeps across kernel calls, so that the sorting, crowding and
+// decomposition kernels reuse it instead of allocating on every call:
+//
+//   arena          flat temporaries (distance matrices of the crowding metrics), released by reset()
+//   fronts, sort   output and buffers of the non-dominated sorts, including the dominance bit matrix
+//   degree         buffers of the dominance-degree sort
+//   decomposition  the kernel of the last weight set, whose tiles are reassigned in place
+//   survival       buffers of the fused rank and crowding survival
+//
+// The vectors only ever grow, so after the first generations no call allocates. `reset()` ends a
+// generation: arena memory handed out during it must not be used afterwards.
+//
+// Header-only so the compiled pymoo modules can share it (pymoo/functions/compiled/workspace.pyx).
+struct KernelWorkspace {
+    Arena arena{};
+    FrontSet fronts{};
+    FastSortWorkspace sort{};
+    DominanceDegreeWorkspace degree{};
+    DecompositionKernel decomposition{};
+    SurvivalWorkspace survival{};
+
+    void reset() { arena.reset(); }
+};
+
+#endif // EDDIE_WORKSPACE_H
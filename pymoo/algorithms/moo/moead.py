@@ -119,8 +119,10 @@ class MOEAD(LoopwiseAlgorithm, GeneticAlgorithm):
 
         # calculate the decomposed values for each neighbor
         N = self.neighbors[k]
-        FV = self.decomposition.do(pop[N].get("F"), weights=self.ref_dirs[N, :], ideal_point=self.ideal)
-        off_FV = self.decomposition.do(off.F[None, :], weights=self.ref_dirs[N, :], ideal_point=self.ideal)
+        FV = self.decomposition.do(pop[N].get("F"), weights=self.ref_dirs[N, :], ideal_point=self.ideal,
+                                   workspace=self.workspace)
+        off_FV = self.decomposition.do(off.F[None, :], weights=self.ref_dirs[N, :], ideal_point=self.ideal,
+                                       workspace=self.workspace)
 
         # this makes the algorithm to support constraints - not originally proposed though and not tested enough
         # if self.problem.has_constraints():
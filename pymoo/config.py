@@ -16,6 +16,19 @@ class Config:
         "not_compiled": True
     }
 
+    # the optional CUDA backend (pymoo.functions.gpu, needs CuPy), off unless enabled here: functions that have
+    # a "gpu" entry in get_functions() then run on a device from min_points rows on and on the CPU below that.
+    # The device is only looked for once an input reaches min_points, since initializing CUDA in a process
+    # that later forks (multiprocessing, joblib) breaks the children.
+    gpu = {
+        "enabled": False,
+        "min_points": 50_000,
+        # share of the free device memory one call may use; larger inputs stream through in chunks
+        "memory_fraction": 0.5,
+        # fixed rows per chunk instead of sizing chunks from the free memory (0)
+        "chunk_rows": 0,
+    }
+
     # whether a warning should be printed if compiled modules are not available
     show_compile_hint = True
 
@@ -8,7 +8,7 @@ from pymoo.core.evaluator import Evaluator
 from pymoo.core.meta import Meta
 from pymoo.core.population import Population
 from pymoo.core.result import Result
-from pymoo.functions import FunctionLoader
+from pymoo.functions import FunctionLoader, load_function
 from pymoo.termination.default import DefaultMultiObjectiveTermination, DefaultSingleObjectiveTermination
 from pymoo.util.display.display import Display
 from pymoo.util.misc import termination_from_tuple
@@ -97,6 +97,9 @@ class Algorithm:
         # the time when the algorithm has been setup for the first time
         self.start_time = None
 
+        # scratch memory of the compiled kernels, reused by every generation and reset after it
+        self.workspace = None
+
     def setup(self, problem, verbose=False, progress=False, **kwargs):
 
         # the problem to be solved by the algorithm
@@ -113,6 +116,9 @@ class Algorithm:
         # set random state
         self.random_state = np.random.default_rng(self.seed)
 
+        # the kernels called during a generation take their temporaries from here
+        self.workspace = load_function("Workspace")()
+
         # make sure that some type of termination criterion is set
         if self.termination is None:
             self.termination = default_termination(problem)
@@ -316,6 +322,10 @@ class Algorithm:
         # if a callback function is provided it is called after each iteration
         self.callback(self)
 
+        # the temporaries of this generation are not needed anymore
+        if self.workspace is not None:
+            self.workspace.reset()
+
         self.n_iter += 1
 
     # =========================================================================================================
@@ -1,5 +1,6 @@
 import numpy as np
 
+from pymoo.functions import load_function
 from pymoo.util.misc import at_least_2d_array, to_1d_array_if_possible
 
 
@@ -21,6 +22,7 @@ class Decomposition:
            ideal_point=None,
            utopian_point=None,
            nadir_point=None,
+           workspace=None,
            **kwargs):
 
         _F, _weights = to_1d_array_if_possible(F), to_1d_array_if_possible(weights)
@@ -54,7 +56,15 @@ class Decomposition:
         if self.nadir_point is None:
             self.nadir_point = self.utopian_point + np.ones(F.shape[1])
 
-        if _type == "one_to_one":
+        # scalarizations with a native kernel evaluate all pairs in one pass without repeating F and weights
+        kernel = self._kernel(**kwargs)
+        if kernel is not None and _type in ["one_to_one", "one_to_many", "many_to_one", "many_to_many"]:
+            D = load_function("decompose")(np.asarray(F, dtype=float), np.asarray(weights, dtype=float),
+                                           utopian_point=np.asarray(self.utopian_point, dtype=float),
+                                           cross=_type != "one_to_one", workspace=workspace, **kernel)
+            D = D.reshape(n_points, n_weights) if _type == "many_to_many" else D.flatten()
+
+        elif _type == "one_to_one":
             D = self._do(F, weights=weights, **kwargs).flatten()
 
         elif _type == "one_to_many":
@@ -74,3 +84,7 @@ class Decomposition:
             raise Exception("Unknown type for decomposition: %s" % _type)
 
         return D
+
+    def _kernel(self, **kwargs):
+        """Arguments of the `decompose` function equivalent to `_do`, or None to always call `_do`."""
+        return None
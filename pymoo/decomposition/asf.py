@@ -8,3 +8,9 @@ class ASF(Decomposition):
         _weights[weights == 0] = weight_0
         asf = ((F - self.utopian_point) / _weights).max(axis=1)
         return asf
+
+    def _kernel(self, weight_0=1e-10, **kwargs):
+        # subclasses redefining the scalarization (e.g. AASF) fall back to _do
+        if type(self)._do is not ASF._do:
+            return None
+        return dict(kind="asf", weight_0=weight_0)
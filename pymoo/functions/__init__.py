@@ -14,22 +14,27 @@ def get_functions():
         dominance_degree_non_dominated_sort,
         find_non_dominated,
         fast_best_order_sort,
+        ParetoArchive,
     )
-    from pymoo.functions.standard.decomposition import calc_distance_to_weights
+    from pymoo.functions.standard.decomposition import calc_distance_to_weights, decompose
     from pymoo.functions.standard.calc_perpendicular_distance import calc_perpendicular_distance
-    from pymoo.functions.standard.hv import hv
+    from pymoo.functions.standard.hv import hv, hvc, hv_approx, HypervolumeArchive
     from pymoo.functions.standard.stochastic_ranking import stochastic_ranking
     from pymoo.functions.standard.mnn import calc_mnn, calc_2nn
     from pymoo.functions.standard.pruning_cd import calc_pcd
+    from pymoo.functions.standard.survival import survive
+    from pymoo.functions.standard.workspace import Workspace
 
     FUNCTIONS = {
         "fast_non_dominated_sort": {
             "python": fast_non_dominated_sort,
             "cython": "pymoo.functions.compiled.non_dominated_sorting",
+            "gpu": "pymoo.functions.gpu.non_dominated_sorting",
         },
         "find_non_dominated": {
             "python": find_non_dominated,
             "cython": "pymoo.functions.compiled.non_dominated_sorting",
+            "gpu": "pymoo.functions.gpu.non_dominated_sorting",
         },
         "efficient_non_dominated_sort": {
             "python": efficient_non_dominated_sort,
@@ -47,21 +52,44 @@ def get_functions():
             "python": dominance_degree_non_dominated_sort,
             "cython": "pymoo.functions.compiled.non_dominated_sorting",
         },
+        "ParetoArchive": {
+            "python": ParetoArchive,
+            "cython": "pymoo.functions.compiled.non_dominated_sorting",
+        },
         "calc_distance_to_weights": {
             "python": calc_distance_to_weights,
             "cython": "pymoo.functions.compiled.decomposition",
         },
+        "decompose": {
+            "python": decompose,
+            "cython": "pymoo.functions.compiled.decomposition",
+        },
         "calc_perpendicular_distance": {
             "python": calc_perpendicular_distance,
             "cython": "pymoo.functions.compiled.calc_perpendicular_distance",
+            "gpu": "pymoo.functions.gpu.calc_perpendicular_distance",
         },
+        "hv": {"python": hv, "cython": "pymoo.functions.compiled.hv"},
+        "hvc": {"python": hvc, "cython": "pymoo.functions.compiled.hv"},
+        "hv_approx": {"python": hv_approx, "cython": "pymoo.functions.compiled.hv"},
+        "HypervolumeArchive": {"python": HypervolumeArchive, "cython": "pymoo.functions.compiled.hv"},
         "stochastic_ranking": {
             "python": stochastic_ranking,
             "cython": "pymoo.functions.compiled.stochastic_ranking",
         },
-        "calc_mnn": {"python": calc_mnn, "cython": "pymoo.functions.compiled.mnn"},
-        "calc_2nn": {"python": calc_2nn, "cython": "pymoo.functions.compiled.mnn"},
+        "calc_mnn": {
+            "python": calc_mnn,
+            "cython": "pymoo.functions.compiled.mnn",
+            "gpu": "pymoo.functions.gpu.mnn",
+        },
+        "calc_2nn": {
+            "python": calc_2nn,
+            "cython": "pymoo.functions.compiled.mnn",
+            "gpu": "pymoo.functions.gpu.mnn",
+        },
         "calc_pcd": {"python": calc_pcd, "cython": "pymoo.functions.compiled.pruning_cd"},
+        "survive": {"python": survive, "cython": "pymoo.functions.compiled.survival"},
+        "Workspace": {"python": Workspace, "cython": "pymoo.functions.compiled.workspace"},
     }
 
     return FUNCTIONS
@@ -100,13 +128,19 @@ class FunctionLoader:
 
         FUNCTIONS = get_functions()
 
-        if mode == "auto":
-            mode = "cython" if self.is_compiled else "python"
-
         if func_name not in FUNCTIONS:
             raise Exception("Function %s not found: %s" % (func_name, FUNCTIONS.keys()))
 
         func = FUNCTIONS[func_name]
+
+        # the gpu implementations decide per call and run on the CPU for small inputs; whether a device exists
+        # is only asked by the first call large enough to use it
+        if mode == "auto":
+            if "gpu" in func and Config.gpu["enabled"] and is_gpu_installed():
+                mode = "gpu"
+            else:
+                mode = "cython" if self.is_compiled else "python"
+
         if mode not in func:
             raise Exception("Module not available in %s." % mode)
         func = func[mode]
@@ -123,6 +157,18 @@ def load_function(func_name=None, _type="auto"):
     return FunctionLoader.get_instance().load(func_name, mode=_type)
 
 
+def is_gpu_available():
+    from pymoo.functions.gpu import is_available
+
+    return is_available()
+
+
+def is_gpu_installed():
+    from pymoo.functions.gpu import is_installed
+
+    return is_installed()
+
+
 def is_compiled():
     try:
         from pymoo.functions.compiled.info import info
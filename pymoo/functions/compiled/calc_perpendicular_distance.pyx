@@ -3,65 +3,43 @@
 
 
 import numpy as np
-from libcpp.vector cimport vector
 
 
+cdef extern from "perpendicular_distance.h":
+    void c_native_perpendicular_distance "perpendicular_distance"(
+        const double *P, size_t n_points, const double *L, size_t n_lines, size_t n_dim, double *out,
+        size_t n_threads) nogil
 
-def calc_perpendicular_distance(double[:,:] P, double[:,:] L):
-    return np.array(c_calc_perpendicular_distance(P, L))
 
+def calc_perpendicular_distance(double[:,:] P, double[:,:] L, out=None, int n_threads=0):
+    return c_calc_perpendicular_distance(P, L, out, n_threads)
 
-cdef extern from "math.h":
-    double sqrt(double m)
-    double pow(double base, double exponent)
 
-
-cdef double c_norm(double[:] v):
+cdef c_calc_perpendicular_distance(double[:,:] P, double[:,:] L, out, int n_threads):
+    """
+    Perpendicular distance of every point in P to every line through the origin spanned by a row of L,
+    as an (n_points, n_lines) matrix. The projections come from the blocked matrix product P L^T of
+    Eddie/perpendicular_distance.h, computed on n_threads threads (0 = all cores) with the GIL released.
+    If given, `out` must be a C-contiguous float64 array of that shape and is filled in place.
+    """
     cdef:
-        double val
-        int i
-    val = 0
-    for i in range(v.shape[0]):
-        val += pow(v[i], 2)
-    val = sqrt(val)
-    return val
-
-
-cdef double[:,:] c_calc_perpendicular_distance(double[:,:] P, double[:,:] L):
-    cdef :
-        int s_L, s_P, n_dim, i, j, k
-        double[:,:] M
-        vector[double] N
-        double norm, dot, perp_dist, norm_scalar_proj
-
-    s_L = L.shape[0]
-    s_P = P.shape[0]
-    n_dim = L.shape[1]
-
-    M = np.zeros((s_P, s_L), dtype=np.float64)
-
-    for i in range(s_L):
-
-        norm = c_norm(L[i, :])
-
-        N = vector[double](n_dim)
-        for k in range(n_dim):
-            N[k] = L[i, k] / norm
-
-        for j in range(s_P):
+        double[:, ::1] _P, _L, _out
 
-            dot = 0
-            for k in range(n_dim):
-                dot += L[i, k] * P[j, k]
-            norm_scalar_proj = dot / norm
+    if P.shape[1] != L.shape[1]:
+        raise ValueError("Points and lines must have the same number of dimensions")
 
-            perp_dist = 0
-            for k in range(n_dim):
-                perp_dist += pow(norm_scalar_proj * N[k] - P[j, k], 2)
-            perp_dist = sqrt(perp_dist)
+    if out is None:
+        out = np.zeros((P.shape[0], L.shape[0]), dtype=np.float64)
+    elif out.shape != (P.shape[0], L.shape[0]):
+        raise ValueError("Output must have shape (%d, %d)" % (P.shape[0], L.shape[0]))
 
-            M[j, i] = perp_dist
+    if P.shape[0] == 0 or L.shape[0] == 0:
+        return out
 
-    return M
+    _P, _L, _out = np.ascontiguousarray(P), np.ascontiguousarray(L), out
 
+    with nogil:
+        c_native_perpendicular_distance(&_P[0, 0], _P.shape[0], &_L[0, 0], _L.shape[0], _L.shape[1], &_out[0, 0],
+                                        max(n_threads, 0))
 
+    return out
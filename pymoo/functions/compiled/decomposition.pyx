@@ -3,21 +3,30 @@
 
 
 import numpy as np
+from libcpp cimport bool
+from libcpp.string cimport string
 from libcpp.vector cimport vector
 
+# the blocked kernel shared with calc_perpendicular_distance.pyx
+from pymoo.functions.compiled.calc_perpendicular_distance import calc_perpendicular_distance
+
+from pymoo.functions.compiled.utils cimport c_row_norms
+from pymoo.functions.compiled.workspace cimport DecompositionKernel, Workspace
+
 
 # -----------------------------------------------------------
 # INTERFACE
 # -----------------------------------------------------------
 
-def calc_perpendicular_distance(double[:,:] P, double[:,:] L):
-    return np.array(c_calc_perpendicular_distance(P, L))
-
-
 def pbi(double[:,:] F, double[:,:] weights, double[:] ideal_point, double theta, double eps=1e-10):
     return np.array(c_pbi(F, weights, ideal_point, theta, eps), dtype=np.float64)
 
 
+def decompose(double[:,:] F, double[:,:] weights, kind, utopian_point=None, double theta=5.0,
+              double weight_0=1e-10, bool cross=True, int n_threads=0, workspace=None):
+    return c_decompose(F, weights, kind, utopian_point, theta, weight_0, cross, n_threads, workspace)
+
+
 def calc_distance_to_weights(F, weights, utopian_point=None):
 
     if utopian_point is None:
@@ -38,61 +47,70 @@ def calc_distance_to_weights(F, weights, utopian_point=None):
 # IMPLEMENTATION
 # -----------------------------------------------------------
 
-cdef extern from "math.h":
-    double sqrt(double m)
-    double pow(double base, double exponent)
-
-
-
-
-cdef double c_norm(double[:] v):
+cdef c_check_decompose(F, weights, kind, cross):
+    if kind not in ["pbi", "tchebycheff", "asf"]:
+        raise ValueError("Unknown scalarization: %s" % kind)
+    if F.shape[1] != weights.shape[1]:
+        raise ValueError("F and weights must have the same number of objectives")
+    if not cross and F.shape[0] != weights.shape[0]:
+        raise ValueError("Pairwise decomposition requires one weight per point")
+
+
+cdef c_decompose(double[:,:] F, double[:,:] weights, kind, utopian_point, double theta, double weight_0,
+                 bool cross, int n_threads, workspace):
+    """
+    Scalarizes every point of F against every weight (cross) or against the weight of the same row,
+    using the cache-blocked kernel of Eddie/decomposition.h. The cross product is evaluated in one
+    pass without repeating F and the weights, on n_threads threads (0 = all cores) with the GIL
+    released; the values do not depend on the thread count. With a workspace the kernel of the
+    workspace is reassigned instead of allocating a new one.
+    """
     cdef:
-        double val
-        int i
-
-    val = 0
-    for i in range(v.shape[0]):
-        val += pow(v[i], 2)
-    val = sqrt(val)
-    return val
-
+        double[:, ::1] _F, _weights
+        double[::1] _utopian, _out
+        DecompositionKernel *kernel
 
-cdef double[:,:] c_calc_perpendicular_distance(double[:,:] P, double[:,:] L):
-    cdef :
-        int s_L, s_P, n_dim, i, j, k
-        double[:,:] M
-        vector[double] N
-        double norm, dot, perp_dist, norm_scalar_proj
+    c_check_decompose(F, weights, kind, cross)
 
-    s_L = L.shape[0]
-    s_P = P.shape[0]
-    n_dim = L.shape[1]
+    n_points, n_weights = F.shape[0], weights.shape[0]
+    out = np.zeros(n_points * n_weights if cross else n_points, dtype=np.float64)
+    if n_points == 0 or n_weights == 0:
+        return out.reshape(n_points, n_weights) if cross else out
 
-    M = np.zeros((s_P, s_L), dtype=np.float64)
+    _F, _weights, _out = np.ascontiguousarray(F), np.ascontiguousarray(weights), out
 
-    for i in range(s_L):
+    if utopian_point is None:
+        utopian_point = np.zeros(F.shape[1])
+    _utopian = np.ascontiguousarray(utopian_point, dtype=np.float64)
 
-        norm = c_norm(L[i, :])
+    if isinstance(workspace, Workspace):
+        kernel = &(<Workspace> workspace).c_workspace.decomposition
+        kernel.assign(kind.encode(), &_weights[0, 0], n_weights, _weights.shape[1], theta, weight_0)
+        c_run_decompose(kernel, _F, _utopian, _out, cross, n_threads)
+    else:
+        kernel = new DecompositionKernel(kind.encode(), &_weights[0, 0], n_weights, _weights.shape[1], theta,
+                                         weight_0)
+        try:
+            c_run_decompose(kernel, _F, _utopian, _out, cross, n_threads)
+        finally:
+            del kernel
 
-        N = vector[double](n_dim)
-        for k in range(n_dim):
-            N[k] = L[i, k] / norm
+    return out.reshape(n_points, n_weights) if cross else out
 
-        for j in range(s_P):
 
-            dot = 0
-            for k in range(n_dim):
-                dot += L[i, k] * P[j, k]
-            norm_scalar_proj = dot / norm
+cdef c_run_decompose(DecompositionKernel *kernel, double[:, ::1] F, double[::1] utopian, double[::1] out, bool cross,
+                     int n_threads):
+    with nogil:
+        if cross:
+            kernel.cross(&F[0, 0], F.shape[0], &utopian[0], &out[0], max(n_threads, 0))
+        else:
+            kernel.paired(&F[0, 0], &utopian[0], &out[0])
 
-            perp_dist = 0
-            for k in range(n_dim):
-                perp_dist += pow(norm_scalar_proj * N[k] - P[j, k], 2)
-            perp_dist = sqrt(perp_dist)
 
-            M[j, i] = perp_dist
+cdef extern from "math.h":
+    double sqrt(double m)
+    double pow(double base, double exponent)
 
-    return M
 
 
 
@@ -100,15 +118,16 @@ cdef vector[double] c_pbi(double[:,:] F, double[:,:] weights, double[:] ideal_po
     cdef:
         double d1, d2, f_max, norm
         int i, j, n_dim
-        vector[double] pbi
+        vector[double] pbi, norms
 
     n_points = F.shape[0]
     n_obj = F.shape[1]
     pbi = vector[double](n_points)
+    norms = c_row_norms(weights)
 
     for i in range(n_points):
 
-        norm = c_norm(weights[i,:])
+        norm = norms[i]
 
         d1 = 0
         for j in range(n_obj):
@@ -0,0 +1,176 @@
+# distutils: language = c++
+# cython: language_level=2, boundscheck=False, wraparound=False, cdivision=True
+
+import numpy as np
+
+from libc.stdint cimport uint64_t
+from libcpp cimport bool
+
+from pymoo.util import default_random_state
+
+
+cdef extern from "hypervolume.h":
+    double c_native_hypervolume "hypervolume"(const double *F, size_t n, size_t n_obj, const double *ref) nogil except +
+    void c_native_hypervolume_contributions "hypervolume_contributions"(
+        const double *F, size_t n, size_t n_obj, const double *ref, double *out, size_t n_threads) nogil except +
+
+    cdef cppclass HypervolumeEstimate:
+        double value
+        double standard_error
+        size_t n_samples
+
+    HypervolumeEstimate c_native_hypervolume_monte_carlo "hypervolume_monte_carlo"(
+        const double *F, size_t n, size_t n_obj, const double *ref, size_t n_samples, uint64_t seed,
+        size_t n_threads) nogil except +
+
+    cdef cppclass CHypervolumeArchive "HypervolumeArchive":
+        CHypervolumeArchive(const double *ref, size_t n_obj) except +
+        size_t n_obj()
+        size_t size()
+        double value()
+        bool contains(size_t id)
+        double contribution(size_t id) except +
+        size_t insert(const double *f) except +
+        void insert_many(const double *F, size_t n, size_t *ids, size_t n_threads) nogil except +
+        void remove(size_t id) except +
+        void refresh(size_t n_threads) nogil
+
+
+# ---------------------------------------------------------------------------------------------------------
+# Interface
+# ---------------------------------------------------------------------------------------------------------
+
+
+def hv(ref_point, F):
+    cdef double[:, ::1] _F
+    cdef double[::1] _ref
+    cdef double value
+    _ref, _F = c_prepare(ref_point, F)
+    if _F.shape[0] == 0:
+        return 0.0
+    with nogil:
+        value = c_native_hypervolume(&_F[0, 0], _F.shape[0], _F.shape[1], &_ref[0])
+    return value
+
+
+def hvc(ref_point, F, int n_threads=0):
+    cdef double[:, ::1] _F
+    cdef double[::1] _ref, _out
+    _ref, _F = c_prepare(ref_point, F)
+    out = np.zeros(_F.shape[0])
+    if _F.shape[0] == 0:
+        return out
+    _out = out
+    with nogil:
+        c_native_hypervolume_contributions(&_F[0, 0], _F.shape[0], _F.shape[1], &_ref[0], &_out[0],
+                                           max(n_threads, 0))
+    return out
+
+
+@default_random_state
+def hv_approx(ref_point, F, int n_samples=100000, random_state=None, int n_threads=0):
+    """
+    Monte-Carlo estimate of the hypervolume for many objectives, returned with its standard error.
+    The samples are drawn in the kernel from a Philox stream seeded by `random_state` and counted on
+    n_threads threads (0 = all cores); the estimate does not depend on the thread count.
+    """
+    cdef double[:, ::1] _F
+    cdef double[::1] _ref
+    cdef HypervolumeEstimate estimate
+    cdef uint64_t seed
+
+    _ref, _F = c_prepare(ref_point, F)
+    if _F.shape[0] == 0:
+        return 0.0, 0.0
+    if n_samples <= 0:
+        raise ValueError("The number of samples must be positive")
+
+    seed = random_state.integers(np.iinfo(np.int64).max)
+    with nogil:
+        estimate = c_native_hypervolume_monte_carlo(&_F[0, 0], _F.shape[0], _F.shape[1], &_ref[0], n_samples, seed,
+                                                    max(n_threads, 0))
+    return estimate.value, estimate.standard_error
+
+
+cdef class HypervolumeArchive:
+    """
+    Hypervolume and exclusive contributions of a changing point set backed by the native
+    `HypervolumeArchive` (Eddie/hypervolume.h): inserting or removing a point only updates the
+    contributions it changes instead of recomputing the indicator.
+    """
+
+    cdef CHypervolumeArchive* c_archive
+
+    def __cinit__(self, ref_point):
+        cdef double[::1] ref = np.ascontiguousarray(ref_point, dtype=np.float64).reshape(-1)
+        if ref.shape[0] == 0:
+            raise ValueError("Hypervolume requires at least one objective")
+        self.c_archive = new CHypervolumeArchive(&ref[0], ref.shape[0])
+
+    def __dealloc__(self):
+        del self.c_archive
+
+    def __len__(self):
+        return self.c_archive.size()
+
+    def __contains__(self, i):
+        return i >= 0 and self.c_archive.contains(i)
+
+    @property
+    def n_obj(self):
+        return self.c_archive.n_obj()
+
+    @property
+    def hv(self):
+        return self.c_archive.value()
+
+    def insert(self, f):
+        cdef double[::1] v = np.ascontiguousarray(f, dtype=np.float64).reshape(-1)
+        if v.shape[0] != self.c_archive.n_obj():
+            raise ValueError("Expected %d objective values" % self.c_archive.n_obj())
+        return self.c_archive.insert(&v[0])
+
+    def insert_many(self, F, int n_threads=0):
+        """Inserts the rows of F and computes the indicator once, on n_threads threads (0 = all cores)."""
+        cdef double[:, ::1] _F = np.ascontiguousarray(np.atleast_2d(F), dtype=np.float64)
+        if _F.shape[1] != self.c_archive.n_obj():
+            raise ValueError("Expected %d objective values" % self.c_archive.n_obj())
+        ids = np.zeros(_F.shape[0], dtype=np.uintp)
+        cdef size_t[::1] _ids = ids
+        if _F.shape[0] == 0:
+            return []
+        with nogil:
+            self.c_archive.insert_many(&_F[0, 0], _F.shape[0], &_ids[0], max(n_threads, 0))
+        return ids.tolist()
+
+    def remove(self, size_t i):
+        self.c_archive.remove(i)
+
+    def refresh(self, int n_threads=0):
+        with nogil:
+            self.c_archive.refresh(max(n_threads, 0))
+
+    def contribution(self, size_t i):
+        return self.c_archive.contribution(i)
+
+    def contributions(self, ids):
+        return np.array([self.c_archive.contribution(i) for i in ids], dtype=float)
+
+
+# ---------------------------------------------------------------------------------------------------------
+# Implementation
+# ---------------------------------------------------------------------------------------------------------
+
+
+cdef c_prepare(ref_point, F):
+    ref = np.ascontiguousarray(ref_point, dtype=np.float64).reshape(-1)
+    F = np.ascontiguousarray(F, dtype=np.float64)
+    if F.ndim == 1:
+        F = F[None, :]
+    if len(ref) == 0:
+        raise ValueError("Hypervolume requires at least one objective")
+    if F.shape[0] > 0 and F.shape[1] != len(ref):
+        raise ValueError("The points and the reference point must have the same number of objectives")
+    if F.shape[0] == 0:
+        F = np.zeros((0, len(ref)))
+    return ref, F
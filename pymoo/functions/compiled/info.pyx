@@ -1,5 +1,22 @@
 # distutils: language = c++
 # cython: language_level=2, boundscheck=False, wraparound=False, cdivision=True
 
+cdef extern from "cpu_features.h":
+    # a scoped enum, only passed through
+    cdef cppclass SimdLevel:
+        pass
+    SimdLevel active_simd_level()
+    const char *simd_level_name(SimdLevel level)
+
+
 def info():
     return "yes"
+
+
+def simd_level():
+    """
+    Instruction set the compiled kernels run with on this CPU ("scalar", "sse4", "avx2" or "avx512"),
+    detected when a kernel is first used. Setting the environment variable EDDIE_SIMD to a lower level
+    before importing pymoo caps it, e.g. to compare results or timings across levels.
+    """
+    return simd_level_name(active_simd_level()).decode()
@@ -10,9 +10,11 @@
 
 import numpy as np
 
-from pymoo.functions.compiled.utils cimport c_get_drop, c_get_argmin, c_get_argmax, c_normalize_array
+from pymoo.functions.compiled.utils cimport drop_heap, c_push_drop, c_pop_drop, c_get_argmin, c_get_argmax, c_normalize_array
+from pymoo.functions.compiled.workspace cimport c_scratch_matrix
 
 from libcpp cimport bool
+from libcpp.pair cimport pair
 from libcpp.vector cimport vector
 from libcpp.set cimport set as cpp_set
 
@@ -20,8 +22,18 @@ from libcpp.set cimport set as cpp_set
 cdef extern from "math.h":
     double HUGE_VAL
 
+cdef extern from "kd_tree.h":
+    cdef cppclass KdTree:
+        KdTree(const double *points, size_t n, size_t dim) except +
+        void remove(size_t i)
+        void nearest(size_t i, size_t k, vector[pair[double, size_t]]& out) except +
 
-def calc_mnn(double[:, :] X, int n_remove=0):
+
+# Above this many points method="auto" uses the k-d tree instead of the N x N distance matrix
+cdef int KDTREE_MIN_POINTS = 1000
+
+
+def calc_mnn(double[:, :] X, int n_remove=0, method="auto", workspace=None):
 
     cdef:
         int N, M, n
@@ -31,6 +43,8 @@ def calc_mnn(double[:, :] X, int n_remove=0):
     N = X.shape[0]
     M = X.shape[1]
 
+    c_check_method(method)
+
     if N <= M:
         return np.full(N, HUGE_VAL)
 
@@ -55,10 +69,13 @@ def calc_mnn(double[:, :] X, int n_remove=0):
 
     X = c_normalize_array(X, extremes_max, extremes_min)
 
-    return c_calc_mnn(X, n_remove, N, M, extremes)
+    if c_use_kdtree(method, N):
+        return c_calc_mnn_kdtree(X, n_remove, N, M, extremes)
 
+    return c_calc_mnn(X, n_remove, N, M, extremes, workspace)
 
-def calc_2nn(double[:, :] X, int n_remove=0):
+
+def calc_2nn(double[:, :] X, int n_remove=0, method="auto", workspace=None):
 
     cdef:
         int N, M, n
@@ -68,6 +85,8 @@ def calc_2nn(double[:, :] X, int n_remove=0):
     N = X.shape[0]
     M = X.shape[1]
 
+    c_check_method(method)
+
     if n_remove <= (N - M):
         if n_remove < 0:
             n_remove = 0
@@ -91,35 +110,143 @@ def calc_2nn(double[:, :] X, int n_remove=0):
 
     M = 2
 
-    return c_calc_mnn(X, n_remove, N, M, extremes)
+    if c_use_kdtree(method, N):
+        return c_calc_mnn_kdtree(X, n_remove, N, M, extremes)
+
+    return c_calc_mnn(X, n_remove, N, M, extremes, workspace)
+
 
+cdef c_check_method(method):
+    if method not in ("auto", "dense", "kdtree"):
+        raise ValueError("Unknown method '%s', use 'auto', 'dense' or 'kdtree'" % method)
 
-cdef c_calc_mnn(double[:, :] X, int n_remove, int N, int M, cpp_set[int] extremes):
+
+cdef bool c_use_kdtree(method, int N):
+    return method == "kdtree" or (method == "auto" and N > KDTREE_MIN_POINTS)
+
+
+# Same metric as c_calc_mnn without the N x N matrix: neighbors come from a k-d tree that drops
+# points as they are removed, and users[j] lists the items that took j as a neighbor, so a
+# removal only requeries the items that lost it. The extremes keep HUGE_VAL and are never queried.
+cdef c_calc_mnn_kdtree(double[:, :] X, int n_remove, int N, int M, cpp_set[int] extremes):
+
+    cdef:
+        int n, i, k, n_removed
+        size_t u
+        double[:, ::1] _X
+        vector[bool] H, is_extreme
+        vector[vector[int]] users
+        vector[pair[double, size_t]] found
+        drop_heap heap
+        double[:] d
+        int[:, :] Mnn
+        KdTree* tree
+
+    is_extreme = vector[bool](N, False)
+    for n in extremes:
+        is_extreme[n] = True
+
+    H = vector[bool](N, True)
+    users = vector[vector[int]](N)
+
+    _Mnn = np.full((N, M), -1, dtype=np.intc)
+    dd = np.full((N,), HUGE_VAL, dtype=np.double)
+
+    Mnn = _Mnn[:, :]
+    d = dd[:]
+
+    _X = np.ascontiguousarray(X)
+    tree = new KdTree(&_X[0, 0], N, _X.shape[1])
+
+    try:
+
+        for i in range(N):
+            if not is_extreme[i]:
+                c_query_neighbors(tree, i, M, Mnn, d, users, found)
+
+        for n in range(N):
+            c_push_drop(heap, d, n)
+
+        # Initialize
+        n_removed = 0
+
+        while n_removed < (n_remove - 1):
+
+            # Obtain element to drop (and remove it from H and the tree)
+            k = c_pop_drop(heap, d, H)
+            tree.remove(k)
+
+            # Update index
+            n_removed = n_removed + 1
+
+            # Requery the items that currently have k as a neighbor
+            for u in range(users[k].size()):
+                i = users[k][u]
+                if H[i] and c_has_neighbor(Mnn, i, k, M):
+                    c_query_neighbors(tree, i, M, Mnn, d, users, found)
+                    c_push_drop(heap, d, i)
+
+            users[k].clear()
+
+    finally:
+        del tree
+
+    return dd
+
+
+cdef void c_query_neighbors(KdTree* tree, int i, int M, int[:, :] Mnn, double[:] d,
+                            vector[vector[int]]& users, vector[pair[double, size_t]]& found) except *:
+
+    cdef:
+        size_t m
+
+    tree.nearest(i, M, found)
+
+    d[i] = 1
+    for m in range(found.size()):
+        Mnn[i, m] = found[m].second
+        d[i] = d[i] * found[m].first
+        users[found[m].second].push_back(i)
+
+
+cdef bool c_has_neighbor(int[:, :] Mnn, int i, int k, int M):
+
+    cdef:
+        int m
+
+    for m in range(M):
+        if Mnn[i, m] == k:
+            return True
+    return False
+
+
+cdef c_calc_mnn(double[:, :] X, int n_remove, int N, int M, cpp_set[int] extremes, workspace):
 
     cdef:
         int n, mm, i, j, n_removed, k, MM
         double dij
-        cpp_set[int] calc_items
-        cpp_set[int] H
+        vector[int] calc_items
+        vector[bool] H, is_extreme
+        drop_heap heap
         double[:, :] D
         double[:] d
         int[:, :] Mnn
 
-    # Define items to calculate distances
-    calc_items = cpp_set[int]()
-    for n in range(N):
-        calc_items.insert(n)
+    # Dense masks of the extremes and of the remaining items to evaluate
+    is_extreme = vector[bool](N, False)
     for n in extremes:
-        calc_items.erase(n)
+        is_extreme[n] = True
+
+    H = vector[bool](N, True)
 
-    # Define remaining items to evaluate
-    H = cpp_set[int]()
+    # Define items to calculate distances
+    calc_items = vector[int]()
     for n in range(N):
-        H.insert(n)
+        if not is_extreme[n]:
+            calc_items.push_back(n)
 
-    # Instantiate distances array
-    _D = np.empty((N, N), dtype=np.double)
-    D = _D[:, :]
+    # Instantiate distances array (scratch, from the workspace arena if given)
+    D = c_scratch_matrix(workspace, N, N, 0.0)
 
     # Shape of X
     MM = X.shape[1]
@@ -153,20 +280,20 @@ cdef c_calc_mnn(double[:, :] X, int n_remove, int N, int M, cpp_set[int] extreme
     # Obtain distance metrics
     c_calc_d(d, Mnn, D, calc_items, M)
 
+    for n in range(N):
+        c_push_drop(heap, d, n)
+
     # While n_remove not acheived (no need to recalculate if only one item should be removed)
     while n_removed < (n_remove - 1):
 
-        # Obtain element to drop
-        k = c_get_drop(d, H)
-        H.erase(k)
+        # Obtain element to drop (and remove it from H)
+        k = c_pop_drop(heap, d, H)
 
         # Update index
         n_removed = n_removed + 1
 
         # Get items to be recalculated
-        calc_items = c_get_calc_items(Mnn, H, k, M)
-        for n in extremes:
-            calc_items.erase(n)
+        calc_items = c_get_calc_items(Mnn, H, is_extreme, k, N, M)
 
         # Fill in neighbors and distance matrix
         c_calc_mnn_iter(
@@ -181,6 +308,9 @@ cdef c_calc_mnn(double[:, :] X, int n_remove, int N, int M, cpp_set[int] extreme
         # Obtain distance metrics
         c_calc_d(d, Mnn, D, calc_items, M)
 
+        for n in calc_items:
+            c_push_drop(heap, d, n)
+
     return dd
 
 
@@ -189,8 +319,8 @@ cdef c_calc_mnn_iter(
     int[:, :] Mnn,
     double[:, :] D,
     int N, int M,
-    cpp_set[int] calc_items,
-    cpp_set[int] H
+    vector[int]& calc_items,
+    vector[bool]& H
     ):
 
     cdef:
@@ -199,11 +329,11 @@ cdef c_calc_mnn_iter(
     # Iterate over items to calculate
     for i in calc_items:
 
-        # Iterate over elements in X
-        for j in H:
+        # Iterate over remaining elements in X
+        for j in range(N):
 
-            # Go to next if same element
-            if (j == i):
+            # Go to next if same element or already removed
+            if (j == i) or not H[j]:
                 continue
 
             # Replace at least the last neighbor
@@ -235,7 +365,7 @@ cdef c_calc_mnn_iter(
 
 
 # Calculate crowding metric
-cdef c_calc_d(double[:] d, int[:, :] Mnn, double[:, :] D, cpp_set[int] calc_items, int M):
+cdef c_calc_d(double[:] d, int[:, :] Mnn, double[:, :] D, vector[int]& calc_items, int M):
 
     cdef:
         int i, m
@@ -247,19 +377,23 @@ cdef c_calc_d(double[:] d, int[:, :] Mnn, double[:, :] D, cpp_set[int] calc_item
             d[i] = d[i] * D[i, Mnn[i, m]]
 
 
-# Returns indexes of items to be recalculated after removal
-cdef cpp_set[int] c_get_calc_items(
+# Returns indexes of (non-extreme) items to be recalculated after removal
+cdef vector[int] c_get_calc_items(
     int[:, :] Mnn,
-    cpp_set[int] H,
-    int k, int M):
+    vector[bool]& H,
+    vector[bool]& is_extreme,
+    int k, int N, int M):
 
     cdef:
         int i, m
-        cpp_set[int] calc_items
+        vector[int] calc_items
+
+    calc_items = vector[int]()
 
-    calc_items = cpp_set[int]()
+    for i in range(N):
 
-    for i in H:
+        if not H[i]:
+            continue
 
         for m in range(M):
 
@@ -268,6 +402,9 @@ cdef cpp_set[int] c_get_calc_items(
                 Mnn[i, m:-1] = Mnn[i, m + 1:]
                 Mnn[i, M-1] = -1
 
-                calc_items.insert(i)
+                # k appears at most once among the neighbors of i
+                if not is_extreme[i]:
+                    calc_items.push_back(i)
+                break
 
     return calc_items
@@ -6,6 +6,8 @@ import numpy as np
 from libcpp cimport bool
 from libcpp.vector cimport vector
 
+from pymoo.functions.compiled.workspace cimport FrontSet, FastSortWorkspace, DominanceDegreeWorkspace, Workspace
+
 
 cdef extern from "math.h":
     cpdef double floor(double x)
@@ -13,170 +15,266 @@ cdef extern from "math.h":
 cdef extern from "limits.h":
     int INT_MAX
 
+cdef extern from "ranking.h":
+    vector[vector[int]] c_native_fast_non_dominated_sort "fast_non_dominated_sort_fronts"(
+        const double *F, size_t n, size_t n_obj, double epsilon, size_t n_stop_if_ranked, size_t max_fronts,
+        size_t n_threads) nogil except +
+    vector[int] c_native_find_non_dominated "find_non_dominated_indices"(
+        const double *F, size_t n, size_t n_obj, double epsilon, size_t n_threads) nogil except +
+    vector[vector[int]] c_native_dominance_degree_non_dominated_sort "dominance_degree_non_dominated_sort_fronts"(
+        const double *F, size_t n, size_t n_obj) except +
+
+    # the same sorts writing into the reusable buffers of a Workspace
+    void c_native_fast_non_dominated_sort_into "fast_non_dominated_sort"(
+        const double *F, size_t n, size_t n_obj, FrontSet& fronts, FastSortWorkspace& workspace, double epsilon,
+        size_t n_stop_if_ranked, size_t max_fronts, size_t n_threads) nogil except +
+    void c_native_dominance_degree_non_dominated_sort_into "dominance_degree_non_dominated_sort"(
+        const double *F, size_t n, size_t n_obj, FrontSet& fronts, DominanceDegreeWorkspace& workspace) except +
+
+# Pareto relations instantiated for the objective count (unrolled for 2, 3 and 4), picked once per sort
+cdef extern from "dominance.h":
+    ctypedef int (*DominanceRelationKernel)(const double *a, const double *b, size_t n_obj, double epsilon) nogil
+    ctypedef bool (*ObjectivesEqualKernel)(const double *a, const double *b, size_t n_obj) nogil
+    ctypedef bool (*NoBetterFromKernel)(const double *a, const double *b, const int *objectives, size_t first,
+                                        size_t n_obj) nogil
+    DominanceRelationKernel dominance_relation_kernel(size_t n_obj) nogil
+    ObjectivesEqualKernel objectives_equal_kernel(size_t n_obj) nogil
+    NoBetterFromKernel no_better_from_kernel(size_t n_obj) nogil
+
+cdef extern from "fronts.h":
+    cdef cppclass FrontCut:
+        FrontCut()
+        FrontCut(size_t n_stop_if_ranked, size_t max_fronts)
+        size_t limit()
+        bool keeps(size_t k)
+        void add(const size_t *front_size, size_t n_fronts)
+
+cdef extern from "pareto_archive.h":
+    cdef cppclass CParetoArchive "ParetoArchive":
+        CParetoArchive(size_t n_obj) except +
+        size_t insert(const double *f) except +
+        void remove(size_t id) except +
+        bool contains(size_t id)
+        size_t size()
+        size_t n_obj()
+        size_t n_fronts()
+        size_t rank(size_t id) except +
+        void front(size_t k, vector[size_t]& out) except +
+
 
 # ---------------------------------------------------------------------------------------------------------
 # Interface
 # ---------------------------------------------------------------------------------------------------------
 
+# Two and three objectives are sorted by the O(n log n) sweep of Eddie/ranking.h whichever method is asked
+# for (fast_non_dominated_sort and find_non_dominated pick it natively); the fronts are the same.
+cdef bool c_use_sweep(double[:,:] F):
+    return F.shape[1] == 2 or F.shape[1] == 3
 
 
-def fast_non_dominated_sort(double[:,:] F, double epsilon = 0.0, int n_stop_if_ranked=INT_MAX, int n_fronts=INT_MAX):
-    return c_fast_non_dominated_sort(F, epsilon, n_stop_if_ranked, n_fronts)
+def fast_non_dominated_sort(double[:,:] F, double epsilon = 0.0, int n_stop_if_ranked=INT_MAX, int n_fronts=INT_MAX,
+                            int n_threads=0, workspace=None):
+    if isinstance(workspace, Workspace):
+        return c_fast_non_dominated_sort_workspace(F, epsilon, n_stop_if_ranked, n_fronts, n_threads, workspace)
+    return c_fast_non_dominated_sort(F, epsilon, n_stop_if_ranked, n_fronts, n_threads)
 
-def find_non_dominated(double[:,:] F, double epsilon = 0.0):
-    return c_find_non_dominated(F, epsilon)
+def find_non_dominated(double[:,:] F, double epsilon = 0.0, int n_threads=0):
+    return c_find_non_dominated(F, epsilon, n_threads)
 
-def best_order_sort(double[:,:] F):
-    return c_best_order_sort(F)
+def best_order_sort(double[:,:] F, int n_stop_if_ranked=INT_MAX):
+    if c_use_sweep(F):
+        return c_fast_non_dominated_sort(F, 0.0, n_stop_if_ranked)
+    return c_best_order_sort(F, n_stop_if_ranked)
 
 def get_relation(F, a, b):
     return c_get_relation(F, a, b)
 
-def fast_best_order_sort(double[:,:] F):
-    return c_fast_best_order_sort(F)
+def fast_best_order_sort(double[:,:] F, int n_stop_if_ranked=INT_MAX):
+    if c_use_sweep(F):
+        return c_fast_non_dominated_sort(F, 0.0, n_stop_if_ranked)
+    return c_fast_best_order_sort(F, n_stop_if_ranked)
 
-def efficient_non_dominated_sort(double[:,:] F, strategy="sequential"):
+def efficient_non_dominated_sort(double[:,:] F, strategy="sequential", int n_stop_if_ranked=INT_MAX):
     assert (strategy in ["sequential", 'binary']), "Invalid search strategy"
-    return c_efficient_non_dominated_sort(F, strategy)
+    if c_use_sweep(F):
+        return c_fast_non_dominated_sort(F, 0.0, n_stop_if_ranked)
+    return c_efficient_non_dominated_sort(F, strategy, n_stop_if_ranked)
 
-def dominance_degree_non_dominated_sort(double[:, :] F, strategy="efficient"):
-    if strategy not in ["fast", "efficient"]:
+def dominance_degree_non_dominated_sort(double[:, :] F, strategy="efficient", workspace=None):
+    if strategy not in ["fast", "efficient", "bitset"]:
         raise ValueError("Invalid search strategy")
+    if c_use_sweep(F):
+        if isinstance(workspace, Workspace):
+            return c_fast_non_dominated_sort_workspace(F, 0.0, INT_MAX, INT_MAX, 0, workspace)
+        return c_fast_non_dominated_sort(F)
+    if strategy == "bitset" and isinstance(workspace, Workspace):
+        return c_dominance_degree_bitset_workspace(F, workspace)
     return c_dominance_degree_non_dominated_sort(F, strategy)
 
 
+cdef class ParetoArchive:
+    """Incremental Pareto ranking backed by the native `ParetoArchive` (Eddie/pareto_archive.h)."""
 
+    cdef CParetoArchive* c_archive
 
-# ---------------------------------------------------------------------------------------------------------
-# Fast Non-Dominated Sort
-# ---------------------------------------------------------------------------------------------------------
+    def __cinit__(self, int n_obj):
+        if n_obj <= 0:
+            raise ValueError("Pareto archive requires at least one objective")
+        self.c_archive = new CParetoArchive(n_obj)
 
+    def __dealloc__(self):
+        del self.c_archive
 
+    def __len__(self):
+        return self.c_archive.size()
 
-cdef vector[vector[int]] c_fast_non_dominated_sort(double[:,:] F, double epsilon = 0.0, int n_stop_if_ranked=INT_MAX, int n_fronts=INT_MAX):
+    def __contains__(self, i):
+        return i >= 0 and self.c_archive.contains(i)
 
-    cdef:
-        int n_points, i, j, rel, n_ranked
-        vector[int] current_front, next_front, n_dominated
-        vector[vector[int]] fronts, is_dominating
+    @property
+    def n_obj(self):
+        return self.c_archive.n_obj()
 
-    # calculate the dominance matrix
-    n_points = F.shape[0]
+    @property
+    def n_fronts(self):
+        return self.c_archive.n_fronts()
 
-    fronts = vector[vector[int]]()
+    def insert(self, f):
+        cdef double[::1] v = np.ascontiguousarray(f, dtype=np.float64).reshape(-1)
+        if v.shape[0] != self.c_archive.n_obj():
+            raise ValueError("Expected %d objective values" % self.c_archive.n_obj())
+        return self.c_archive.insert(&v[0])
 
-    if n_points == 0:
-        return fronts
+    def remove(self, size_t i):
+        self.c_archive.remove(i)
 
-    # final rank that will be returned
-    n_ranked = 0
+    def rank(self, size_t i):
+        return self.c_archive.rank(i)
 
-    # for each individual a list of all individuals that are dominated by this one
-    is_dominating = vector[vector[int]](n_points)
-    for _ in range(n_points):
-        is_dominating.push_back(vector[int](n_points))
+    def front(self, size_t k):
+        cdef vector[size_t] members
+        if k >= self.c_archive.n_fronts():
+            raise IndexError("Front index out of range")
+        self.c_archive.front(k, members)
+        return np.array(members, dtype=int)
 
-    n_dominated = vector[int]()
-    for i in range(n_points):
-        n_dominated.push_back(0)
+    def fronts(self):
+        return [self.front(k) for k in range(self.c_archive.n_fronts())]
 
-    current_front = vector[int]()
 
-    for i in range(n_points):
 
-        for j in range(i + 1, n_points):
 
-            rel = c_get_relation(F, i, j, epsilon)
+# ---------------------------------------------------------------------------------------------------------
+# Fast Non-Dominated Sort
+# ---------------------------------------------------------------------------------------------------------
+
+
+
+cdef vector[vector[int]] c_fast_non_dominated_sort(double[:,:] F, double epsilon = 0.0, int n_stop_if_ranked=INT_MAX,
+                                                   int n_fronts=INT_MAX, int n_threads=0):
+
+    cdef:
+        double[:, ::1] _F
+        vector[vector[int]] fronts
+
+    fronts = vector[vector[int]]()
+
+    if F.shape[0] == 0:
+        return fronts
 
-            if rel == 1:
-                is_dominating[i].push_back(j)
-                n_dominated[j] += 1
+    # the native kernel stores dominance as a packed bit matrix and expects a row-major F
+    _F = np.ascontiguousarray(F)
 
-            elif rel == -1:
-                is_dominating[j].push_back(i)
-                n_dominated[i] += 1
+    # the pairwise comparisons run on n_threads threads (0 = all cores) with the GIL released;
+    # the fronts are the same for any thread count
+    with nogil:
+        fronts = c_native_fast_non_dominated_sort(&_F[0, 0], _F.shape[0], _F.shape[1], epsilon,
+                                                  max(n_stop_if_ranked, 0), max(n_fronts, 0), max(n_threads, 0))
+    return fronts
 
-        if n_dominated[i] == 0:
-            current_front.push_back(i)
-            n_ranked += 1
 
-    # append the first front to the current front
-    fronts.push_back(current_front)
+cdef list c_fast_non_dominated_sort_workspace(double[:,:] F, double epsilon, int n_stop_if_ranked, int n_fronts,
+                                              int n_threads, Workspace workspace):
+    """
+    Same fronts as c_fast_non_dominated_sort, but the dominance matrix and the fronts are kept in the
+    workspace, so that repeated sorts of equally large populations do not allocate.
+    """
+    cdef double[:, ::1] _F
 
-    # while not all solutions are assigned to a pareto front or we can stop early because of stop criterion
-    while (n_ranked < n_points) and (n_ranked < n_stop_if_ranked) and (fronts.size() < n_fronts):
+    if F.shape[0] == 0:
+        return []
 
-        next_front = vector[int]()
+    _F = np.ascontiguousarray(F)
+    with nogil:
+        c_native_fast_non_dominated_sort_into(&_F[0, 0], _F.shape[0], _F.shape[1], workspace.c_workspace.fronts,
+                                              workspace.c_workspace.sort, epsilon, max(n_stop_if_ranked, 0),
+                                              max(n_fronts, 0), max(n_threads, 0))
+    return c_split_fronts(workspace.c_workspace.fronts)
 
-        # for each individual in the current front
-        for i in current_front:
 
-            # all solutions that are dominated by this individuals
-            for j in is_dominating[i]:
+# Fronts of a FrontSet as lists of indices, the same type the kernels without a workspace return
+cdef list c_split_fronts(FrontSet& fronts):
 
-                n_dominated[j] -= 1
-                if n_dominated[j] == 0:
-                    next_front.push_back(j)
-                    n_ranked += 1
+    cdef:
+        size_t i, k
+        list ret = [], front
 
-        fronts.push_back(next_front)
-        current_front = next_front
+    for k in range(fronts.size()):
+        front = []
+        for i in range(fronts.offsets[k], fronts.offsets[k + 1]):
+            front.append(<int> fronts.members[i])
+        ret.append(front)
 
-    return fronts
+    return ret
 
 
 # ---------------------------------------------------------------------------------------------------------
 # Optimized Find Non-Dominated
 # ---------------------------------------------------------------------------------------------------------
 
-cdef vector[int] c_find_non_dominated(double[:,:] F, double epsilon = 0.0):
+cdef vector[int] c_find_non_dominated(double[:,:] F, double epsilon = 0.0, int n_threads=0):
     """
     Simple and efficient function to find only non-dominated points.
-    Uses the existing optimized c_get_relation function.
+    Every point is compared against blocks of 64 others and stops at the first block holding a
+    dominator; the points are split over n_threads threads (0 = all cores) with the GIL released.
     """
     cdef:
-        int n_points = F.shape[0]
-        int i, j
-        bool is_dominated
+        double[:, ::1] _F
         vector[int] non_dominated_indices
-    
-    if n_points == 0:
+
+    if F.shape[0] == 0:
         return non_dominated_indices
-    
-    # Check each point to see if it's non-dominated
-    for i in range(n_points):
-        is_dominated = False
-        
-        # Check if point i is dominated by any other point j
-        for j in range(n_points):
-            if i != j:
-                # Use the existing optimized c_get_relation function
-                # c_get_relation returns 1 if j dominates i, -1 if i dominates j, 0 if neither
-                if c_get_relation(F, j, i, epsilon) == 1:
-                    is_dominated = True
-                    break  # Early termination - no need to check other points
-        
-        # If point i is not dominated by any other point, it's non-dominated
-        if not is_dominated:
-            non_dominated_indices.push_back(i)
-    
+
+    _F = np.ascontiguousarray(F)
+
+    with nogil:
+        non_dominated_indices = c_native_find_non_dominated(&_F[0, 0], _F.shape[0], _F.shape[1], epsilon,
+                                                            max(n_threads, 0))
     return non_dominated_indices
 
 
-cdef vector[vector[int]] c_best_order_sort(double[:,:] F):
+cdef vector[vector[int]] c_best_order_sort(double[:,:] F, int n_stop_if_ranked=INT_MAX):
 
     cdef:
-        int n_points, n_obj, n_fronts, n_ranked, i, j, s, e, l, z
+        int n_points, n_obj, n_fronts, n_ranked, n_searched, i, j, s, e, l, z
         vector[int] rank
         int[:,:] Q
         bool is_dominated
         vector[vector[int]] fronts, empty
         vector[vector[vector[int]]] L
+        vector[size_t] front_size
+        FrontCut cut
+        double[:, ::1] _F
+        DominanceRelationKernel relation
 
     n_points = F.shape[0]
     n_obj = F.shape[1]
     fronts = vector[vector[int]]()
 
+    # rows of a contiguous copy go to the relation kernel for this objective count
+    _F = np.ascontiguousarray(F)
+    relation = dominance_relation_kernel(n_obj)
+
     _Q = np.zeros((n_points, n_obj), dtype=np.intc)
     for j in range(n_obj):
         _Q[:, j] = np.lexsort(F[:, j:][:, ::-1].T, axis=0)
@@ -194,6 +292,10 @@ cdef vector[vector[int]] c_best_order_sort(double[:,:] F):
     n_fronts = 0
     n_ranked = 0
 
+    # only the fronts up to the one reaching n_stop_if_ranked solutions are built; solutions
+    # behind that cut get rank -2 and are not compared against any more (see Eddie/fronts.h)
+    cut = FrontCut(max(n_stop_if_ranked, 0), <size_t> -1)
+
     # the outer loop iterates through all solutions
     for i in range(n_points):
 
@@ -203,6 +305,10 @@ cdef vector[vector[int]] c_best_order_sort(double[:,:] F):
             # index of the current solution
             s = Q[i, j]
 
+            # solutions behind the cut do not affect the rank of the ones before it
+            if rank[s] == -2 or (rank[s] >= 0 and not cut.keeps(rank[s])):
+                continue
+
             # if solution was already ranked before - just append it to the corresponding front
             if rank[s] != -1:
                 L[j][rank[s]].push_back(s)
@@ -213,15 +319,16 @@ cdef vector[vector[int]] c_best_order_sort(double[:,:] F):
                 # the rank of this solution is stored here
                 s_rank = -1
 
-                # for each front ranked for this objective
-                for k in range(n_fronts):
+                # for each front ranked for this objective (in front of the cut)
+                n_searched = min(<size_t> n_fronts, cut.limit())
+                for k in range(n_searched):
 
                     is_dominated = False
 
                     # for each entry in that front
                     for e in L[j][k]:
 
-                        is_dominated = c_get_relation(F, s, e) == -1
+                        is_dominated = relation(&_F[s, 0], &_F[e, 0], n_obj, 0.0) == -1
 
                         # if one solution dominates the current one - go to the next front
                         if is_dominated:
@@ -232,6 +339,14 @@ cdef vector[vector[int]] c_best_order_sort(double[:,:] F):
                         s_rank = k
                         break
 
+                # dominated in every front before the cut
+                if s_rank == -1 and not cut.keeps(n_searched):
+                    rank[s] = -2
+                    n_ranked += 1
+                    if n_ranked == n_points:
+                        break
+                    continue
+
                 # we need to add a new front for each objective
                 if s_rank == -1:
 
@@ -239,6 +354,7 @@ cdef vector[vector[int]] c_best_order_sort(double[:,:] F):
                     n_fronts += 1
 
                     fronts.push_back(vector[int]())
+                    front_size.push_back(0)
                     for l in range(n_obj):
                         L[l].push_back(vector[int]())
 
@@ -246,27 +362,38 @@ cdef vector[vector[int]] c_best_order_sort(double[:,:] F):
                 fronts[s_rank].push_back(s)
                 rank[s] = s_rank
                 n_ranked += 1
+                front_size[s_rank] += 1
+                cut.add(&front_size[0], front_size.size())
 
                 if n_ranked == n_points:
                     break
 
+    fronts.resize(min(<size_t> n_fronts, cut.limit()))
     return fronts
 
 
-cdef vector[vector[int]] c_fast_best_order_sort(double[:,:] F):
+cdef vector[vector[int]] c_fast_best_order_sort(double[:,:] F, int n_stop_if_ranked=INT_MAX):
 
     cdef:
-        int n_points, n_obj, n_fronts, n_ranked, i, j, s, e, l, z, s_next
+        int n_points, n_obj, n_fronts, n_ranked, n_searched, i, j, s, e, l, z, s_next
         vector[int] rank, counter, check_if_equal
         int[:,:] Q
         bool is_dominated
         vector[vector[int]] fronts, empty ,C
         vector[vector[vector[int]]] L
+        vector[size_t] front_size
+        FrontCut cut
+        double[:, ::1] _F
+        NoBetterFromKernel no_better_from
+        ObjectivesEqualKernel is_equal_to
 
     n_points = F.shape[0]
     n_obj = F.shape[1]
     fronts = vector[vector[int]]()
 
+    _F = np.ascontiguousarray(F)
+    no_better_from = no_better_from_kernel(n_obj)
+    is_equal_to = objectives_equal_kernel(n_obj)
 
     _Q = np.zeros((n_points, n_obj), dtype=np.intc)
     _Q[:, 0] = np.lexsort(F[:, ::-1].T, axis=0)
@@ -302,6 +429,9 @@ cdef vector[vector[int]] c_fast_best_order_sort(double[:,:] F):
     n_fronts = 0
     n_ranked = 0
 
+    # survival cut as in c_best_order_sort
+    cut = FrontCut(max(n_stop_if_ranked, 0), <size_t> -1)
+
     # the outer loop iterates through all solutions
     for i in range(n_points):
 
@@ -322,6 +452,10 @@ cdef vector[vector[int]] c_fast_best_order_sort(double[:,:] F):
                 elif check_if_equal[s] != s_next:
                     check_if_equal[s] = -2
 
+            # solutions behind the cut do not affect the rank of the ones before it
+            if rank[s] == -2 or (rank[s] >= 0 and not cut.keeps(rank[s])):
+                continue
+
             # if solution was already ranked before - just append it to the corresponding front
             if rank[s] != -1:
                 L[j][rank[s]].push_back(s)
@@ -332,8 +466,9 @@ cdef vector[vector[int]] c_fast_best_order_sort(double[:,:] F):
                 # the rank of this solution is stored here
                 s_rank = -1
 
-                # for each front ranked for this objective
-                for k in range(n_fronts):
+                # for each front ranked for this objective (in front of the cut)
+                n_searched = min(<size_t> n_fronts, cut.limit())
+                for k in range(n_searched):
 
                     # just necessary if no fronts exists
                     is_dominated = False
@@ -342,11 +477,12 @@ cdef vector[vector[int]] c_fast_best_order_sort(double[:,:] F):
                     # for each entry in that front
                     for e in L[j][k]:
 
-                        # get the domination relation - might return true even if equal
-                        is_dominated = c_is_dominating_or_equal(F, e, s, C, counter[s])
+                        # get the domination relation - might return true even if equal: s is no better than e
+                        # in the objectives after the counter[s] ones already compared in sorted order
+                        is_dominated = no_better_from(&_F[e, 0], &_F[s, 0], &C[s][0], counter[s], n_obj)
 
                         if is_dominated and check_if_equal[e] == s:
-                            is_equal = c_is_equal(F, s, e)
+                            is_equal = is_equal_to(&_F[s, 0], &_F[e, 0], n_obj)
 
                         # if just one solution dominates the current one - go to the next front
                         if is_dominated or is_equal:
@@ -357,6 +493,14 @@ cdef vector[vector[int]] c_fast_best_order_sort(double[:,:] F):
                         s_rank = k
                         break
 
+                # dominated in every front before the cut
+                if s_rank == -1 and not cut.keeps(n_searched):
+                    rank[s] = -2
+                    n_ranked += 1
+                    if n_ranked == n_points:
+                        break
+                    continue
+
                 # we need to add a new front for each objective
                 if s_rank == -1:
 
@@ -364,6 +508,7 @@ cdef vector[vector[int]] c_fast_best_order_sort(double[:,:] F):
                     n_fronts += 1
 
                     fronts.push_back(vector[int]())
+                    front_size.push_back(0)
                     for l in range(n_obj):
                         L[l].push_back(vector[int]())
 
@@ -371,10 +516,13 @@ cdef vector[vector[int]] c_fast_best_order_sort(double[:,:] F):
                 fronts[s_rank].push_back(s)
                 rank[s] = s_rank
                 n_ranked += 1
+                front_size[s_rank] += 1
+                cut.add(&front_size[0], front_size.size())
 
                 if n_ranked == n_points:
                     break
 
+    fronts.resize(min(<size_t> n_fronts, cut.limit()))
     return fronts
 
 
@@ -392,6 +540,25 @@ cdef vector[vector[int]] c_dominance_degree_non_dominated_sort(double[:, :] F, s
     elif strategy == "fast":
         # return c_dda_ns_get_fronts(c_construct_domination_matrix(F), F.shape[1], F.shape[0])
         return c_dda_ns_get_fronts(c_construct_domination_matrix(F), F.shape[0], F.shape[1])
+    elif strategy == "bitset":
+        # packed comparison rows (n^2 bits instead of two n^2 int matrices), see Eddie/ranking.h
+        return c_dominance_degree_bitset(F)
+
+
+cdef vector[vector[int]] c_dominance_degree_bitset(double[:, :] F):
+    cdef double[:, ::1] _F = np.ascontiguousarray(F)
+    if _F.shape[0] == 0:
+        return vector[vector[int]]()
+    return c_native_dominance_degree_non_dominated_sort(&_F[0, 0], _F.shape[0], _F.shape[1])
+
+
+cdef list c_dominance_degree_bitset_workspace(double[:, :] F, Workspace workspace):
+    cdef double[:, ::1] _F = np.ascontiguousarray(F)
+    if _F.shape[0] == 0:
+        return []
+    c_native_dominance_degree_non_dominated_sort_into(&_F[0, 0], _F.shape[0], _F.shape[1],
+                                                      workspace.c_workspace.fronts, workspace.c_workspace.degree)
+    return c_split_fronts(workspace.c_workspace.fronts)
 
 
 
@@ -401,38 +568,54 @@ cdef vector[vector[int]] c_dominance_degree_non_dominated_sort(double[:, :] F, s
 # ---------------------------------------------------------------------------------------------------------
 
 
-cdef vector[vector[int]] c_efficient_non_dominated_sort(double[:,:] F, str strategy):
+cdef vector[vector[int]] c_efficient_non_dominated_sort(double[:,:] F, str strategy, int n_stop_if_ranked=INT_MAX):
     cdef:
-        long unsigned int i, j, k, n, val
+        long unsigned int i, j, k, n, val, n_searched
         vector[int] empty, e
         vector[vector[int]] fronts, ret
+        vector[size_t] front_size
+        FrontCut cut
+        double[:, ::1] _F
+        DominanceRelationKernel relation
 
     # number of individuals
     n = len(F)
 
     # sort the input lexicographically
     indices = np.lexsort(F.T[::-1])
-    F = np.asarray(F)[indices]
+    _F = np.ascontiguousarray(np.asarray(F)[indices])
+    relation = dominance_relation_kernel(F.shape[1])
 
     # the fronts to be set for each iteration
     fronts = vector[vector[int]]()
 
+    # only the fronts up to the one reaching n_stop_if_ranked individuals are built, individuals
+    # dominated in all of them are dropped (see Eddie/fronts.h)
+    cut = FrontCut(max(n_stop_if_ranked, 0), <size_t> -1)
+
     for i in range(n):
 
+        n_searched = min(fronts.size(), cut.limit())
         if strategy == "sequential":
-            k = sequential_search(F, i, fronts)
+            k = sequential_search(_F, i, fronts, n_searched, relation)
         else:
-            k = binary_search(F, i, fronts)
+            k = binary_search(_F, i, fronts, n_searched, relation)
+
+        if not cut.keeps(k):
+            continue
 
         if k >= fronts.size():
             empty = vector[int]()
             fronts.push_back(empty)
+            front_size.push_back(0)
 
         fronts[k].push_back(i)
+        front_size[k] += 1
+        cut.add(&front_size[0], front_size.size())
 
     # convert to the return array
     ret = vector[vector[int]]()
-    for i in range(fronts.size()):
+    for i in range(min(fronts.size(), cut.limit())):
         e = vector[int]()
         for j in range(fronts[i].size()):
             k = fronts[i][j]
@@ -444,13 +627,14 @@ cdef vector[vector[int]] c_efficient_non_dominated_sort(double[:,:] F, str strat
 
 
 
-cdef int sequential_search(double[:,:] F, int i, vector[vector[int]] fronts):
+cdef int sequential_search(double[:, ::1] F, int i, vector[vector[int]]& fronts, int n_fronts,
+                           DominanceRelationKernel relation):
 
     cdef:
-        int k, j, n_fronts
+        int k, j
         bool non_dominated
 
-    n_fronts = fronts.size()
+    # only the first n_fronts fronts are searched; n_fronts is returned if all of them dominate i
     if n_fronts == 0:
         return 0
 
@@ -463,8 +647,7 @@ cdef int sequential_search(double[:,:] F, int i, vector[vector[int]] fronts):
         j = fronts[k].size() - 1
 
         while j >= 0:
-            relation = c_get_relation(F, i, fronts[k][j])
-            if relation == -1:
+            if relation(&F[i, 0], &F[fronts[k][j], 0], F.shape[1], 0.0) == -1:
                 non_dominated = False
                 break
             j = j - 1
@@ -479,13 +662,13 @@ cdef int sequential_search(double[:,:] F, int i, vector[vector[int]] fronts):
                 return n_fronts
 
 
-cdef int binary_search(double[:,:] F, int i, vector[vector[int]] fronts):
+cdef int binary_search(double[:, ::1] F, int i, vector[vector[int]]& fronts, int n_fronts,
+                       DominanceRelationKernel relation):
 
     cdef:
-        int n_fronts, k, k_min, k_max, j
+        int k, k_min, k_max, j
         bool non_dominated
 
-    n_fronts = fronts.size()
     if n_fronts == 0:
         return 0
 
@@ -501,8 +684,7 @@ cdef int binary_search(double[:,:] F, int i, vector[vector[int]] fronts):
         j = fronts[k-1].size() - 1
 
         while j >= 0:
-            relation = c_get_relation(F, i, fronts[k-1][j])
-            if relation == -1:
+            if relation(&F[i, 0], &F[fronts[k-1][j], 0], F.shape[1], 0.0) == -1:
                 non_dominated = False
                 break
             j = j - 1
@@ -535,44 +717,9 @@ cdef int binary_search(double[:,:] F, int i, vector[vector[int]] fronts):
 
 
 cdef int c_get_relation(double[:,:] F, int a, int b, double epsilon = 0.0):
-
-    cdef int size = F.shape[1]
-    cdef int val
-    cdef int i
-
-    val = 0
-
-    for i in range(size):
-
-        if F[a,i] + epsilon < F[b,i]:
-            # indifferent because once better and once worse
-            if val == -1:
-                return 0
-            val = 1
-
-        elif F[a,i] > F[b,i] + epsilon:
-
-            # indifferent because once better and once worse
-            if val == 1:
-                return 0
-            val = -1
-
-    return val
-
-cdef bool c_is_dominating_or_equal(double[:,:] F, int a, int b, vector[vector[int]]& C, int k):
-    cdef unsigned int i, j
-    for i in range(k, C[0].size()):
-        j = C[b][i]
-        if F[b, j] < F[a, j]:
-            return False
-    return True
-
-cdef bool c_is_equal(double[:,:] F, int a, int b):
-    cdef int i, n_obj = F.shape[1]
-    for i in range(n_obj):
-        if F[a, i] != F[b, i]:
-            return False
-    return True
+    cdef double[::1] fa = np.ascontiguousarray(F[a])
+    cdef double[::1] fb = np.ascontiguousarray(F[b])
+    return dominance_relation_kernel(F.shape[1])(&fa[0], &fb[0], F.shape[1], epsilon)
 
 cdef vector[vector[int]] c_construct_domination_matrix(double[:, :]& F):
     cdef:
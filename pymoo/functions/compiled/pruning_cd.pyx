@@ -3,7 +3,8 @@
 
 import numpy as np
 
-from pymoo.functions.compiled.utils cimport c_get_drop, c_get_argmin, c_get_argmax, c_normalize_array
+from pymoo.functions.compiled.utils cimport drop_heap, c_push_drop, c_pop_drop, c_get_argmin, c_get_argmax, c_normalize_array
+from pymoo.functions.compiled.workspace cimport c_scratch_matrix
 
 from libcpp cimport bool
 from libcpp.vector cimport vector
@@ -15,7 +16,7 @@ cdef extern from "math.h":
 
 
 # Python definition
-def calc_pcd(double[:, :] X, int n_remove=0):
+def calc_pcd(double[:, :] X, int n_remove=0, workspace=None):
 
     cdef:
         int N, M, n
@@ -50,39 +51,41 @@ def calc_pcd(double[:, :] X, int n_remove=0):
 
     X = c_normalize_array(X, extremes_max, extremes_min)
 
-    return c_calc_pcd(X, I, n_remove, N, M, extremes)
+    return c_calc_pcd(X, I, n_remove, N, M, extremes, workspace)
 
 
 # Returns crowding metrics with recursive elimination
-cdef c_calc_pcd(double[:, :] X, int[:, :] I, int n_remove, int N, int M, cpp_set[int] extremes):
+cdef c_calc_pcd(double[:, :] X, int[:, :] I, int n_remove, int N, int M, cpp_set[int] extremes, workspace):
 
     cdef:
         int n, n_removed, k
-        cpp_set[int] calc_items
-        cpp_set[int] H
+        vector[int] calc_items
+        vector[bool] H, skip
+        drop_heap heap
         double[:, :] D
         double[:] d
 
+    # Items that are never recalculated
+    skip = vector[bool](N, False)
+    for n in extremes:
+        skip[n] = True
+
     # Define items to calculate distances
-    calc_items = cpp_set[int]()
+    calc_items = vector[int]()
     for n in range(N):
-        calc_items.insert(n)
-    for n in extremes:
-        calc_items.erase(n)
+        if not skip[n]:
+            calc_items.push_back(n)
 
     # Define remaining items to evaluate
-    H = cpp_set[int]()
-    for n in range(N):
-        H.insert(n)
+    H = vector[bool](N, True)
 
     # Initialize
     n_removed = 0
 
-    # Initialize neighbors and distances
-    _D = np.full((N, M), HUGE_VAL, dtype=np.double)
+    # Initialize neighbors and distances (D is scratch and comes from the workspace arena if given)
+    D = c_scratch_matrix(workspace, N, M, HUGE_VAL)
     dd = np.full((N,), HUGE_VAL, dtype=np.double)
 
-    D = _D[:, :]
     d = dd[:]
 
     # Fill in neighbors and distance matrix
@@ -97,20 +100,20 @@ cdef c_calc_pcd(double[:, :] X, int[:, :] I, int n_remove, int N, int M, cpp_set
     # Obtain distance metrics
     c_calc_d(d, D, calc_items, M)
 
+    for n in range(N):
+        c_push_drop(heap, d, n)
+
     # While n_remove not acheived
     while n_removed < (n_remove - 1):
 
-        # Obtain element to drop
-        k = c_get_drop(d, H)
-        H.erase(k)
+        # Obtain element to drop (and remove it from H)
+        k = c_pop_drop(heap, d, H)
 
         # Update index
         n_removed = n_removed + 1
 
         # Get items to be recalculated
-        calc_items = c_get_calc_items(I, k, M, N)
-        for n in extremes:
-            calc_items.erase(n)
+        calc_items = c_get_calc_items(I, skip, k, M, N)
 
         # Fill in neighbors and distance matrix
         c_calc_pcd_iter(
@@ -124,6 +127,9 @@ cdef c_calc_pcd(double[:, :] X, int[:, :] I, int n_remove, int N, int M, cpp_set
         # Obtain distance metrics
         c_calc_d(d, D, calc_items, M)
 
+        for n in calc_items:
+            c_push_drop(heap, d, n)
+
     return dd
 
 
@@ -133,7 +139,7 @@ cdef c_calc_pcd_iter(
     int[:, :] I,
     double[:, :] D,
     int N, int M,
-    cpp_set[int] calc_items,
+    vector[int]& calc_items,
     ):
 
     cdef:
@@ -156,7 +162,7 @@ cdef c_calc_pcd_iter(
 
 
 # Calculate crowding metric
-cdef c_calc_d(double[:] d, double[:, :] D, cpp_set[int] calc_items, int M):
+cdef c_calc_d(double[:] d, double[:, :] D, vector[int]& calc_items, int M):
 
     cdef:
         int i, m
@@ -168,17 +174,19 @@ cdef c_calc_d(double[:] d, double[:, :] D, cpp_set[int] calc_items, int M):
             d[i] = d[i] + D[i, m]
 
 
-# Returns indexes of items to be recalculated after removal
-cdef cpp_set[int] c_get_calc_items(
+# Returns indexes of items to be recalculated after removal, each once and without the ones in skip
+cdef vector[int] c_get_calc_items(
     int[:, :] I,
+    vector[bool]& skip,
     int k, int M, int N
     ):
 
     cdef:
-        int n, m
-        cpp_set[int] calc_items
+        int n, m, i, j
+        vector[int] calc_items
+        int[2] neighbors
 
-    calc_items = cpp_set[int]()
+    calc_items = vector[int]()
 
     # Iterate over all elements in I
     for m in range(M):
@@ -188,10 +196,19 @@ cdef cpp_set[int] c_get_calc_items(
             if I[n, m] == k:
 
                 # Add to set of items to be recalculated
-                calc_items.insert(I[n - 1, m])
-                calc_items.insert(I[n + 1, m])
+                neighbors[0] = I[n - 1, m]
+                neighbors[1] = I[n + 1, m]
+                for j in range(2):
+                    i = neighbors[j]
+                    if not skip[i]:
+                        skip[i] = True
+                        calc_items.push_back(i)
 
                 # Remove element from sorted array
                 I[n:-1, m] = I[n + 1:, m]
 
+    # skip doubles as the deduplication mask, reset it to the extremes
+    for i in calc_items:
+        skip[i] = False
+
     return calc_items
@@ -3,50 +3,50 @@
 
 import numpy as np
 
-from pymoo.util import default_random_state
-
-
-@default_random_state
-def stochastic_ranking(double[:] f, double[:] phi, double pr, long[:] I=None, random_state=None):
-    if I is None:
-        I = np.arange(len(f))
-    return np.array(c_stochastic_ranking(f, phi, pr, I, random_state))
+from libc.stdint cimport int64_t, uint64_t
 
+from pymoo.util import default_random_state
 
 
-def c_stochastic_ranking(double[:] f, double[:] phi, double pr, long[:] I, random_state):
-    cdef int _lambda, i, j, at_least_one_swap
-    cdef double u
-
-    _lambda = len(f)
-
-    for i in range(_lambda):
+cdef extern from "stochastic_ranking.h":
+    void c_native_stochastic_ranking_batch "stochastic_ranking_batch"(
+        const double *f, const double *phi, size_t n_rankings, size_t n, double pr, uint64_t seed, int64_t *order,
+        size_t n_threads) nogil
 
-        at_least_one_swap = 0
 
-        uu = random_state.random(size=_lambda)
+@default_random_state
+def stochastic_ranking(f, phi, double pr, I=None, random_state=None, int n_threads=0):
+    """
+    Stochastic ranking of f (objective) and phi (constraint violation) starting from the ranking I.
+    Two-dimensional f and phi hold one population per row (e.g. one per island); the rows are ranked
+    independently on n_threads threads (0 = all cores) and a ranking is returned per row.
+    """
+    f, phi = np.ascontiguousarray(f, dtype=np.float64), np.ascontiguousarray(phi, dtype=np.float64)
+    if f.shape != phi.shape or f.ndim not in [1, 2]:
+        raise ValueError("f and phi must be vectors or matrices of the same shape")
 
-        for j in range(_lambda - 1):
-            u = uu[j]
+    if I is None:
+        I = np.broadcast_to(np.arange(f.shape[-1]), f.shape)
+    I = np.array(I, dtype=np.int64)
+    if I.shape != f.shape:
+        raise ValueError("I must have the same shape as f")
 
-            if u < pr or (phi[I[j]] == 0 and phi[I[j + 1]] == 0):
-                if f[I[j]] > f[I[j + 1]]:
-                    c_swap(I, j, j + 1)
-                    at_least_one_swap = 1
-            else:
-                if phi[I[j]] > phi[I[j + 1]]:
-                    c_swap(I, j, j + 1)
-                    at_least_one_swap = 1
+    # the coins are drawn inside the kernel from a Philox stream seeded by the caller's random state
+    seed = random_state.integers(np.iinfo(np.int64).max)
 
-        if at_least_one_swap == 0:
-            break
+    if f.ndim == 1:
+        c_stochastic_ranking(f[None, :], phi[None, :], pr, I[None, :], seed, n_threads)
+    else:
+        c_stochastic_ranking(f, phi, pr, I, seed, n_threads)
 
     return I
 
 
-cdef c_swap(long[:] x, int a, int b):
-    cdef int tmp
-    tmp = x[a]
-    x[a] = x[b]
-    x[b] = tmp
+cdef c_stochastic_ranking(double[:, ::1] f, double[:, ::1] phi, double pr, int64_t[:, ::1] I, uint64_t seed,
+                          int n_threads):
+    if f.shape[0] == 0 or f.shape[1] == 0:
+        return
 
+    with nogil:
+        c_native_stochastic_ranking_batch(&f[0, 0], &phi[0, 0], f.shape[0], f.shape[1], pr, seed, &I[0, 0],
+                                          max(n_threads, 0))
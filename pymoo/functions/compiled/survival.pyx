@@ -0,0 +1,72 @@
+# distutils: language = c++
+# cython: language_level=2, boundscheck=False, wraparound=False, cdivision=True
+
+import numpy as np
+
+from libcpp cimport bool
+from libcpp.string cimport string
+
+from pymoo.functions.compiled.workspace cimport SurvivalWorkspace, Workspace
+
+
+cdef extern from "survival.h":
+    cdef enum class Diversity:
+        crowding_distance
+        pruning_crowding_distance
+
+    Diversity c_parse_diversity "parse_diversity"(const string& name) except +
+
+    size_t c_native_survive "survive"(const double *F, size_t n, size_t n_obj, size_t n_survive, Diversity diversity,
+                                      const size_t *tie_keys, SurvivalWorkspace& workspace, size_t *survivors,
+                                      size_t *rank, double *crowding, size_t n_threads, bool truncate) nogil except +
+
+
+# ---------------------------------------------------------------------------------------------------------
+# Interface
+# ---------------------------------------------------------------------------------------------------------
+
+
+def survive(F, int n_survive, diversity="cd", tie_keys=None, int n_threads=0, workspace=None, bool truncate=True):
+    """
+    NSGA-II survival in one native pass (Eddie/survival.h): ranks F up to the split front, computes the
+    diversity metric ('cd' or 'pcd') of every surviving front and truncates the split front by it. Ties are
+    broken by the smaller tie key (the index without keys). Returns the survivors, their ranks and crowding.
+    With truncate=False the split front is returned whole, after the other fronts, for the caller to truncate.
+    """
+
+    cdef:
+        double[:, ::1] _F = np.ascontiguousarray(F, dtype=np.double)
+        size_t[::1] _keys, _survivors, _rank
+        double[::1] _crowding
+        const size_t *keys = NULL
+        Diversity c_diversity
+        SurvivalWorkspace local
+        SurvivalWorkspace *buffers = &local
+        size_t n_written
+
+    c_diversity = c_parse_diversity(diversity.encode("utf-8"))
+    n = _F.shape[0]
+    n_survive = max(min(n_survive, n), 0)
+
+    n_out = n_survive if truncate else n
+    survivors = np.zeros(n_out, dtype=np.uintp)
+    rank = np.zeros(n_out, dtype=np.uintp)
+    crowding = np.zeros(n_out, dtype=np.double)
+    if n_survive == 0:
+        return survivors[:0].astype(int), rank[:0].astype(int), crowding[:0]
+
+    if tie_keys is not None:
+        _keys = np.ascontiguousarray(tie_keys, dtype=np.uintp)
+        if _keys.shape[0] != n:
+            raise ValueError("tie_keys requires one key per row of F")
+        keys = &_keys[0]
+
+    if isinstance(workspace, Workspace):
+        buffers = &(<Workspace> workspace).c_workspace.survival
+
+    _survivors, _rank, _crowding = survivors, rank, crowding
+    with nogil:
+        n_written = c_native_survive(&_F[0, 0], _F.shape[0], _F.shape[1], n_survive, c_diversity, keys, buffers[0],
+                                     &_survivors[0], &_rank[0], &_crowding[0], max(n_threads, 0), truncate)
+
+    return survivors[:n_written].astype(int), rank[:n_written].astype(int), crowding[:n_written]
@@ -4,89 +4,83 @@
 import numpy as np
 
 from libcpp cimport bool
+from libcpp.pair cimport pair
+from libcpp.queue cimport priority_queue
 from libcpp.vector cimport vector
-from libcpp.set cimport set as cpp_set
 
 
 cdef extern from "math.h":
     double HUGE_VAL
 
 
-# Returns elements to remove based on crowding metric d and heap of remaining elements H
-cdef inline int c_get_drop(double[:] d, cpp_set[int] H):
+# Lazy-deletion heap over the crowding metric d. The top is the smallest d, ties going to the
+# largest index. Items are pushed again whenever d[i] changes, and stale entries (removed items or
+# outdated values) are skipped when popping, so each drop costs O(log N) instead of a full scan.
+ctypedef priority_queue[pair[double, int]] drop_heap
 
-    cdef:
-        int i, min_i
-        double min_d
-
-    min_d = HUGE_VAL
-    min_i = 0
-
-    for i in H:
 
-        if d[i] <= min_d:
-            min_d = d[i]
-            min_i = i
+cdef inline void c_push_drop(drop_heap& heap, double[:] d, int i):
+    heap.push(pair[double, int](-d[i], i))
 
-    return min_i
 
-
-# Returns vector of positions of minimum values along axis 0 of a 2d memoryview
-cdef inline vector[int] c_get_argmin(double[:, :] X):
+# Returns the element to remove among the remaining ones (H[i] is True) and marks it removed
+cdef inline int c_pop_drop(drop_heap& heap, double[:] d, vector[bool]& H):
 
     cdef:
-        int N, M, min_i, n, m
-        double min_val
-        vector[int] indexes
+        int i
+        double key
 
-    N = X.shape[0]
-    M = X.shape[1]
+    while not heap.empty():
 
-    indexes = vector[int]()
+        key = -heap.top().first
+        i = heap.top().second
+        heap.pop()
 
-    for m in range(M):
+        # NaN never equals itself, accept it as is rather than skipping it forever
+        if H[i] and (key == d[i] or d[i] != d[i]):
+            H[i] = False
+            return i
 
-        min_i = 0
-        min_val = X[0, m]
+    return -1
 
-        for n in range(N):
 
-            if X[n, m] < min_val:
+cdef extern from "normalization.h":
+    void column_argmin(const double *X, size_t n, size_t m, Py_ssize_t row_stride, Py_ssize_t col_stride,
+                       int *argmin) nogil
+    void column_argmax(const double *X, size_t n, size_t m, Py_ssize_t row_stride, Py_ssize_t col_stride,
+                       int *argmax) nogil
+    void normalize_columns(double *X, size_t n, size_t m, Py_ssize_t row_stride, Py_ssize_t col_stride,
+                           const int *argmin, const int *argmax) nogil
+    void row_norms(const double *X, size_t n, size_t m, Py_ssize_t row_stride, Py_ssize_t col_stride,
+                   double *out) nogil
 
-                min_i = n
-                min_val = X[n, m]
 
-        indexes.push_back(min_i)
+# The helpers below only adapt memoryviews to Eddie/normalization.h, which is compiled once into the
+# eddie_core library every extension links against. Strides are passed in elements.
 
-    return indexes
-
-
-# Returns vector of positions of maximum values along axis 0 of a 2d memoryview
-cdef inline vector[int] c_get_argmax(double[:, :] X):
+# Stride of a 2d memoryview along axis, in elements
+cdef inline Py_ssize_t c_stride(double[:, :] X, int axis):
+    return X.strides[axis] // <Py_ssize_t> sizeof(double)
 
-    cdef:
-        int N, M, max_i, n, m
-        double max_val
-        vector[int] indexes
 
-    N = X.shape[0]
-    M = X.shape[1]
+# Returns vector of positions of minimum values along axis 0 of a 2d memoryview
+cdef inline vector[int] c_get_argmin(double[:, :] X):
 
-    indexes = vector[int]()
+    cdef vector[int] indexes = vector[int](X.shape[1])
 
-    for m in range(M):
+    if X.shape[0] > 0 and X.shape[1] > 0:
+        column_argmin(&X[0, 0], X.shape[0], X.shape[1], c_stride(X, 0), c_stride(X, 1), indexes.data())
 
-        max_i = 0
-        max_val = X[0, m]
+    return indexes
 
-        for n in range(N):
 
-            if X[n, m] > max_val:
+# Returns vector of positions of maximum values along axis 0 of a 2d memoryview
+cdef inline vector[int] c_get_argmax(double[:, :] X):
 
-                max_i = n
-                max_val = X[n, m]
+    cdef vector[int] indexes = vector[int](X.shape[1])
 
-        indexes.push_back(max_i)
+    if X.shape[0] > 0 and X.shape[1] > 0:
+        column_argmax(&X[0, 0], X.shape[0], X.shape[1], c_stride(X, 0), c_stride(X, 1), indexes.data())
 
     return indexes
 
@@ -94,36 +88,19 @@ cdef inline vector[int] c_get_argmax(double[:, :] X):
 # Performs normalization of a 2d memoryview
 cdef inline double[:, :] c_normalize_array(double[:, :] X, vector[int] extremes_max, vector[int] extremes_min):
 
-    cdef:
-        int N = X.shape[0]
-        int M = X.shape[1]
-        int n, m, l, u
-        double l_val, u_val, diff_val
-        vector[double] min_vals, max_vals
-
-    min_vals = vector[double]()
-    max_vals = vector[double]()
-
-    m = 0
-    for u in extremes_max:
-        u_val = X[u, m]
-        max_vals.push_back(u_val)
-        m = m + 1
+    if X.shape[0] > 0 and X.shape[1] > 0:
+        normalize_columns(&X[0, 0], X.shape[0], X.shape[1], c_stride(X, 0), c_stride(X, 1),
+                          extremes_min.data(), extremes_max.data())
 
-    m = 0
-    for l in extremes_min:
-        l_val = X[l, m]
-        min_vals.push_back(l_val)
-        m = m + 1
+    return X
 
-    for m in range(M):
 
-        diff_val = max_vals[m] - min_vals[m]
-        if diff_val == 0.0:
-            diff_val = 1.0
+# Euclidean norm of every row of a 2d memoryview
+cdef inline vector[double] c_row_norms(double[:, :] X):
 
-        for n in range(N):
+    cdef vector[double] norms = vector[double](X.shape[0])
 
-            X[n, m] = (X[n, m] - min_vals[m]) / diff_val
+    if X.shape[0] > 0 and X.shape[1] > 0:
+        row_norms(&X[0, 0], X.shape[0], X.shape[1], c_stride(X, 0), c_stride(X, 1), norms.data())
 
-    return X
+    return norms
@@ -0,0 +1,74 @@
+# distutils: language = c++
+# cython: language_level=2, boundscheck=False, wraparound=False, cdivision=True
+
+import numpy as np
+
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+
+cdef extern from "arena.h":
+    cdef cppclass Arena:
+        T* allocate[T](size_t n) except +
+        void reset()
+        size_t bytes_used()
+        size_t capacity()
+        size_t n_blocks()
+
+cdef extern from "fronts.h":
+    cdef cppclass FrontSet:
+        vector[size_t] members
+        vector[size_t] offsets
+        vector[size_t] rank
+        size_t size()
+
+cdef extern from "ranking.h":
+    cdef cppclass FastSortWorkspace:
+        pass
+    cdef cppclass DominanceDegreeWorkspace:
+        pass
+
+cdef extern from "decomposition.h":
+    cdef cppclass DecompositionKernel:
+        DecompositionKernel()
+        DecompositionKernel(const string& kind, const double *weights, size_t n_weights, size_t n_obj,
+                            double theta, double weight_0) except +
+        void assign(const string& kind, const double *weights, size_t n_weights, size_t n_obj,
+                    double theta, double weight_0) except +
+        void cross(const double *F, size_t n_points, const double *utopian, double *out, size_t n_threads) nogil
+        void paired(const double *F, const double *utopian, double *out) nogil
+
+cdef extern from "survival.h":
+    cdef cppclass SurvivalWorkspace:
+        void reserve(size_t n_points, size_t n_obj) except +
+
+cdef extern from "workspace.h":
+    cdef cppclass KernelWorkspace:
+        Arena arena
+        FrontSet fronts
+        FastSortWorkspace sort
+        DominanceDegreeWorkspace degree
+        DecompositionKernel decomposition
+        SurvivalWorkspace survival
+        void reset()
+
+
+cdef class Workspace:
+    cdef KernelWorkspace* c_workspace
+
+
+# Scratch rows x cols matrix filled with value. With a workspace it is carved out of the arena and
+# only valid until the workspace is reset; otherwise (or if empty) it is a fresh numpy array.
+cdef inline double[:, ::1] c_scratch_matrix(workspace, Py_ssize_t rows, Py_ssize_t cols, double value):
+
+    cdef:
+        double *data
+        Py_ssize_t i
+
+    if isinstance(workspace, Workspace) and rows > 0 and cols > 0:
+        data = (<Workspace> workspace).c_workspace.arena.allocate[double](rows * cols)
+        for i in range(rows * cols):
+            data[i] = value
+        return <double[:rows, :cols]> data
+
+    return np.full((rows, cols), value, dtype=np.double)
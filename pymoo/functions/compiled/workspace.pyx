@@ -0,0 +1,30 @@
+# distutils: language = c++
+# cython: language_level=2, boundscheck=False, wraparound=False, cdivision=True
+
+
+cdef class Workspace:
+    """
+    Scratch memory kept across calls of the compiled sorting, crowding and decomposition kernels
+    (Eddie/workspace.h). Pass it as `workspace=` to reuse buffers between calls and call `reset()`
+    at the end of every generation, which releases the arena and keeps the memory for the next one.
+    """
+
+    def __cinit__(self):
+        self.c_workspace = new KernelWorkspace()
+
+    def __dealloc__(self):
+        del self.c_workspace
+
+    def reset(self):
+        self.c_workspace.reset()
+
+    @property
+    def nbytes(self):
+        return self.c_workspace.arena.capacity()
+
+    # the buffers are scratch and never part of the state, so copies start out empty
+    def __reduce__(self):
+        return Workspace, ()
+
+    def __deepcopy__(self, memo):
+        return Workspace()
@@ -0,0 +1,39 @@
+# Optional CUDA backend, compiled at run time through CuPy (NVRTC), so it needs no toolchain at install time.
+# Every function here has the signature of its compiled counterpart and falls back to it (or to the Python
+# version) when the backend is disabled, CuPy or a device is missing or the input is below
+# Config.gpu["min_points"]. CUDA is not initialized before an input reaches min_points.
+
+import importlib.util
+
+from pymoo.config import Config
+
+_available = None
+
+
+def is_installed():
+    """True if CuPy can be found; neither imports it nor touches the driver."""
+    return importlib.util.find_spec("cupy") is not None
+
+
+def is_available():
+    """True if CuPy can be imported and sees at least one CUDA device (checked once, initializes CUDA)."""
+    global _available
+    if _available is None:
+        try:
+            import cupy
+            _available = cupy.cuda.runtime.getDeviceCount() > 0
+        except Exception:
+            _available = False
+    return _available
+
+
+def use_device(n_points):
+    # the size test comes first so that small inputs never probe the device
+    return Config.gpu["enabled"] and n_points >= Config.gpu["min_points"] and is_available()
+
+
+def cpu_function(func_name):
+    """The compiled implementation of `func_name` if available, otherwise the Python one."""
+    from pymoo.functions import FunctionLoader
+    loader = FunctionLoader.get_instance()
+    return loader.load(func_name, mode="cython" if loader.is_compiled else "python")
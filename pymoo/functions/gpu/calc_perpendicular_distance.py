@@ -0,0 +1,49 @@
+"""
+GPU implementation of the perpendicular distance of points to reference lines.
+"""
+
+import numpy as np
+
+from pymoo.functions.gpu import use_device, cpu_function
+from pymoo.functions.gpu.kernels import chunk_rows, launch_perpendicular
+
+
+def calc_perpendicular_distance(P, L, out=None, n_threads=0):
+    """
+    Perpendicular distance of every point in P to every line through the origin spanned by a row of L,
+    as an (n_points, n_lines) matrix. L stays on the device while the points stream through it in chunks,
+    and each chunk's rows of the result are copied back into `out`. `n_threads` is only used by the
+    CPU fallback.
+    """
+    P, L = np.asarray(P, dtype=np.float64), np.asarray(L, dtype=np.float64)
+
+    if P.shape[1] != L.shape[1]:
+        raise ValueError("Points and lines must have the same number of dimensions")
+
+    if out is not None and out.shape != (P.shape[0], L.shape[0]):
+        raise ValueError("Output must have shape (%d, %d)" % (P.shape[0], L.shape[0]))
+
+    if not use_device(P.shape[0]) or L.shape[0] == 0:
+        return cpu_function("calc_perpendicular_distance")(P, L, out=out, n_threads=n_threads)
+
+    import cupy
+
+    if out is None:
+        out = np.zeros((P.shape[0], L.shape[0]), dtype=np.float64)
+
+    n_points, n_dim = P.shape
+    n_lines = L.shape[0]
+
+    L_device = cupy.asarray(np.ascontiguousarray(L))
+    norm = cupy.sqrt(cupy.sum(L_device * L_device, axis=1))
+
+    rows = chunk_rows(n_points, (n_dim + n_lines) * 8, resident_bytes=L.nbytes + n_lines * 8)
+    D = cupy.empty((rows, n_lines), dtype=cupy.float64)
+
+    for start in range(0, n_points, rows):
+        P_device = cupy.asarray(np.ascontiguousarray(P[start:start + rows]))
+        count = P_device.shape[0]
+        launch_perpendicular(P_device, L_device, norm, D[:count])
+        out[start:start + count] = cupy.asnumpy(D[:count])
+
+    return out
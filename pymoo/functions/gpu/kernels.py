@@ -0,0 +1,200 @@
+"""
+CUDA kernels of the GPU backend and the helpers that size and launch them.
+
+The pairwise kernels assign one thread to one query row and stage the candidate rows through shared
+memory a block at a time, so the candidates may live in a separate chunk: callers stream F to the device
+in chunks of `chunk_rows()` rows when it does not fit at once. The arithmetic follows the CPU kernels
+(dominance_relation of Eddie/dominance.h, the squared distances of calc_mnn and the direct residual of
+Eddie/perpendicular_distance.h) with FMA contraction disabled, so dominance is exact and the distances
+agree with the CPU to rounding.
+"""
+
+import numpy as np
+
+from pymoo.config import Config
+
+_SOURCE = r"""
+extern "C" {
+
+// 1 if a dominates b, -1 if b dominates a, 0 otherwise (minimization)
+__device__ int relation(const double *a, const double *b, int m, double epsilon) {
+    int val = 0;
+    for (int k = 0; k < m; ++k) {
+        if (a[k] + epsilon < b[k]) {
+            if (val == -1) return 0;
+            val = 1;
+        } else if (a[k] > b[k] + epsilon) {
+            if (val == 1) return 0;
+            val = -1;
+        }
+    }
+    return val;
+}
+
+// Copies candidate rows [start, start + count) of C into the shared tile.
+__device__ void stage(const double *C, long long start, long long count, int m, double *tile) {
+    for (long long e = threadIdx.x; e < count * m; e += blockDim.x) {
+        tile[e] = C[start * m + e];
+    }
+}
+
+// dominated[i] becomes true if a row of C dominates row i of Q. A block stops once all its
+// queries are dominated.
+__global__ void dominated_by(const double *Q, long long n_q, const double *C, long long n_c, int m,
+                             double epsilon, bool *dominated) {
+    extern __shared__ double tile[];
+    const long long i = (long long) blockIdx.x * blockDim.x + threadIdx.x;
+    bool done = i >= n_q || dominated[i];
+    const double *q = Q + (i < n_q ? i : 0) * m;
+
+    for (long long start = 0; start < n_c; start += blockDim.x) {
+        if (__syncthreads_and(done)) break;
+        const long long count = min((long long) blockDim.x, n_c - start);
+        stage(C, start, count, m, tile);
+        __syncthreads();
+        for (long long c = 0; c < count && !done; ++c) {
+            done = relation(tile + c * m, q, m, epsilon) == 1;
+        }
+    }
+    if (i < n_q && done) dominated[i] = true;
+}
+
+#define MAX_NEIGHBORS 32
+
+// Merges the alive rows of C (global indices offset, offset + 1, ...) other than the query itself
+// into the k nearest neighbors of every query row of Q (global index ids[i]) by squared distance,
+// kept in ascending order in dist / index (n_q x k rows, +inf / -1 while unset).
+__global__ void nearest(const double *Q, const long long *ids, long long n_q, const double *C, long long offset,
+                        long long n_c, const bool *alive, int m, int k, double *dist, long long *index) {
+    extern __shared__ double tile[];
+    const long long i = (long long) blockIdx.x * blockDim.x + threadIdx.x;
+    const bool active = i < n_q;
+    const double *q = Q + (active ? i : 0) * m;
+    const long long self = active ? ids[i] : -1;
+
+    double best[MAX_NEIGHBORS];
+    long long who[MAX_NEIGHBORS];
+    for (int r = 0; r < k; ++r) {
+        best[r] = active ? dist[i * k + r] : 0.0;
+        who[r] = active ? index[i * k + r] : -1;
+    }
+
+    for (long long start = 0; start < n_c; start += blockDim.x) {
+        const long long count = min((long long) blockDim.x, n_c - start);
+        __syncthreads();
+        stage(C, start, count, m, tile);
+        __syncthreads();
+        if (!active) continue;
+        for (long long c = 0; c < count; ++c) {
+            const long long j = offset + start + c;
+            if (j == self || !alive[j]) continue;
+            double d = 0.0;
+            for (int e = 0; e < m; ++e) {
+                const double diff = tile[c * m + e] - q[e];
+                d = d + diff * diff;
+            }
+            if (d >= best[k - 1]) continue;
+            int r = k - 1;
+            while (r > 0 && best[r - 1] > d) {
+                best[r] = best[r - 1];
+                who[r] = who[r - 1];
+                --r;
+            }
+            best[r] = d;
+            who[r] = j;
+        }
+    }
+
+    if (active) {
+        for (int r = 0; r < k; ++r) {
+            dist[i * k + r] = best[r];
+            index[i * k + r] = who[r];
+        }
+    }
+}
+
+// out[i, j] = distance of row i of P to the line through the origin spanned by row j of L, with
+// norm[j] = |L[j]|.
+__global__ void perpendicular(const double *P, long long n_p, const double *L, const double *norm, long long n_l,
+                              int m, double *out) {
+    const long long t = (long long) blockIdx.x * blockDim.x + threadIdx.x;
+    if (t >= n_p * n_l) return;
+    const long long i = t / n_l, j = t % n_l;
+    const double *p = P + i * m;
+    const double *l = L + j * m;
+    double dot = 0.0;
+    for (int e = 0; e < m; ++e) {
+        dot = dot + p[e] * l[e];
+    }
+    const double s = dot / norm[j];
+    double d2 = 0.0;
+    for (int e = 0; e < m; ++e) {
+        const double diff = s * (l[e] / norm[j]) - p[e];
+        d2 = d2 + diff * diff;
+    }
+    out[i * n_l + j] = sqrt(d2);
+}
+
+}
+"""
+
+# neighbors a thread keeps in registers; calc_mnn with more objectives runs on the CPU
+MAX_NEIGHBORS = 32
+
+# threads per block and the largest shared tile a block may stage
+_THREADS = 128
+_SHARED_BYTES = 48 * 1024
+
+_module = None
+
+
+def kernel(name):
+    global _module
+    if _module is None:
+        import cupy
+        _module = cupy.RawModule(code=_SOURCE, options=("--fmad=false",))
+    return _module.get_function(name)
+
+
+def max_columns():
+    """The most objectives (columns) a shared tile of _THREADS rows holds."""
+    return _SHARED_BYTES // (8 * _THREADS)
+
+
+def chunk_rows(n_rows, row_bytes, resident_bytes=0):
+    """
+    Rows per chunk: Config.gpu["chunk_rows"] if set, otherwise as many as fit in the
+    Config.gpu["memory_fraction"] share of the free device memory after `resident_bytes`.
+    """
+    rows = Config.gpu["chunk_rows"]
+    if rows <= 0:
+        import cupy
+        free, _ = cupy.cuda.runtime.memGetInfo()
+        budget = int(free * Config.gpu["memory_fraction"]) - resident_bytes
+        rows = budget // max(row_bytes, 1)
+    return int(max(1, min(n_rows, rows)))
+
+
+def launch_dominated_by(Q, C, epsilon, dominated):
+    n_q, m = Q.shape
+    blocks = (n_q + _THREADS - 1) // _THREADS
+    kernel("dominated_by")((blocks,), (_THREADS,),
+                           (Q, np.int64(n_q), C, np.int64(C.shape[0]), np.int32(m), np.float64(epsilon), dominated),
+                           shared_mem=_THREADS * m * 8)
+
+
+def launch_nearest(Q, ids, C, offset, alive, k, dist, index):
+    n_q, m = Q.shape
+    blocks = (n_q + _THREADS - 1) // _THREADS
+    kernel("nearest")((blocks,), (_THREADS,),
+                      (Q, ids, np.int64(n_q), C, np.int64(offset), np.int64(C.shape[0]), alive, np.int32(m),
+                       np.int32(k), dist, index),
+                      shared_mem=_THREADS * m * 8)
+
+
+def launch_perpendicular(P, L, norm, out):
+    n_p, m = P.shape
+    n_l = L.shape[0]
+    blocks = (n_p * n_l + _THREADS - 1) // _THREADS
+    kernel("perpendicular")((blocks,), (_THREADS,),
+                            (P, np.int64(n_p), L, norm, np.int64(n_l), np.int32(m), out))
@@ -0,0 +1,139 @@
+"""
+GPU implementation of the M-nearest neighbor crowding metric (calc_mnn / calc_2nn).
+"""
+
+import heapq
+
+import numpy as np
+
+from pymoo.functions.gpu import use_device, cpu_function
+from pymoo.functions.gpu.kernels import MAX_NEIGHBORS, chunk_rows, launch_nearest, max_columns
+
+
+def calc_mnn(X, n_remove=0, method="auto", workspace=None):
+    """Same values as the compiled calc_mnn with the neighbor searches run on the device."""
+    return _calc_mnn_base("calc_mnn", X, n_remove, method, workspace)
+
+
+def calc_2nn(X, n_remove=0, method="auto", workspace=None):
+    """Same values as the compiled calc_2nn with the neighbor searches run on the device."""
+    return _calc_mnn_base("calc_2nn", X, n_remove, method, workspace)
+
+
+def _calc_mnn_base(func_name, X, n_remove, method, workspace):
+    """
+    Mirrors the k-d tree variant of the compiled version: every item's nearest neighbors come from a
+    brute-force search on the device and, while items are dropped, only the items that lost a neighbor
+    are searched again, all of them in one launch. method="kdtree" and small inputs run on the CPU; so does
+    `workspace`, which only the compiled version uses.
+    """
+    if method not in ("auto", "dense", "kdtree"):
+        raise ValueError("Unknown method '%s', use 'auto', 'dense' or 'kdtree'" % method)
+
+    X = np.asarray(X, dtype=np.float64)
+    N, M = X.shape
+    k = 2 if func_name == "calc_2nn" else M
+
+    if method == "kdtree" or N <= M or not use_device(N) or not 0 < M <= max_columns() or k > MAX_NEIGHBORS:
+        return cpu_function(func_name)(X, n_remove=n_remove, method=method, workspace=workspace)
+
+    import cupy
+
+    n_remove = min(max(n_remove, 0), N - M)
+
+    # the extremes of every objective keep an infinite distance and are never searched
+    extremes_min, extremes_max = np.argmin(X, axis=0), np.argmax(X, axis=0)
+    is_extreme = np.zeros(N, dtype=bool)
+    is_extreme[extremes_min] = True
+    is_extreme[extremes_max] = True
+
+    lower, upper = X[extremes_min, np.arange(M)], X[extremes_max, np.arange(M)]
+    diff = upper - lower
+    diff[diff == 0.0] = 1.0
+    X = np.ascontiguousarray((X - lower) / diff)
+
+    search = _NeighborSearch(X, k)
+    alive = cupy.ones(N, dtype=cupy.bool_)
+
+    d = np.full(N, np.inf)
+    neighbors = [()] * N
+    users = [[] for _ in range(N)]
+
+    def update(items):
+        dist, index = search.query(items, alive)
+        prod = np.ones(len(items))
+        for m in range(k):
+            prod *= dist[:, m]
+        d[items] = prod
+        for i, row in zip(items.tolist(), index.tolist()):
+            neighbors[i] = row
+            for j in row:
+                users[j].append(i)
+
+    update(np.flatnonzero(~is_extreme))
+
+    # drop the item with the smallest metric (the largest index among ties, as the compiled heap)
+    H = np.ones(N, dtype=bool)
+    heap = [(d[i], -i) for i in range(N)]
+    heapq.heapify(heap)
+
+    for _ in range(n_remove - 1):
+
+        while True:
+            key, i = heapq.heappop(heap)
+            i = -i
+            if H[i] and (key == d[i] or d[i] != d[i]):
+                break
+
+        H[i] = False
+        alive[i] = False
+
+        # the remaining items whose current neighbors include i, each once
+        stale = list(dict.fromkeys(u for u in users[i] if H[u] and i in neighbors[u]))
+        users[i] = []
+
+        if len(stale) > 0:
+            stale = np.array(stale)
+            update(stale)
+            for u in stale.tolist():
+                heapq.heappush(heap, (d[u], -u))
+
+    return d
+
+
+class _NeighborSearch:
+    """k nearest alive neighbors of given items; X stays on the device if it fits, otherwise it streams."""
+
+    def __init__(self, X, k):
+        import cupy
+
+        n, m = X.shape
+        self.X, self.k = X, k
+
+        # a query row and a candidate row plus the query's neighbors, its id and the alive flag
+        self.rows = chunk_rows(n, 2 * m * 8 + k * 16 + 9)
+        self.X_device = cupy.asarray(X) if self.rows >= n else None
+
+    def query(self, items, alive):
+        import cupy
+
+        n, k = self.X.shape[0], self.k
+        dist = np.empty((len(items), k))
+        index = np.empty((len(items), k), dtype=np.int64)
+
+        for q in range(0, len(items), self.rows):
+            ids = cupy.asarray(items[q:q + self.rows], dtype=cupy.int64)
+            _dist = cupy.full((len(ids), k), np.inf)
+            _index = cupy.full((len(ids), k), -1, dtype=cupy.int64)
+
+            if self.X_device is not None:
+                launch_nearest(self.X_device[ids], ids, self.X_device, 0, alive, k, _dist, _index)
+            else:
+                Q = cupy.asarray(self.X[items[q:q + self.rows]])
+                for c in range(0, n, self.rows):
+                    launch_nearest(Q, ids, cupy.asarray(self.X[c:c + self.rows]), c, alive, k, _dist, _index)
+
+            dist[q:q + len(ids)] = cupy.asnumpy(_dist)
+            index[q:q + len(ids)] = cupy.asnumpy(_index)
+
+        return dist, index
@@ -0,0 +1,95 @@
+"""
+GPU implementations of non-dominated filtering and sorting by tiled pairwise dominance.
+"""
+
+import numpy as np
+
+from pymoo.functions.gpu import use_device, cpu_function
+from pymoo.functions.gpu.kernels import chunk_rows, launch_dominated_by, max_columns
+
+
+def find_non_dominated(F, epsilon=0.0, n_threads=0):
+    """Indices of the non-dominated rows of F; `n_threads` is only used by the CPU fallback."""
+    F = np.asarray(F, dtype=np.float64)
+    if not _use_device(F, epsilon):
+        return cpu_function("find_non_dominated")(F, epsilon=epsilon, n_threads=n_threads)
+    return np.flatnonzero(~_dominated(np.ascontiguousarray(F), epsilon))
+
+
+def fast_non_dominated_sort(F, epsilon=0.0, n_stop_if_ranked=2 ** 31 - 1, n_fronts=2 ** 31 - 1, n_threads=0,
+                            workspace=None):
+    """
+    Fronts of F (members in ascending order) peeled on the device: every front is the non-dominated
+    filter of the rows left by the previous ones. Stops like the compiled sort once `n_stop_if_ranked`
+    rows are ranked or `n_fronts` fronts are found. `n_threads` and `workspace` are only used by the CPU
+    fallback.
+    """
+    F = np.asarray(F, dtype=np.float64)
+    if not _use_device(F, epsilon):
+        return cpu_function("fast_non_dominated_sort")(F, epsilon=epsilon, n_stop_if_ranked=n_stop_if_ranked,
+                                                       n_fronts=n_fronts, n_threads=n_threads, workspace=workspace)
+    import cupy
+
+    F = np.ascontiguousarray(F)
+    n, m = F.shape
+
+    # keep F on the device between fronts if it fits next to the working copy of the remaining rows
+    resident = chunk_rows(n, 2 * m * 8 + 1) >= n
+    F_device = cupy.asarray(F) if resident else None
+
+    fronts = []
+    remaining = np.arange(n)
+    n_ranked = 0
+
+    while remaining.size > 0 and n_ranked < n_stop_if_ranked and len(fronts) < n_fronts:
+        if resident:
+            dominated = _dominated_on_device(F_device[cupy.asarray(remaining)], epsilon)
+        else:
+            dominated = _dominated_streamed(np.ascontiguousarray(F[remaining]), epsilon)
+
+        front = remaining[~dominated]
+        fronts.append(front.tolist())
+        n_ranked += front.size
+        remaining = remaining[dominated]
+
+    return fronts
+
+
+# Two and three objectives without epsilon are faster on the CPU sweep of Eddie/ranking.h (O(n log n)).
+def _use_device(F, epsilon):
+    n, m = F.shape
+    return n > 0 and use_device(n) and 0 < m <= max_columns() and not (epsilon == 0.0 and m in (2, 3))
+
+
+def _dominated(F, epsilon):
+    import cupy
+
+    n, m = F.shape
+    if chunk_rows(n, m * 8 + 1) >= n:
+        return _dominated_on_device(cupy.asarray(F), epsilon)
+    return _dominated_streamed(F, epsilon)
+
+
+def _dominated_on_device(F, epsilon):
+    import cupy
+
+    dominated = cupy.zeros(F.shape[0], dtype=cupy.bool_)
+    launch_dominated_by(F, F, epsilon, dominated)
+    return cupy.asnumpy(dominated)
+
+
+# F does not fit: every chunk of queries is held on the device while all chunks of candidates stream past it.
+def _dominated_streamed(F, epsilon):
+    import cupy
+
+    n, m = F.shape
+    rows = chunk_rows(n, 2 * m * 8 + 1)
+    dominated = cupy.zeros(n, dtype=cupy.bool_)
+
+    for q in range(0, n, rows):
+        Q = cupy.asarray(F[q:q + rows])
+        for c in range(0, n, rows):
+            C = Q if c == q else cupy.asarray(F[c:c + rows])
+            launch_dominated_by(Q, C, epsilon, dominated[q:q + rows])
+
+    return cupy.asnumpy(dominated)
@@ -5,7 +5,7 @@ Standard Python implementation of perpendicular distance calculation.
 import numpy as np
 
 
-def calc_perpendicular_distance(N, ref_dirs):
+def calc_perpendicular_distance(N, ref_dirs, out=None, n_threads=0):
     """Calculate perpendicular distance from points to reference directions."""
     u = np.tile(ref_dirs, (len(N), 1))
     v = np.repeat(N, len(ref_dirs), axis=0)
@@ -17,4 +17,8 @@ def calc_perpendicular_distance(N, ref_dirs):
     val = np.linalg.norm(proj - v, axis=1)
     matrix = np.reshape(val, (len(N), len(ref_dirs)))
 
-    return matrix
\ No newline at end of file
+    if out is not None:
+        out[:] = matrix
+        return out
+
+    return matrix
@@ -15,4 +15,34 @@ def calc_distance_to_weights(F, weights, utopian_point=None):
     d1 = (F * weights).sum(axis=1) / norm
     d2 = np.linalg.norm(F - (d1[:, None] * weights / norm[:, None]), axis=1)
 
-    return d1, d2
\ No newline at end of file
+    return d1, d2
+
+def decompose(F, weights, kind, utopian_point=None, theta=5.0, weight_0=1e-10, cross=True, n_threads=0,
+              workspace=None):
+    """Scalarize F against every weight (cross) or against the weight of the same row."""
+    if kind not in ["pbi", "tchebycheff", "asf"]:
+        raise ValueError("Unknown scalarization: %s" % kind)
+    if F.shape[1] != weights.shape[1]:
+        raise ValueError("F and weights must have the same number of objectives")
+    if not cross and F.shape[0] != weights.shape[0]:
+        raise ValueError("Pairwise decomposition requires one weight per point")
+
+    if utopian_point is not None:
+        F = F - utopian_point
+
+    # broadcast points along the second and weights along the first axis
+    if cross:
+        F, weights = F[:, None, :], weights[None, :, :]
+
+    if kind == "pbi":
+        norm = np.linalg.norm(weights, axis=-1)
+        d1 = (F * weights).sum(axis=-1) / norm
+        d2 = np.linalg.norm(F - (d1[..., None] * weights / norm[..., None]), axis=-1)
+        return d1 + theta * d2
+
+    elif kind == "tchebycheff":
+        return (np.abs(F) * weights).max(axis=-1)
+
+    else:
+        weights = np.where(weights == 0, weight_0, weights)
+        return (F / weights).max(axis=-1)
@@ -1,5 +1,122 @@
+import numpy as np
 from moocore import hypervolume as _hypervolume
+from moocore import hv_contributions as _hv_contributions
+
+from pymoo.util import default_random_state
 
 
 def hv(ref_point, F):
     return _hypervolume(F, ref = ref_point)
+
+
+def hvc(ref_point, F, n_threads=0):
+    """Exclusive hypervolume contribution of every point."""
+    F = np.atleast_2d(np.asarray(F, dtype=float))
+    if len(F) == 0:
+        return np.zeros(0)
+    return np.asarray(_hv_contributions(F, ref=ref_point), dtype=float)
+
+
+@default_random_state
+def hv_approx(ref_point, F, n_samples=100000, random_state=None, n_threads=0):
+    """Monte-Carlo estimate of the hypervolume and its standard error."""
+    ref_point = np.asarray(ref_point, dtype=float)
+    F = np.atleast_2d(np.asarray(F, dtype=float))
+    F = F[np.all(F < ref_point, axis=1)]
+    if len(F) == 0:
+        return 0.0, 0.0
+
+    ideal = F.min(axis=0)
+    V = np.prod(ref_point - ideal)
+
+    S = random_state.uniform(low=ideal, high=ref_point, size=(n_samples, len(ref_point)))
+    dominated = np.zeros(n_samples, dtype=bool)
+    for f in F:
+        dominated |= np.all(f <= S, axis=1)
+
+    p = dominated.mean()
+    return V * p, V * np.sqrt(p * (1 - p) / n_samples)
+
+
+class HypervolumeArchive:
+    """
+    Hypervolume and exclusive contributions of a changing point set. Reference implementation of
+    the compiled version, recomputing both after every change.
+    """
+
+    def __init__(self, ref_point):
+        self.ref_point = np.asarray(ref_point, dtype=float).reshape(-1)
+        if len(self.ref_point) == 0:
+            raise ValueError("Hypervolume requires at least one objective")
+        self._F = {}
+        self._hvc = {}
+        self._free = []
+        self._next_id = 0
+        self.hv = 0.0
+
+    def __len__(self):
+        return len(self._F)
+
+    def __contains__(self, i):
+        return i in self._F
+
+    @property
+    def n_obj(self):
+        return len(self.ref_point)
+
+    def insert(self, f):
+        f = np.asarray(f, dtype=float).reshape(-1)
+        if f.shape != (self.n_obj,):
+            raise ValueError("Expected %d objective values" % self.n_obj)
+        if self._free:
+            i = self._free.pop()
+        else:
+            i, self._next_id = self._next_id, self._next_id + 1
+        self._F[i] = f
+        self._update()
+        return i
+
+    def insert_many(self, F, n_threads=0):
+        F = np.atleast_2d(np.asarray(F, dtype=float))
+        if F.shape[1] != self.n_obj:
+            raise ValueError("Expected %d objective values" % self.n_obj)
+        ids = []
+        for f in F:
+            if self._free:
+                i = self._free.pop()
+            else:
+                i, self._next_id = self._next_id, self._next_id + 1
+            self._F[i] = f
+            ids.append(i)
+        self._update()
+        return ids
+
+    def remove(self, i):
+        if i not in self._F:
+            raise IndexError("Point is not in the hypervolume archive")
+        del self._F[i]
+        self._free.append(i)
+        self._update()
+
+    def refresh(self, n_threads=0):
+        self._update()
+
+    def contribution(self, i):
+        if i not in self._hvc:
+            raise IndexError("Point is not in the hypervolume archive")
+        return self._hvc[i]
+
+    def contributions(self, ids):
+        return np.array([self.contribution(i) for i in ids], dtype=float)
+
+    def _update(self):
+        ids = list(self._F.keys())
+        F = np.array([self._F[i] for i in ids]).reshape(-1, self.n_obj)
+        inside = np.all(F < self.ref_point, axis=1)
+
+        self.hv = hv(self.ref_point, F[inside]) if inside.any() else 0.0
+
+        contributions = np.zeros(len(ids))
+        if inside.any():
+            contributions[inside] = hvc(self.ref_point, F[inside])
+        self._hvc = dict(zip(ids, contributions))
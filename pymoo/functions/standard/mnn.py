@@ -6,18 +6,26 @@ import numpy as np
 from scipy.spatial.distance import pdist, squareform
 
 
-def calc_mnn(X, n_remove=0):
+def calc_mnn(X, n_remove=0, method="auto", workspace=None):
     """Calculate M-nearest neighbor distances."""
-    return calc_mnn_base(X, n_remove=n_remove, twonn=False)
+    return calc_mnn_base(X, n_remove=n_remove, twonn=False, method=method)
 
 
-def calc_2nn(X, n_remove=0):
+def calc_2nn(X, n_remove=0, method="auto", workspace=None):
     """Calculate 2-nearest neighbor distances."""
-    return calc_mnn_base(X, n_remove=n_remove, twonn=True)
+    return calc_mnn_base(X, n_remove=n_remove, twonn=True, method=method)
 
 
-def calc_mnn_base(X, n_remove=0, twonn=False):
-    """Base function for M-nearest neighbor calculations."""
+def calc_mnn_base(X, n_remove=0, twonn=False, method="auto"):
+    """Base function for M-nearest neighbor calculations.
+
+    `method` selects the neighbor search of the compiled version ("dense" matrix or "kdtree");
+    this implementation always uses the dense matrix and gives the same values. The `workspace` of
+    calc_mnn / calc_2nn is only used by the compiled version.
+    """
+    if method not in ("auto", "dense", "kdtree"):
+        raise ValueError("Unknown method '%s', use 'auto', 'dense' or 'kdtree'" % method)
+
     N = X.shape[0]
     M = X.shape[1]
     
@@ -141,10 +141,11 @@ def _fast_biobjective_nondominated_sort(F):
     
     return fronts
 
-def find_non_dominated(F, epsilon=0.0):
+def find_non_dominated(F, epsilon=0.0, n_threads=0):
     """
     Simple and efficient implementation to find only non-dominated points.
     Uses straightforward O(n²) algorithm with early termination.
+    `n_threads` is only used by the compiled version.
     """
     n_points = F.shape[0]
     non_dominated_indices = []
@@ -182,8 +183,12 @@ def find_non_dominated(F, epsilon=0.0):
     return np.array(non_dominated_indices, dtype=int)
 
 
-def efficient_non_dominated_sort(F, strategy="sequential"):
-    """Efficient Non-dominated Sorting (ENS)"""
+def efficient_non_dominated_sort(F, strategy="sequential", n_stop_if_ranked=None):
+    """Efficient Non-dominated Sorting (ENS)
+
+    With `n_stop_if_ranked`, only the fronts up to the one reaching that many individuals are
+    built; individuals dominated in all of them are not ranked.
+    """
     assert (strategy in ["sequential", 'binary']), "Invalid search strategy"
 
     # the shape of the input
@@ -196,12 +201,20 @@ def efficient_non_dominated_sort(F, strategy="sequential"):
     # front ranks for each individual
     fronts = []
 
+    # the number of leading fronts still needed and the individuals in them
+    n_stop = N if n_stop_if_ranked is None else n_stop_if_ranked
+    n_kept, n_ranked = max(N, 1), 0
+
     for i in range(N):
 
         if strategy == 'sequential':
-            k = sequential_search(F, i, fronts)
+            k = sequential_search(F, i, fronts[:n_kept])
         else:
-            k = binary_search(F, i, fronts)
+            k = binary_search(F, i, fronts[:n_kept])
+
+        # dominated in every front before the cut
+        if k >= n_kept:
+            continue
 
         # create empty fronts if necessary
         if k >= len(fronts):
@@ -209,10 +222,18 @@ def efficient_non_dominated_sort(F, strategy="sequential"):
 
         # append the current individual to a front
         fronts[k].append(i)
+        n_ranked += 1
+
+        # drop trailing fronts once the ones before them hold enough individuals
+        if n_ranked >= n_stop:
+            n_kept = min(n_kept, len(fronts))
+            while n_kept > 1 and n_ranked - len(fronts[n_kept - 1]) >= n_stop:
+                n_ranked -= len(fronts[n_kept - 1])
+                n_kept -= 1
 
     # now map the fronts back to the originally sorting
     ret = []
-    for front in fronts:
+    for front in fronts[:n_kept]:
         ret.append(I[front])
 
     return ret
@@ -448,10 +469,14 @@ def dda_ens(f_scores: np.ndarray, **kwargs) -> List[List[int]]:
 
 
 def dominance_degree_non_dominated_sort(
-    f_scores: np.ndarray, strategy: Literal["efficient", "fast"] = "efficient"
+    f_scores: np.ndarray, strategy: Literal["efficient", "fast", "bitset"] = "efficient", workspace=None
 ) -> List[List[int]]:
-    """Perform non-dominating sort with the specified algorithm."""
-    if strategy == "efficient":
+    """Perform non-dominating sort with the specified algorithm.
+
+    "bitset" is a packed-matrix variant that only exists compiled; here it yields the same
+    fronts through DDA-ENS.
+    """
+    if strategy in ("efficient", "bitset"):
         return dda_ens(f_scores)
     if strategy == "fast":
         return dda_ns(f_scores)
@@ -460,4 +485,107 @@ def dominance_degree_non_dominated_sort(
 
 def fast_best_order_sort(*args, **kwargs):
     """Placeholder for fast_best_order_sort - only available in Cython."""
-    raise NotImplementedError("fast_best_order_sort is only available in compiled (Cython) version")
\ No newline at end of file
+    raise NotImplementedError("fast_best_order_sort is only available in compiled (Cython) version")
+
+class ParetoArchive:
+    """
+    Incremental Pareto ranking: points are inserted and removed one at a time and every point
+    keeps the front index a full non-dominated sort would assign. Reference implementation of
+    the compiled version, which uses a balanced tree per front for two objectives.
+    """
+
+    def __init__(self, n_obj):
+        if n_obj <= 0:
+            raise ValueError("Pareto archive requires at least one objective")
+        self.n_obj = n_obj
+        self._F = {}
+        self._rank = {}
+        self._fronts = []
+        self._free = []
+        self._next_id = 0
+
+    def __len__(self):
+        return len(self._F)
+
+    def __contains__(self, i):
+        return i in self._F
+
+    @property
+    def n_fronts(self):
+        return len(self._fronts)
+
+    def rank(self, i):
+        if i not in self._rank:
+            raise IndexError("Point is not in the Pareto archive")
+        return self._rank[i]
+
+    def front(self, k):
+        if k >= len(self._fronts):
+            raise IndexError("Front index out of range")
+        return np.array(self._fronts[k], dtype=int)
+
+    def fronts(self):
+        return [self.front(k) for k in range(self.n_fronts)]
+
+    def _dominated_in(self, k, f):
+        return [j for j in self._fronts[k] if Dominator.get_relation(f, self._F[j]) == 1]
+
+    def _front_dominates(self, k, f):
+        return any(Dominator.get_relation(self._F[j], f) == 1 for j in self._fronts[k])
+
+    def insert(self, f):
+        f = np.asarray(f, dtype=float)
+        if f.shape != (self.n_obj,):
+            raise ValueError("Expected %d objective values" % self.n_obj)
+        if np.isnan(f).any():
+            raise ValueError("Pareto archive objectives must not be NaN")
+
+        if self._free:
+            i = self._free.pop()
+        else:
+            i = self._next_id
+            self._next_id += 1
+        self._F[i] = f
+
+        # binary search: a front that dominates f implies every earlier front does as well
+        lo, hi = 0, len(self._fronts)
+        while lo < hi:
+            mid = (lo + hi) // 2
+            if self._front_dominates(mid, f):
+                lo = mid + 1
+            else:
+                hi = mid
+
+        # members dominated by the arrivals drop one front, which may cascade
+        k, moved = lo, [i]
+        while moved:
+            if k == len(self._fronts):
+                self._fronts.append([])
+            dropped = {j for m in moved for j in self._dominated_in(k, self._F[m])}
+            self._fronts[k] = [j for j in self._fronts[k] if j not in dropped] + moved
+            for m in moved:
+                self._rank[m] = k
+            moved, k = sorted(dropped), k + 1
+
+        return i
+
+    def remove(self, i):
+        k = self.rank(i)
+        self._fronts[k].remove(i)
+        f_removed = self._F.pop(i)
+        del self._rank[i]
+        self._free.append(i)
+
+        # members only held back by departed points move up one front, which may cascade
+        moved = [f_removed]
+        while moved and k + 1 < len(self._fronts):
+            candidates = {j for f in moved for j in self._dominated_in(k + 1, f)}
+            up = [j for j in sorted(candidates) if not self._front_dominates(k, self._F[j])]
+            self._fronts[k + 1] = [j for j in self._fronts[k + 1] if j not in up]
+            self._fronts[k].extend(up)
+            for j in up:
+                self._rank[j] = k
+            moved, k = [self._F[j] for j in up], k + 1
+
+        while self._fronts and not self._fronts[-1]:
+            self._fronts.pop()
@@ -5,8 +5,8 @@ Standard Python implementation of pruning with crowding distance.
 import numpy as np
 
 
-def calc_pcd(X, n_remove=0):
-    """Calculate pruning based on crowding distance."""
+def calc_pcd(X, n_remove=0, workspace=None):
+    """Calculate pruning based on crowding distance. `workspace` is only used by the compiled version."""
     N = X.shape[0]
     M = X.shape[1]
 
@@ -12,12 +12,21 @@ def swap(M, a, b):
 
 
 @default_random_state
-def stochastic_ranking(f, phi, pr, I=None, random_state=None):
-    """Stochastic ranking algorithm."""
+def stochastic_ranking(f, phi, pr, I=None, random_state=None, n_threads=0):
+    """Stochastic ranking algorithm; for two-dimensional f and phi every row is ranked on its own."""
+    if np.ndim(f) == 2:
+        if I is None:
+            I = [None] * len(f)
+        return np.array([stochastic_ranking(_f, _phi, pr, _I, random_state=random_state)
+                         for _f, _phi, _I in zip(f, phi, I)], dtype=int).reshape(np.shape(f))
+
     _lambda = len(f)
 
+    # the swaps work on a copy, the ranking passed in by the caller stays as it is
     if I is None:
         I = np.arange(_lambda)
+    else:
+        I = np.array(I, copy=True)
 
     for i in range(_lambda):
 
@@ -0,0 +1,63 @@
+"""
+Standard Python implementation of the fused rank and crowding survival.
+"""
+
+import numpy as np
+
+from pymoo.functions.standard.non_dominated_sorting import fast_non_dominated_sort
+from pymoo.util.misc import find_duplicates
+
+
+def survive(F, n_survive, diversity="cd", tie_keys=None, n_threads=0, workspace=None, truncate=True):
+    """
+    NSGA-II survival: ranks F up to the split front, computes the diversity metric ('cd' or 'pcd') of every
+    surviving front and truncates the split front by it. Ties are broken by the smaller tie key (the index
+    without keys). Returns the survivors, their ranks and crowding. With truncate=False the split front is
+    returned whole, after the other fronts, for the caller to truncate. `n_threads` and `workspace` are only
+    used by the compiled version.
+    """
+    from pymoo.functions.standard.pruning_cd import calc_pcd
+    from pymoo.operators.survival.rank_and_crowding.metrics import calc_crowding_distance
+
+    if diversity not in ("cd", "pcd", "pruning-cd"):
+        raise ValueError("Unknown diversity metric: %s" % diversity)
+
+    F = np.asarray(F, dtype=float)
+    n = len(F)
+    n_survive = max(min(n_survive, n), 0)
+    tie_keys = np.arange(n) if tie_keys is None else np.asarray(tie_keys)
+    if len(tie_keys) != n:
+        raise ValueError("tie_keys requires one key per row of F")
+
+    survivors, rank, crowding = [], [], []
+    fronts = fast_non_dominated_sort(F) if n_survive > 0 else []
+
+    for k, front in enumerate(fronts):
+        if len(survivors) >= n_survive:
+            break
+
+        front = np.asarray(front, dtype=int)
+        n_remove = max(len(survivors) + len(front) - n_survive, 0)
+
+        if len(front) <= 2:
+            d = np.full(len(front), np.inf)
+        elif diversity == "cd":
+            d = calc_crowding_distance(F[front])
+        else:
+            # duplicates get a zero, the unique points are pruned one at a time
+            is_unique = np.where(np.logical_not(find_duplicates(F[front], epsilon=1e-32)))[0]
+            d = np.zeros(len(front))
+            d[is_unique] = calc_pcd(F[front][is_unique], n_remove=n_remove)
+
+        I = np.arange(len(front))
+        if n_remove > 0 and truncate:
+            # largest values first, NaN last, ties by the smaller key
+            is_nan = np.isnan(d)
+            I = np.lexsort((tie_keys[front], -np.where(is_nan, 0.0, d), is_nan))
+            I = I[:len(front) - n_remove]
+
+        survivors.extend(front[I])
+        rank.extend([k] * len(I))
+        crowding.extend(d[I])
+
+    return np.array(survivors, dtype=int), np.array(rank, dtype=int), np.array(crowding, dtype=float)
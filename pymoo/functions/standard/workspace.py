@@ -0,0 +1,15 @@
+"""
+Standard Python counterpart of the compiled kernel workspace.
+"""
+
+
+class Workspace:
+    """
+    Scratch memory kept across kernel calls. The Python kernels allocate with numpy on every call,
+    so there is nothing to keep and this only provides the interface of the compiled version.
+    """
+
+    nbytes = 0
+
+    def reset(self):
+        pass
@@ -5,7 +5,6 @@ from pymoo.functions import FunctionLoader, load_function
 from pymoo.indicators.distance_indicator import derive_ideal_and_nadir_from_pf
 from pymoo.util.misc import at_least_2d_array
 from pymoo.util.nds.non_dominated_sorting import NonDominatedSorting
-from moocore import hypervolume as _hypervolume
 
 
 class Hypervolume(Indicator):
@@ -35,8 +34,8 @@ class Hypervolume(Indicator):
         assert self.ref_point is not None, "For Hypervolume a reference point needs to be provided!"
 
     def _do(self, F):
-        # calculate the hypervolume using moocore
-        val = _hypervolume(F, ref = self.ref_point)
+        # calculate the hypervolume with the compiled engine (moocore if not compiled)
+        val = load_function("hv")(self.ref_point, F)
         return val
 
 
@@ -1,14 +1,14 @@
 import numpy as np
-from moocore import hypervolume as hv
-from moocore import hv_contributions as hvc
+
+from pymoo.functions import load_function
 
 
 def hv_exact(ref_point, F):
-    return hv(F, ref=ref_point)
+    return load_function("hv")(ref_point, F)
 
 
 def hvc_exact(ref_point, F):
-    return hvc(F, ref=ref_point)
+    return load_function("hvc")(ref_point, F)
 
 
 class DynamicHypervolume:
@@ -65,4 +65,29 @@ class DynamicHypervolume:
 class ExactHypervolume(DynamicHypervolume):
 
     def __init__(self, ref_point, func_hv=hv_exact, func_hvc=hvc_exact, **kwargs) -> None:
+        # with the default functions points are added and deleted incrementally: only the
+        # contributions a change affects are updated instead of recomputing the indicator
+        self.archive, self.ids = None, []
+        if func_hv is hv_exact and func_hvc is hvc_exact:
+            self.archive = load_function("HypervolumeArchive")(ref_point)
         super().__init__(ref_point, func_hv=func_hv, func_hvc=func_hvc, **kwargs)
+
+    def add(self, F):
+        if self.archive is None:
+            return super().add(F)
+        assert len(F.shape) == 2, "The points to add must be a two-dimensional array."
+        assert F.shape[1] == self.n_dim, "The dimensions of the ref_point and points to add must be equal"
+        self.F = np.vstack([self.F, F])
+        # one batch computation for the whole set; only deletions are incremental
+        self.ids.extend(self.archive.insert_many(F))
+        self.hv, self.hvc = self.archive.hv, self.archive.contributions(self.ids)
+        return self
+
+    def delete(self, k):
+        if self.archive is None:
+            return super().delete(k)
+        assert k < len(self.F)
+        self.F = np.delete(self.F, k, axis=0)
+        self.archive.remove(self.ids.pop(k))
+        self.hv, self.hvc = self.archive.hv, self.archive.contributions(self.ids)
+        return self
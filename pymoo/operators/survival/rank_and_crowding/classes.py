@@ -2,8 +2,10 @@ import numpy as np
 
 from pymoo.core.population import Population
 from pymoo.core.survival import Survival, split_by_feasibility
+from pymoo.functions import load_function
 from pymoo.operators.survival.rank_and_crowding.metrics import get_crowding_function
 from pymoo.util.nds.non_dominated_sorting import NonDominatedSorting
+from pymoo.util import default_random_state
 from pymoo.util.randomized_argsort import randomized_argsort
 
 
@@ -49,6 +51,11 @@ class RankAndCrowding(Survival):
         self.nds = nds if nds is not None else NonDominatedSorting()
         self.crowding_func = crowding_func_
 
+        # the default sorting with 'cd' or 'pcd' runs as one fused pass (see pymoo.functions "survive")
+        self.diversity = None
+        if nds is None and isinstance(crowding_func, str) and crowding_func in ("cd", "pcd", "pruning-cd"):
+            self.diversity = crowding_func
+
 
     def _do(self,
             problem,
@@ -56,16 +63,27 @@ class RankAndCrowding(Survival):
             *args,
             random_state=None,
             n_survive=None,
+            algorithm=None,
             **kwargs):
 
         # get the objective space values and objects
         F = pop.get("F").astype(float, copy=False)
 
+        # scratch memory of the compiled kernels, kept by the algorithm for the whole run
+        workspace = getattr(algorithm, "workspace", None)
+
+        if self.diversity is not None:
+            return self._do_fused(pop, F, n_survive, random_state=random_state, workspace=workspace)
+
+        # the workspace only goes to sorters and metrics known to accept it - user-defined ones may not
+        nds_kwargs = dict(workspace=workspace) if isinstance(self.nds, NonDominatedSorting) else {}
+        crowding_kwargs = dict(workspace=workspace) if getattr(self.crowding_func, "uses_workspace", False) else {}
+
         # the final indices of surviving individuals
         survivors = []
 
         # do the non-dominated sorting until splitting front
-        fronts = self.nds.do(F, n_stop_if_ranked=n_survive)
+        fronts = self.nds.do(F, n_stop_if_ranked=n_survive, **nds_kwargs)
 
         for k, front in enumerate(fronts):
             
@@ -81,7 +99,8 @@ class RankAndCrowding(Survival):
                 crowding_of_front = \
                     self.crowding_func.do(
                         F[front, :],
-                        n_remove=n_remove
+                        n_remove=n_remove,
+                        **crowding_kwargs
                     )
 
                 I = randomized_argsort(crowding_of_front, order='descending', method='numpy', random_state=random_state)
@@ -93,7 +112,8 @@ class RankAndCrowding(Survival):
                 crowding_of_front = \
                     self.crowding_func.do(
                         F[front, :],
-                        n_remove=0
+                        n_remove=0,
+                        **crowding_kwargs
                     )
 
             # save rank and crowding in the individual class
@@ -106,6 +126,27 @@ class RankAndCrowding(Survival):
 
         return pop[survivors]
 
+    @default_random_state
+    def _do_fused(self, pop, F, n_survive, random_state=None, workspace=None):
+
+        # ranking and crowding at once; the split front comes back whole and is truncated below exactly as
+        # in _do, so the random tie-break draws from random_state only when a front is split, like before
+        survivors, rank, crowding = load_function("survive")(F, n_survive, diversity=self.diversity,
+                                                             workspace=workspace, truncate=False)
+
+        # save rank and crowding in the individual class
+        for i, k, d in zip(survivors, rank, crowding):
+            pop[i].set("rank", k)
+            pop[i].set("crowding", d)
+
+        n_remove = len(survivors) - n_survive
+        if n_remove > 0:
+            split = np.flatnonzero(rank == rank[-1])
+            I = randomized_argsort(crowding[split], order='descending', method='numpy', random_state=random_state)
+            survivors = np.concatenate([survivors[:split[0]], survivors[split[I[:-n_remove]]]])
+
+        return pop[survivors]
+
 
 class ConstrRankAndCrowding(Survival):
 
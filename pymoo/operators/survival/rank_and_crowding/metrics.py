@@ -9,13 +9,13 @@ def get_crowding_function(label):
     if label == "cd":
         fun = FunctionalDiversity(calc_crowding_distance, filter_out_duplicates=False)
     elif (label == "pcd") or (label == "pruning-cd"):
-        fun = FunctionalDiversity(load_function("calc_pcd"), filter_out_duplicates=True)
+        fun = FunctionalDiversity(load_function("calc_pcd"), filter_out_duplicates=True, uses_workspace=True)
     elif label == "ce":
         fun = FunctionalDiversity(calc_crowding_entropy, filter_out_duplicates=True)
     elif label == "mnn":
-        fun = FuncionalDiversityMNN(load_function("calc_mnn"), filter_out_duplicates=True)
+        fun = FuncionalDiversityMNN(load_function("calc_mnn"), filter_out_duplicates=True, uses_workspace=True)
     elif label == "2nn":
-        fun = FuncionalDiversityMNN(load_function("calc_2nn"), filter_out_duplicates=True)
+        fun = FuncionalDiversityMNN(load_function("calc_2nn"), filter_out_duplicates=True, uses_workspace=True)
     elif hasattr(label, "__call__"):
         fun = FunctionalDiversity(label, filter_out_duplicates=True)
     elif isinstance(label, CrowdingDiversity):
@@ -27,10 +27,17 @@ def get_crowding_function(label):
 
 class CrowdingDiversity:
 
-    def do(self, F, n_remove=0):
+    # whether _do forwards a workspace to a compiled kernel
+    uses_workspace = False
+
+    def do(self, F, n_remove=0, workspace=None):
         # Converting types Python int to Cython int would fail in some cases converting to long instead
         n_remove = np.intc(n_remove)
         F = np.array(F, dtype=np.double)
+
+        # scratch buffers of the compiled metrics are reused from the workspace if one is given
+        if workspace is not None and self.uses_workspace:
+            return self._do(F, n_remove=n_remove, workspace=workspace)
         return self._do(F, n_remove=n_remove)
 
     def _do(self, F, n_remove=None):
@@ -39,9 +46,10 @@ class CrowdingDiversity:
 
 class FunctionalDiversity(CrowdingDiversity):
 
-    def __init__(self, function=None, filter_out_duplicates=True):
+    def __init__(self, function=None, filter_out_duplicates=True, uses_workspace=False):
         self.function = function
         self.filter_out_duplicates = filter_out_duplicates
+        self.uses_workspace = uses_workspace
         super().__init__()
 
     def _do(self, F, **kwargs):
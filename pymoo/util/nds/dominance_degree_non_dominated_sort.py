@@ -129,7 +129,7 @@ def dda_ens(f_scores: np.ndarray, **kwargs) -> List[List[int]]:
 
 
 def dominance_degree_non_dominated_sort(
-    f_scores: np.ndarray, strategy: Literal["efficient", "fast"] = "efficient"
+    f_scores: np.ndarray, strategy: Literal["efficient", "fast", "bitset"] = "efficient"
 ) -> List[List[int]]:
     """
     dominance_degree_non_dominated_sort performs the non-dominating sort with the specified algorithm
@@ -138,8 +138,9 @@ def dominance_degree_non_dominated_sort(
     ----------
     f_scores : np.ndarray
         The N x M matrix of N (population size) objective function values for M objectives
-    strategy : Literal["efficient", "fast"], optional
-        The dominance degree algorithm to use, by default "efficient"
+    strategy : Literal["efficient", "fast", "bitset"], optional
+        The dominance degree algorithm to use, by default "efficient". "bitset" packs the
+        comparison matrices into bits in the compiled module; in Python it falls back to DDA-ENS.
 
     Returns
     -------
@@ -152,7 +153,7 @@ def dominance_degree_non_dominated_sort(
     ValueError
         If an invalid strategy is specified
     """
-    if strategy == "efficient":
+    if strategy in ("efficient", "bitset"):
         return dda_ens(f_scores)
     if strategy == "fast":
         return dda_ns(f_scores)
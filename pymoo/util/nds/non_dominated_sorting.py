@@ -14,7 +14,8 @@ class NonDominatedSorting:
         self.method = method
         self.dominator = dominator
 
-    def do(self, F, return_rank=False, only_non_dominated_front=False, n_stop_if_ranked=None, n_fronts=None, **kwargs):
+    def do(self, F, return_rank=False, only_non_dominated_front=False, n_stop_if_ranked=None, n_fronts=None,
+           workspace=None, **kwargs):
         F = F.astype(float)
 
         # if not set just set it to a very large values because the cython algorithms do not take None
@@ -45,6 +46,15 @@ class NonDominatedSorting:
                 kwargs["n_fronts"] = n_fronts
                 kwargs["n_stop_if_ranked"] = n_stop_if_ranked
 
+            # these stop building fronts once n_stop_if_ranked solutions are ranked
+            elif self.method in ("efficient_non_dominated_sort", "fast_best_order_sort"):
+                kwargs["n_stop_if_ranked"] = n_stop_if_ranked
+
+            # these keep their buffers in the workspace between calls
+            if workspace is not None and self.method in ("fast_non_dominated_sort",
+                                                         "dominance_degree_non_dominated_sort"):
+                kwargs["workspace"] = workspace
+
             fronts = func(F, **kwargs)
 
         # convert to numpy array for each front and filter by n_stop_if_ranked
@@ -1,8 +1,97 @@
+import os
+import platform
+
 import numpy
 import setuptools
 import Cython.Build
+from setuptools.command.build_clib import build_clib
+from setuptools.command.build_ext import build_ext
+
+# The native core shared by all compiled modules and by Eddie/ (`make -C Eddie core` builds the same
+# sources). It is compiled once into static libraries that every extension links, instead of a copy
+# per module. The kernels of Eddie/simd_kernels.h exist once per instruction set, each level in a
+# library of its own since flags are per library, and the best one the CPU supports is picked at run
+# time, so a wheel built on any x86-64 machine runs at full speed on every other one.
+CORE_SOURCES = [
+    "Eddie/cpu_features.cpp",
+    "Eddie/simd_kernels.cpp",
+    "Eddie/simd_scalar.cpp",
+    "Eddie/normalization.cpp",
+]
+
+SIMD_LEVELS = ["sse4", "avx2", "avx512"]
+
+# Flags of the core, the extensions and each SIMD level, per compiler type. No FMA contraction keeps
+# the levels bit-identical (see Eddie/simd_kernels.h).
+FLAGS = {
+    "unix": {
+        "core": ["-std=c++17", "-O3", "-ffp-contract=off"],
+        "ext": ["-std=c++17", "-O3"],
+        "sse4": ["-msse4.2"],
+        "avx2": ["-mavx2"],
+        "avx512": ["-mavx512f", "-mprefer-vector-width=512"],
+    },
+    "msvc": {
+        "core": ["/std:c++17", "/O2", "/fp:precise"],
+        "ext": ["/std:c++17", "/O2"],
+        "sse4": [],
+        "avx2": ["/arch:AVX2"],
+        "avx512": ["/arch:AVX512"],
+    },
+}
+
+# PYMOO_NATIVE=1 additionally tunes everything for the build host, for local builds only
+NATIVE = os.environ.get("PYMOO_NATIVE", "0") == "1"
+
+IS_X86 = platform.machine().lower() in ("x86_64", "amd64", "i386", "i686", "x86")
+
+
+def compiler_flags(compiler_type, kind):
+    flags = FLAGS.get(compiler_type, FLAGS["unix"])
+    args = list(flags[kind])
+    if kind in SIMD_LEVELS:
+        args = list(flags["core"]) + (args if IS_X86 else [])
+    if NATIVE and compiler_type != "msvc":
+        args.append("-march=native")
+    return args
+
+
+class BuildCore(build_clib):
+
+    def build_libraries(self, libraries):
+        for _, build_info in libraries:
+            build_info["cflags"] = compiler_flags(self.compiler.compiler_type, build_info["flags"])
+        super().build_libraries(libraries)
+
+
+class BuildExtensions(build_ext):
+
+    def finalize_options(self):
+        super().finalize_options()
+        # compile the extensions on all cores unless --parallel says otherwise
+        if self.parallel is None:
+            self.parallel = os.cpu_count()
+
+    def run(self):
+        # `build_ext --inplace` alone does not build the core libraries first
+        if self.distribution.has_c_libraries():
+            self.run_command("build_clib")
+        super().run()
+
+    def build_extensions(self):
+        for ext in self.extensions:
+            ext.extra_compile_args = compiler_flags(self.compiler.compiler_type, "ext")
+        super().build_extensions()
+
+
+# the dispatching core first, the levels it refers to after it (static libraries link in order)
+libraries = [("eddie_core", {"sources": CORE_SOURCES, "flags": "core"})]
+for level in SIMD_LEVELS:
+    libraries.append(("eddie_core_%s" % level, {"sources": ["Eddie/simd_%s.cpp" % level], "flags": level}))
 
 setuptools.setup(
-    ext_modules=Cython.Build.cythonize("pymoo/functions/compiled/*.pyx"),
-    include_dirs=[numpy.get_include()],
+    ext_modules=Cython.Build.cythonize("pymoo/functions/compiled/*.pyx", nthreads=os.cpu_count() or 1),
+    libraries=libraries,
+    include_dirs=[numpy.get_include(), "Eddie"],
+    cmdclass={"build_clib": BuildCore, "build_ext": BuildExtensions},
 )
@@ -1,7 +1,8 @@
 import numpy as np
 import pytest
 
-from pymoo.indicators.hv.exact import ExactHypervolume
+from pymoo.functions import load_function
+from pymoo.indicators.hv.exact import ExactHypervolume, hv_exact, hvc_exact
 from pymoo.indicators.hv.exact_2d import ExactHypervolume2D
 from pymoo.indicators.hv.approximate import ApproximateHypervolume
 from pymoo.problems.many import DTLZ1
@@ -79,3 +80,96 @@ def test_hvc_monte_carlo(case):
 
         assert np.allclose(exact.hv, mc.hv, rtol=0, atol=1.5e-2)
         np.testing.assert_allclose(exact.hvc, mc.hvc, rtol=0, atol=1.5e-1)
+
+
+@pytest.mark.parametrize('n_obj', [2, 3, 4, 5, 6])
+def test_hv_compiled_matches_moocore(n_obj):
+    np.random.seed(1)
+    F = np.random.random((40, n_obj))
+    F[5] = F[4]
+    ref_point = np.full(n_obj, 0.9)
+
+    hv, hvc = load_function("hv", _type="python"), load_function("hvc", _type="python")
+    _hv, _hvc = load_function("hv", _type="cython"), load_function("hvc", _type="cython")
+
+    np.testing.assert_allclose(_hv(ref_point, F), hv(ref_point, F))
+    np.testing.assert_allclose(_hvc(ref_point, F, n_threads=2), hvc(ref_point, F), atol=1e-12)
+
+
+@pytest.mark.parametrize('n_obj', [2, 3, 4])
+def test_hv_archive_incremental(n_obj):
+    np.random.seed(1)
+    F = np.random.random((30, n_obj))
+    ref_point = np.full(n_obj, 1.1)
+    hv, hvc = load_function("hv", _type="python"), load_function("hvc", _type="python")
+
+    archive = load_function("HypervolumeArchive", _type="cython")(ref_point)
+    ids = [archive.insert(f) for f in F]
+    rows = list(range(len(F)))
+
+    while len(rows) > 1:
+        np.testing.assert_allclose(archive.hv, hv(ref_point, F[rows]))
+        np.testing.assert_allclose(archive.contributions(ids), hvc(ref_point, F[rows]), atol=1e-12)
+
+        k = np.random.randint(len(rows))
+        archive.remove(ids.pop(k))
+        rows.pop(k)
+
+
+@pytest.mark.parametrize('n_obj', [2, 3, 4])
+def test_hv_archive_does_not_drift(n_obj):
+    # large boxes come and go around a few small ones near the reference point: the updates move far more
+    # volume than is left, so their rounding has to be discarded by the archive's refreshes
+    rng = np.random.default_rng(1)
+    ref_point = np.ones(n_obj)
+    hv = load_function("hv", _type="python")
+    archive = load_function("HypervolumeArchive", _type="cython")(ref_point)
+
+    small, ids = [], []
+    for cycle in range(300):
+        big = [archive.insert(0.5 * rng.random(n_obj)) for _ in range(8)]
+        if len(small) < 20:
+            f = 1.0 - 1e-3 * (0.5 + rng.random(n_obj))
+            small.append(f)
+            ids.append(archive.insert(f))
+        for i in big:
+            archive.remove(i)
+
+        if cycle % 20 == 19:
+            np.testing.assert_allclose(archive.hv, hv(ref_point, np.array(small)), rtol=1e-12)
+
+    archive.refresh()
+    np.testing.assert_allclose(archive.hv, hv(ref_point, np.array(small)), rtol=1e-12)
+    assert len(archive) == len(ids)
+
+
+@pytest.mark.parametrize('n_obj', [3, 4])
+def test_exact_hypervolume_add_matches_batch(n_obj):
+    # SMS-EMOA adds the whole front at once and then deletes the least contributing points
+    np.random.seed(1)
+    F = np.random.random((60, n_obj))
+    F[5] = F[4]
+    ref_point = np.full(n_obj, 1.1)
+
+    hv = ExactHypervolume(ref_point).add(F)
+    np.testing.assert_allclose(hv.hv, hv_exact(ref_point, F))
+    np.testing.assert_allclose(hv.hvc, hvc_exact(ref_point, F), atol=1e-12)
+
+    for _ in range(20):
+        k = hv.hvc.argmin()
+        hv.delete(k)
+        F = np.delete(F, k, axis=0)
+        np.testing.assert_allclose(hv.hv, hv_exact(ref_point, F))
+        np.testing.assert_allclose(hv.hvc, hvc_exact(ref_point, F), atol=1e-12)
+
+
+def test_hv_approx_many_objectives():
+    np.random.seed(1)
+    F = np.random.random((20, 9))
+    ref_point = np.full(9, 1.2)
+
+    exact = load_function("hv", _type="python")(ref_point, F)
+    value, error = load_function("hv_approx", _type="cython")(ref_point, F, n_samples=200_000, seed=1)
+
+    assert error > 0
+    assert abs(value - exact) < 5 * error
@@ -32,3 +32,32 @@ def test_crowding_distance_norm_equals_zero():
     cd = crowding_func.do(F)
     np.testing.assert_almost_equal(cd, np.array([np.inf, 0.75, np.inf]))
 
+
+
+@pytest.mark.parametrize("name", ["calc_pcd", "calc_mnn", "calc_2nn"])
+def test_crowding_metric_with_workspace(name):
+    from pymoo.functions import load_function
+
+    workspace = load_function("Workspace", _type="cython")()
+    func = load_function(name, _type="cython")
+
+    for gen in range(3):
+        X = np.random.default_rng(gen).random((100, 3))
+        for n_remove in [0, 30]:
+            np.testing.assert_allclose(func(X, n_remove=n_remove, workspace=workspace), func(X, n_remove=n_remove))
+        workspace.reset()
+
+
+@pytest.mark.parametrize("name", ["calc_mnn", "calc_2nn"])
+def test_gpu_crowding_metric_matches_cpu(monkeypatch, name):
+    # on the device from the first point on and in chunks of 300 rows; without a device the CPU fallback runs
+    from pymoo.config import Config
+    from pymoo.functions import load_function
+    monkeypatch.setitem(Config.gpu, "enabled", True)
+    monkeypatch.setitem(Config.gpu, "min_points", 0)
+    monkeypatch.setitem(Config.gpu, "chunk_rows", 300)
+
+    X = np.random.default_rng(1).random((1000, 3))
+    for n_remove in [0, 1, 400]:
+        expected = load_function(name, _type="cython")(X.copy(), n_remove=n_remove)
+        np.testing.assert_allclose(load_function(name, _type="gpu")(X.copy(), n_remove=n_remove), expected)
@@ -1,3 +1,5 @@
+import importlib
+
 import numpy as np
 import pytest
 
@@ -24,7 +26,192 @@ def test_fast_non_dominated_sorting():
     assert_fronts_equal(fronts, _fronts)
 
 
-def test_efficient_non_dominated_sort():
+def test_fast_non_dominated_sorting_with_duplicates():
+    F = np.random.randint(0, 5, size=(500, 3)).astype(float)
+    fronts = load_function("fast_non_dominated_sort", _type="python")(F)
+    _fronts = load_function("fast_non_dominated_sort", _type="cython")(F)
+    assert_fronts_equal(fronts, _fronts)
+
+    # stopping early must return the leading fronts unchanged
+    _fronts = load_function("fast_non_dominated_sort", _type="cython")(F, n_stop_if_ranked=100)
+    assert sum(len(front) for front in _fronts[:-1]) < 100 <= sum(len(front) for front in _fronts)
+    assert_fronts_equal(fronts[:len(_fronts)], _fronts)
+
+
+@pytest.mark.parametrize("name,_type,kwargs", [
+    ("fast_non_dominated_sort", "cython", {}),
+    ("efficient_non_dominated_sort", "python", {}),
+    ("efficient_non_dominated_sort", "cython", {}),
+    ("efficient_non_dominated_sort", "cython", {"strategy": "binary"}),
+    ("fast_best_order_sort", "cython", {}),
+])
+def test_sorting_stops_at_survival_cut(name, _type, kwargs):
+    # four objectives, since two and three are routed to the sweep (see test_sweep_sorting)
+    F = np.random.randint(0, 10, size=(400, 4)).astype(float)
+    fronts = load_function("efficient_non_dominated_sort", _type="python")(F)
+
+    for n_stop in [1, 100, 200, 399, 400]:
+        _fronts = load_function(name, _type=_type)(F, n_stop_if_ranked=n_stop, **kwargs)
+        assert sum(len(front) for front in _fronts[:-1]) < n_stop <= sum(len(front) for front in _fronts)
+        assert_fronts_equal(fronts[:len(_fronts)], _fronts)
+
+
+@pytest.mark.parametrize("n_obj", [2, 3, 4, 5])
+@pytest.mark.parametrize("name,kwargs", [
+    ("fast_non_dominated_sort", {}),
+    ("efficient_non_dominated_sort", {}),
+    ("efficient_non_dominated_sort", {"strategy": "binary"}),
+    ("best_order_sort", {}),
+    ("fast_best_order_sort", {}),
+    ("dominance_degree_non_dominated_sort", {"strategy": "fast"}),
+    ("dominance_degree_non_dominated_sort", {"strategy": "bitset"}),
+])
+def test_fixed_objective_count_kernels(name, kwargs, n_obj):
+    # two and three objectives take the sweep sort, the others the kernels compiled for their count
+    F = np.random.default_rng(n_obj).integers(0, 8, size=(300, n_obj)).astype(float)
+    fronts = load_function("fast_non_dominated_sort", _type="python")(F)
+
+    # best_order_sort is not registered with the function loader
+    func = getattr(importlib.import_module("pymoo.functions.compiled.non_dominated_sorting"), name)
+    assert_fronts_equal(fronts, func(F, **kwargs))
+
+    nd = load_function("find_non_dominated", _type="cython")(F)
+    assert sorted(nd) == sorted(fronts[0])
+
+
+def test_threaded_sorting_matches_serial():
+    # large enough for the native kernels to split the comparisons over several threads; four objectives
+    # so that the pairwise kernels run instead of the sweep
+    F = np.random.randint(0, 50, size=(5000, 4)).astype(float)
+
+    fast_nds = load_function("fast_non_dominated_sort", _type="cython")
+    serial = fast_nds(F, n_threads=1)
+    assert serial == fast_nds(F, n_threads=4)
+    assert serial == fast_nds(F)
+
+    find_nd = load_function("find_non_dominated", _type="cython")
+    assert list(find_nd(F, n_threads=1)) == list(find_nd(F, n_threads=4)) == sorted(serial[0])
+
+
+@pytest.mark.parametrize("n_obj", [2, 3])
+def test_sweep_sorting(n_obj):
+    # integer objectives give duplicates and ties on single objectives, the cases the staircases must get right
+    F = np.random.default_rng(n_obj).integers(0, 30, size=(2000, n_obj)).astype(float)
+    fronts = load_function("fast_non_dominated_sort", _type="python")(F)
+
+    fast_nds = load_function("fast_non_dominated_sort", _type="cython")
+    assert_fronts_equal(fronts, fast_nds(F))
+    assert fast_nds(F, n_threads=1) == fast_nds(F, n_threads=4)
+
+    for n_stop in [1, 500, 1000, 1999, 2000]:
+        _fronts = fast_nds(F, n_stop_if_ranked=n_stop)
+        assert sum(len(front) for front in _fronts[:-1]) < n_stop <= sum(len(front) for front in _fronts)
+        assert_fronts_equal(fronts[:len(_fronts)], _fronts)
+
+    assert_fronts_equal(fronts[:3], fast_nds(F, n_fronts=3))
+
+    find_nd = load_function("find_non_dominated", _type="cython")
+    assert sorted(find_nd(F)) == sorted(fronts[0])
+
+    workspace = load_function("Workspace", _type="cython")()
+    for seed, n in [(1, 300), (2, 120), (3, 300)]:
+        G = np.random.default_rng(seed).integers(0, 20, size=(n, n_obj)).astype(float)
+        assert_fronts_equal(load_function("fast_non_dominated_sort", _type="python")(G),
+                            fast_nds(G, workspace=workspace))
+        workspace.reset()
+
+
+@pytest.mark.parametrize("n_obj", [3, 5])
+@pytest.mark.parametrize("epsilon", [0.0, 0.5])
+def test_gpu_sorting_matches_cpu(monkeypatch, n_obj, epsilon):
+    # on the device from the first point on and in chunks of 700 rows; without a device the CPU fallback runs
+    from pymoo.config import Config
+    monkeypatch.setitem(Config.gpu, "enabled", True)
+    monkeypatch.setitem(Config.gpu, "min_points", 0)
+    monkeypatch.setitem(Config.gpu, "chunk_rows", 700)
+
+    F = np.random.default_rng(n_obj).integers(0, 20, size=(2000, n_obj)).astype(float)
+
+    fronts = load_function("fast_non_dominated_sort", _type="cython")(F, epsilon=epsilon)
+    _fronts = load_function("fast_non_dominated_sort", _type="gpu")(F, epsilon=epsilon)
+    assert_fronts_equal(fronts, _fronts)
+
+    _cut = load_function("fast_non_dominated_sort", _type="gpu")(F, epsilon=epsilon, n_stop_if_ranked=500)
+    assert_fronts_equal(load_function("fast_non_dominated_sort", _type="cython")(F, epsilon=epsilon,
+                                                                                 n_stop_if_ranked=500), _cut)
+
+    nd = load_function("find_non_dominated", _type="gpu")(F, epsilon=epsilon)
+    assert sorted(nd) == sorted(load_function("find_non_dominated", _type="cython")(F, epsilon=epsilon))
+
+
+def test_gpu_backend_is_opt_in_and_probes_lazily(monkeypatch):
+    import pymoo.functions.gpu as gpu
+    from pymoo.config import Config
+
+    def probe():
+        raise AssertionError("the device was probed")
+
+    monkeypatch.setattr(gpu, "is_available", probe)
+    F = np.random.default_rng(1).integers(0, 20, size=(200, 5)).astype(float)
+    fronts = load_function("fast_non_dominated_sort", _type="cython")(F)
+
+    # disabled by default: the loader keeps the CPU implementation
+    assert not Config.gpu["enabled"]
+    assert load_function("fast_non_dominated_sort") is not load_function("fast_non_dominated_sort", _type="gpu")
+
+    # enabled, but inputs below min_points never look for a device
+    monkeypatch.setitem(Config.gpu, "enabled", True)
+    monkeypatch.setitem(Config.gpu, "min_points", 1000)
+    assert_fronts_equal(fronts, load_function("fast_non_dominated_sort", _type="gpu")(F))
+    assert not gpu.use_device(len(F))
+
+
+@pytest.mark.parametrize("_type", ["python", "cython"])
+@pytest.mark.parametrize("n_obj", [2, 3])
+def test_pareto_archive_matches_full_sort(_type, n_obj):
+    np.random.seed(1)
+    archive = load_function("ParetoArchive", _type=_type)(n_obj)
+    nds = load_function("efficient_non_dominated_sort", _type="python")
+
+    # integer objectives produce duplicates and ties, which the ENS reference handles exactly
+    ids, F = [], []
+    for step in range(300):
+        if len(ids) > 20 and step % 3 == 0:
+            k = np.random.randint(len(ids))
+            archive.remove(ids.pop(k))
+            F.pop(k)
+        else:
+            f = np.random.randint(0, 6, size=n_obj).astype(float)
+            ids.append(archive.insert(f))
+            F.append(f)
+
+        if step % 10 == 0:
+            fronts = [[ids[i] for i in front] for front in nds(np.array(F))]
+            assert_fronts_equal(fronts, archive.fronts())
+            assert all(archive.rank(i) == k for k, front in enumerate(fronts) for i in front)
+
+    assert len(archive) == len(ids)
+
+
+@pytest.mark.parametrize("_type", ["python", "cython"])
+@pytest.mark.parametrize("n_obj", [2, 3])
+def test_pareto_archive_rejects_nan(_type, n_obj):
+    archive = load_function("ParetoArchive", _type=_type)(n_obj)
+    ids = [archive.insert(f) for f in np.random.default_rng(1).random((20, n_obj))]
+
+    f = np.zeros(n_obj)
+    f[-1] = np.nan
+    with pytest.raises(ValueError):
+        archive.insert(f)
+
+    # the archive is unchanged and infinities, as failed evaluations report them, are accepted
+    assert len(archive) == len(ids)
+    i = archive.insert(np.full(n_obj, np.inf))
+    assert archive.rank(i) == max(archive.rank(j) for j in ids) + 1
+    for j in ids + [i]:
+        archive.remove(j)
+    assert len(archive) == 0
+
     print("Testing ENS...")
     F = np.ones((1000, 3))
     F[:, 1:] = np.random.random((1000, 2))
@@ -37,6 +224,16 @@ def test_efficient_non_dominated_sort():
     assert_fronts_equal(nds, python_fronts_seq)
     assert_fronts_equal(nds, cython_fronts_seq)
 
+    python_fronts_bitset = load_function(
+        "dominance_degree_non_dominated_sort", _type="python"
+    )(F, strategy="bitset")
+    cython_fronts_bitset = load_function(
+        "dominance_degree_non_dominated_sort", _type="cython"
+    )(F, strategy="bitset")
+
+    assert_fronts_equal(nds, python_fronts_bitset)
+    assert_fronts_equal(nds, cython_fronts_bitset)
+
     python_fronts_binary = load_function(
         "efficient_non_dominated_sort", _type="python"
     )(F, strategy="binary")
@@ -162,3 +359,21 @@ def test_equal_during_run(n_obj):
         termination=("n_gen", 200),
         verbose=True,
     )
+
+
+@pytest.mark.parametrize("method", ["fast_non_dominated_sort", "dominance_degree_non_dominated_sort"])
+@pytest.mark.parametrize("n_obj", [2, 3, 4])
+def test_non_dominated_sorting_with_workspace(method, n_obj):
+    workspace = load_function("Workspace", _type="cython")()
+    func = load_function(method, _type="cython")
+    kwargs = {"strategy": "bitset"} if method == "dominance_degree_non_dominated_sort" else {}
+
+    # the buffers of the workspace are reused by populations of changing size
+    for seed, n in [(1, 300), (2, 120), (3, 300)]:
+        F = np.random.default_rng(seed).integers(0, 20, size=(n, n_obj)).astype(float)
+        fronts = func(F, workspace=workspace, **kwargs)
+
+        # a workspace changes neither the result type nor, for two and three objectives, the sweep
+        assert type(fronts) is list and all(type(front) is list for front in fronts)
+        assert_fronts_equal(fronts, func(F, **kwargs))
+        workspace.reset()
@@ -0,0 +1,49 @@
+import numpy as np
+import pytest
+
+from pymoo.functions import load_function
+
+
+@pytest.mark.parametrize("_type", ["python", "cython"])
+def test_stochastic_ranking_limits(_type):
+    np.random.seed(1)
+    f = np.random.random(200)
+    stochastic_ranking = load_function("stochastic_ranking", _type=_type)
+
+    # all feasible: a plain sort by objective
+    I = stochastic_ranking(f, np.zeros(200), 0.45, seed=1)
+    np.testing.assert_equal(I, np.argsort(f, kind="stable"))
+
+    # never comparing infeasible pairs by objective: a sort by constraint violation
+    phi = np.random.random(200) + 0.1
+    I = stochastic_ranking(f, phi, 0.0, seed=1)
+    np.testing.assert_equal(I, np.argsort(phi, kind="stable"))
+
+
+@pytest.mark.parametrize("_type", ["python", "cython"])
+def test_stochastic_ranking_keeps_the_given_ranking(_type):
+    np.random.seed(1)
+    f, phi = np.random.random(100), np.random.random(100)
+    stochastic_ranking = load_function("stochastic_ranking", _type=_type)
+
+    I = np.random.permutation(100)
+    _I = I.copy()
+    ranking = stochastic_ranking(f, phi, 0.45, I=I, seed=1)
+
+    np.testing.assert_equal(I, _I)
+    np.testing.assert_equal(np.sort(ranking), np.arange(100))
+
+
+def test_stochastic_ranking_compiled_is_reproducible():
+    np.random.seed(1)
+    f = np.random.random((4, 500))
+    phi = np.where(np.random.random((4, 500)) < 0.3, 0.0, np.random.random((4, 500)))
+    stochastic_ranking = load_function("stochastic_ranking", _type="cython")
+
+    I = stochastic_ranking(f, phi, 0.45, seed=7, n_threads=2)
+    assert I.shape == (4, 500)
+    for row in I:
+        np.testing.assert_equal(np.sort(row), np.arange(500))
+
+    np.testing.assert_equal(stochastic_ranking(f, phi, 0.45, seed=7, n_threads=1), I)
+    np.testing.assert_equal(stochastic_ranking(f[0], phi[0], 0.45, seed=7), I[0])
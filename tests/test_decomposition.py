@@ -1,8 +1,18 @@
+import os
+import subprocess
+import sys
+
 import numpy as np
+import pytest
 from pymoo.util.remote import Remote
 
+from pymoo.decomposition.aasf import AASF
+from pymoo.decomposition.asf import ASF
+from pymoo.decomposition.pbi import PBI
 from pymoo.decomposition.perp_dist import PerpendicularDistance
+from pymoo.decomposition.tchebicheff import Tchebicheff
 from pymoo.decomposition.weighted_sum import WeightedSum
+from pymoo.functions import load_function
 
 
 def test_one_to_one():
@@ -53,3 +63,159 @@ def test_perp_dist():
 
     D = PerpendicularDistance(_type="cython").do(F, weights, _type="many_to_many")
     np.testing.assert_allclose(D, correct)
+
+
+def test_calc_perpendicular_distance_compiled():
+    np.random.seed(1)
+    N = np.random.random((300, 15))
+    ref_dirs = np.random.random((130, 15))
+    N[:10] = 2.0 * ref_dirs[:10]
+
+    correct = load_function("calc_perpendicular_distance", _type="python")(N, ref_dirs)
+
+    out = np.empty((300, 130))
+    D = load_function("calc_perpendicular_distance", _type="cython")(N, ref_dirs, out=out, n_threads=2)
+    assert D is out
+    np.testing.assert_allclose(D, correct, atol=1e-12)
+    np.testing.assert_allclose(D[10:], correct[10:], rtol=1e-14)
+    np.testing.assert_allclose(np.diag(D[:10, :10]), 0.0, atol=1e-12)
+
+
+def test_calc_perpendicular_distance_near_ties():
+    # every point lies between its own two lines, 2e-3 rad apart, and 1e-13 closer to one of them
+    rng = np.random.default_rng(1)
+    n, m = 300, 5
+
+    a = rng.random((n, m)) + 0.1
+    a /= np.linalg.norm(a, axis=1)[:, None]
+    w = rng.normal(size=(n, m))
+    w -= np.sum(w * a, axis=1)[:, None] * a
+    w /= np.linalg.norm(w, axis=1)[:, None]
+
+    theta = 2e-3
+    ref_dirs = np.empty((2 * n, m))
+    ref_dirs[0::2] = (np.cos(theta) * a + np.sin(theta) * w) * (1.0 + rng.random((n, 1)))
+    ref_dirs[1::2] = (np.cos(theta) * a - np.sin(theta) * w) * (1.0 + rng.random((n, 1)))
+
+    eps = rng.choice([-1.0, 1.0], n) * 1e-13 * (0.5 + 0.5 * rng.random(n))
+    N = (a + eps[:, None] * w) * (1.0 + rng.random((n, 1)))
+    closest = np.where(eps > 0, 0, 1)
+
+    rows = np.arange(n)
+    for _type in ["python", "cython"]:
+        D = load_function("calc_perpendicular_distance", _type=_type)(N, ref_dirs)
+        pair = np.column_stack([D[rows, 2 * rows], D[rows, 2 * rows + 1]])
+        np.testing.assert_array_equal(pair.argmin(axis=1), closest)
+
+
+SIMD_KERNELS_SCRIPT = """
+import hashlib
+import numpy as np
+from pymoo.functions import load_function
+from pymoo.functions.compiled.info import simd_level
+
+np.random.seed(1)
+N, ref_dirs = np.random.random((300, 15)), np.random.random((130, 15))
+values = [load_function("calc_perpendicular_distance", _type="cython")(N, ref_dirs)]
+for kind in ["pbi", "tchebycheff", "asf"]:
+    values.append(load_function("decompose", _type="cython")(N, ref_dirs, kind))
+print(simd_level())
+print(hashlib.sha1(b"".join(v.tobytes() for v in values)).hexdigest())
+"""
+
+
+def test_compiled_kernels_identical_across_simd_levels():
+    # every level the CPU supports, forced through EDDIE_SIMD in a fresh interpreter
+    from pymoo.functions.compiled.info import simd_level
+    levels = ["scalar", "sse4", "avx2", "avx512"]
+    levels = levels[:levels.index(simd_level()) + 1]
+
+    digests = set()
+    for level in levels:
+        out = subprocess.run([sys.executable, "-c", SIMD_KERNELS_SCRIPT], env=dict(os.environ, EDDIE_SIMD=level),
+                             capture_output=True, text=True, check=True).stdout.split()
+        assert out[0] == level
+        digests.add(out[1])
+
+    assert len(digests) == 1
+
+
+def test_calc_perpendicular_distance_gpu(monkeypatch):
+    # on the device in chunks of 70 points; without a device the CPU fallback runs
+    from pymoo.config import Config
+    monkeypatch.setitem(Config.gpu, "enabled", True)
+    monkeypatch.setitem(Config.gpu, "min_points", 0)
+    monkeypatch.setitem(Config.gpu, "chunk_rows", 70)
+
+    np.random.seed(1)
+    N = np.random.random((300, 15))
+    ref_dirs = np.random.random((130, 15))
+    N[:10] = 2.0 * ref_dirs[:10]
+
+    correct = load_function("calc_perpendicular_distance", _type="python")(N, ref_dirs)
+
+    out = np.empty((300, 130))
+    D = load_function("calc_perpendicular_distance", _type="gpu")(N, ref_dirs, out=out)
+    assert D is out
+    np.testing.assert_allclose(D, correct, atol=1e-12)
+    np.testing.assert_allclose(D[10:], correct[10:], rtol=1e-14)
+
+
+@pytest.mark.parametrize("decomposition", [PBI(theta=3.0), Tchebicheff(), ASF(), AASF(eps=1e-4, rho=0.01)])
+def test_decompose_matches_pairwise(decomposition):
+    np.random.seed(1)
+    F = np.random.random((100, 3))
+    weights = np.random.random((70, 3))
+    weights[0, 1] = 0.0
+    ideal_point = F.min(axis=0)
+
+    D = decomposition.do(F, weights, ideal_point=ideal_point, _type="many_to_many")
+
+    # the repeated pairs the cross product replaces
+    correct = decomposition._do(np.repeat(F, len(weights), axis=0), weights=np.tile(weights, (len(F), 1)))
+    np.testing.assert_allclose(D, correct.reshape(len(F), len(weights)))
+
+    D = decomposition.do(F[:70], weights, ideal_point=ideal_point, _type="one_to_one")
+    np.testing.assert_allclose(D, decomposition._do(F[:70], weights=weights).flatten())
+
+
+@pytest.mark.parametrize("kind", ["pbi", "tchebycheff", "asf"])
+def test_decompose_compiled_matches_python(kind):
+    np.random.seed(1)
+    F = np.random.random((200, 4))
+    weights = np.random.random((130, 4))
+    utopian_point = F.min(axis=0) - 1e-6
+
+    for cross in [True, False]:
+        W = weights if cross else np.random.random((200, 4))
+        correct = load_function("decompose", _type="python")(F, W, kind, utopian_point=utopian_point, cross=cross)
+        D = load_function("decompose", _type="cython")(F, W, kind, utopian_point=utopian_point, cross=cross,
+                                                       n_threads=2)
+        np.testing.assert_allclose(D, correct)
+
+
+@pytest.mark.parametrize("kind", ["pbi", "tchebycheff", "asf"])
+def test_decompose_propagates_nan(kind):
+    np.random.seed(1)
+    F = np.random.random((100, 4))
+    weights = np.random.random((70, 4))
+    # in the first, a middle and the last objective, so no position of the maximum skips it
+    F[3, 0] = F[7, 2] = F[11, 3] = np.nan
+
+    for cross in [True, False]:
+        W = weights if cross else np.random.random((100, 4))
+        correct = load_function("decompose", _type="python")(F, W, kind, cross=cross)
+        D = load_function("decompose", _type="cython")(F, W, kind, cross=cross)
+        assert np.isnan(D[[3, 7, 11]]).all() and not np.isnan(np.delete(D, [3, 7, 11], axis=0)).any()
+        np.testing.assert_allclose(D, correct)
+
+
+def test_decompose_with_workspace():
+    np.random.seed(1)
+    workspace = load_function("Workspace", _type="cython")()
+    decompose = load_function("decompose", _type="cython")
+
+    # the kernel of the workspace is reassigned for every weight set and scalarization
+    for kind, n_weights in [("pbi", 91), ("asf", 10), ("tchebycheff", 130)]:
+        F, weights = np.random.random((50, 3)), np.random.random((n_weights, 3))
+        np.testing.assert_allclose(decompose(F, weights, kind, workspace=workspace), decompose(F, weights, kind))